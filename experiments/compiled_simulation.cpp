@@ -0,0 +1,102 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <tuple>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/compiled_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* Simulation of all nodes with 4096 random patterns: `simulate_nodes` with a
+ * `partial_simulator` against a `compiled_simulator`, timing the compilation
+ * and the evaluation separately.  `equivalent` compares the values of all
+ * nodes. */
+template<class Ntk>
+std::tuple<double, double, double> compare_simulation( Ntk const& ntk, mockturtle::partial_simulator const& sim, bool& equivalent )
+{
+  using namespace mockturtle;
+
+  stopwatch<>::duration t_nodes{ 0 }, t_compile{ 0 }, t_run{ 0 };
+  auto const values = call_with_stopwatch( t_nodes, [&]() {
+    return simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+  } );
+
+  compiled_simulator<Ntk> csim = call_with_stopwatch( t_compile, [&]() {
+    return compiled_simulator<Ntk>( ntk );
+  } );
+  call_with_stopwatch( t_run, [&]() {
+    csim.set_patterns( sim.get_patterns() );
+    csim.run();
+  } );
+
+  ntk.foreach_node( [&]( auto const& n ) {
+    equivalent = equivalent && csim.node_value( n ) == values[n];
+  } );
+
+  return { to_seconds( t_nodes ), to_seconds( t_compile ), to_seconds( t_run ) };
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double, bool>
+      exp( "compiled_simulation", "benchmark", "gates", "aig_nodes", "aig_compile", "aig_run", "mig_nodes", "mig_compile", "mig_run", "equivalent" );
+
+  constexpr uint32_t num_patterns = 4096u;
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+    auto const mig = cleanup_dangling<aig_network, mig_network>( aig );
+
+    partial_simulator const sim( aig.num_pis(), num_patterns );
+    bool equivalent{ true };
+    auto const [aig_nodes, aig_compile, aig_run] = compare_simulation( aig, sim, equivalent );
+    auto const [mig_nodes, mig_compile, mig_run] = compare_simulation( mig, sim, equivalent );
+
+    exp( benchmark, aig.num_gates(), aig_nodes, aig_compile, aig_run, mig_nodes, mig_compile, mig_run, equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/events.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* Per-event cost of network events with 0, 1, and 3 registered functions.
+ * `legacy` iterates the listener vectors as networks used to do, creating
+ * the vector of previous children once per listener; `notify` uses the
+ * dispatch functions of `network_events`; `batched` groups 1024
+ * modifications of 256 distinct nodes per batch. */
+using events_t = mockturtle::network_events<mockturtle::aig_network>;
+using signal_t = mockturtle::aig_network::signal;
+
+template<class Fn>
+double ns_per_event( uint64_t num_events, Fn&& fn )
+{
+  mockturtle::stopwatch<>::duration time{ 0 };
+  mockturtle::call_with_stopwatch( time, fn );
+  return mockturtle::to_seconds( time ) * 1e9 / num_events;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double>
+      exp( "network_events", "event", "listeners", "legacy", "notify", "batched" );
+
+  constexpr uint64_t num_events = UINT64_C( 1 ) << 22;
+  uint64_t sink{ 0u };
+
+  for ( auto listeners : { 0u, 1u, 3u } )
+  {
+    events_t events;
+    std::vector<std::shared_ptr<events_t::add_event_type>> add_events;
+    std::vector<std::shared_ptr<events_t::modified_event_type>> modified_events;
+    for ( auto i = 0u; i < listeners; ++i )
+    {
+      add_events.push_back( events.register_add_event( [&sink]( auto const& n ) { sink += n; } ) );
+      modified_events.push_back( events.register_modified_event( [&sink]( auto const& n, auto const& previous ) { sink += n + previous.size(); } ) );
+    }
+
+    auto const add_legacy = ns_per_event( num_events, [&]() {
+      for ( uint64_t n = 0u; n < num_events; ++n )
+      {
+        for ( auto const& fn : events.on_add )
+        {
+          ( *fn )( n );
+        }
+      }
+    } );
+    auto const add_notify = ns_per_event( num_events, [&]() {
+      for ( uint64_t n = 0u; n < num_events; ++n )
+      {
+        events.notify_add( n );
+      }
+    } );
+
+    signal_t const c0{ 1u, 0u }, c1{ 2u, 1u };
+    auto const mod_legacy = ns_per_event( num_events, [&]() {
+      for ( uint64_t n = 0u; n < num_events; ++n )
+      {
+        for ( auto const& fn : events.on_modified )
+        {
+          ( *fn )( n, { c0, c1 } );
+        }
+      }
+    } );
+    auto const mod_notify = ns_per_event( num_events, [&]() {
+      for ( uint64_t n = 0u; n < num_events; ++n )
+      {
+        events.notify_modified( n, { c0, c1 } );
+      }
+    } );
+    auto const mod_batched = ns_per_event( num_events, [&]() {
+      for ( uint64_t n = 0u; n < num_events; ++n )
+      {
+        if ( ( n & 1023u ) == 0u )
+        {
+          events.begin_batch();
+        }
+        events.notify_modified( n & 255u, { c0, c1 } );
+        if ( ( n & 1023u ) == 1023u )
+        {
+          events.end_batch();
+        }
+      }
+    } );
+
+    exp( "add", listeners, add_legacy, add_notify, add_notify );
+    exp( "modified", listeners, mod_legacy, mod_notify, mod_batched );
+  }
+
+  fmt::print( "[i] checksum {}\n", sink );
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
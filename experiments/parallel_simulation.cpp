@@ -0,0 +1,91 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/parallel_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* Whole-network simulation with 262144 patterns: `simulate_nodes` with
+ * `partial_simulator` and with `parallel_simulator` on 1, 2, 4, and 8
+ * threads.  `equivalent` compares the values of all gates. */
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, bool>
+      exp( "parallel_simulation", "benchmark", "gates", "partial", "threads_1", "threads_2", "threads_4", "threads_8", "equivalent" );
+
+  constexpr uint32_t num_patterns = 1u << 18;
+
+  for ( auto const& benchmark : epfl_benchmarks( experiments::epfl & ~experiments::hyp ) )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    partial_simulator const psim( aig.num_pis(), num_patterns );
+    stopwatch<>::duration t_partial{ 0 };
+    unordered_node_map<kitty::partial_truth_table, aig_network> expected( aig );
+    call_with_stopwatch( t_partial, [&]() { simulate_nodes<aig_network>( aig, expected, psim, true ); } );
+
+    bool equivalent{ true };
+    std::vector<double> t_threads;
+    for ( auto num_threads : { 1u, 2u, 4u, 8u } )
+    {
+      parallel_simulator sim( psim.get_patterns() );
+      sim.set_num_threads( num_threads );
+
+      stopwatch<>::duration time{ 0 };
+      unordered_node_map<kitty::partial_truth_table, aig_network> values( aig );
+      call_with_stopwatch( time, [&]() { simulate_nodes<aig_network>( aig, values, sim, true ); } );
+      t_threads.push_back( to_seconds( time ) );
+
+      aig.foreach_gate( [&]( auto const& n ) {
+        equivalent = equivalent && values[n] == expected[n];
+      } );
+    }
+
+    exp( benchmark, aig.num_gates(), to_seconds( t_partial ), t_threads[0], t_threads[1], t_threads[2], t_threads[3], equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
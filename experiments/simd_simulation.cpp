@@ -0,0 +1,101 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/compiled_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* Whole-network simulation with 65536 patterns as in `functional_reduction`
+ * and `sim_resub`: `simulate_nodes` with `partial_simulator` and with
+ * `simd_simulator`, followed by the evaluation time of a compiled network
+ * with each instruction set (without compilation and conversion to partial
+ * truth tables). */
+template<class Fn>
+double seconds( Fn&& fn )
+{
+  mockturtle::stopwatch<>::duration time{ 0 };
+  mockturtle::call_with_stopwatch( time, fn );
+  return mockturtle::to_seconds( time );
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, bool>
+      exp( "simd_simulation", "benchmark", "gates", "partial", "simd", "run_scalar", "run_avx2", "run_avx512", "equivalent" );
+
+  constexpr uint32_t num_patterns = 65536u;
+
+  for ( auto const& benchmark : epfl_benchmarks( experiments::epfl & ~experiments::hyp ) )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    partial_simulator const psim( aig.num_pis(), num_patterns );
+    simd_simulator const ssim( psim.get_patterns() );
+
+    bool equivalent{ true };
+    double t_partial{ 0 }, t_simd{ 0 };
+    {
+      unordered_node_map<kitty::partial_truth_table, aig_network> expected( aig ), values( aig );
+      t_partial = seconds( [&]() { simulate_nodes<aig_network>( aig, expected, psim, true ); } );
+      t_simd = seconds( [&]() { simulate_nodes<aig_network>( aig, values, ssim, true ); } );
+      aig.foreach_gate( [&]( auto const& n ) {
+        equivalent = equivalent && values[n] == expected[n];
+      } );
+    }
+
+    std::vector<double> t_run;
+    for ( auto backend : { simd_backend::scalar, simd_backend::avx2, simd_backend::avx512 } )
+    {
+      compiled_simulator<aig_network> csim( aig, backend );
+      csim.set_patterns( psim.get_patterns() );
+      t_run.push_back( csim.backend() == backend ? seconds( [&]() { csim.run(); } ) : 0.0 );
+    }
+
+    exp( benchmark, aig.num_gates(), t_partial, t_simd, t_run[0], t_run[1], t_run[2], equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,136 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+#include <experiments.hpp>
+
+/* Topological sweeps that only follow fan-ins: bit-parallel simulation with
+ * one 64-bit word per node, depth computation, and cut enumeration. */
+template<class Ntk>
+uint64_t simulation_sweep( Ntk const& ntk, uint32_t rounds )
+{
+  mockturtle::node_map<uint64_t, Ntk> values( ntk );
+  std::mt19937_64 rng( 1u );
+  uint64_t checksum{ 0u };
+
+  for ( auto r = 0u; r < rounds; ++r )
+  {
+    values[ntk.get_constant( false )] = 0u;
+    ntk.foreach_pi( [&]( auto const& n ) {
+      values[n] = rng();
+    } );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      uint64_t v = ~UINT64_C( 0 );
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        v &= ntk.is_complemented( f ) ? ~values[f] : values[f];
+      } );
+      values[n] = v;
+    } );
+    ntk.foreach_po( [&]( auto const& f ) {
+      checksum ^= ntk.is_complemented( f ) ? ~values[f] : values[f];
+    } );
+  }
+
+  return checksum;
+}
+
+template<class Ntk>
+uint32_t depth_sweep( Ntk const& ntk, uint32_t rounds )
+{
+  uint32_t depth{ 0u };
+  for ( auto r = 0u; r < rounds; ++r )
+  {
+    depth = mockturtle::depth_view<Ntk>{ ntk }.depth();
+  }
+  return depth;
+}
+
+template<class Ntk>
+uint64_t cut_sweep( Ntk const& ntk )
+{
+  mockturtle::cut_enumeration_params ps;
+  ps.cut_size = 4u;
+  ps.cut_limit = 8u;
+  auto const cuts = mockturtle::cut_enumeration( ntk, ps );
+  return cuts.total_cuts();
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double, bool>
+      exp( "soa_network", "benchmark", "gates", "sim_aos", "sim_soa", "depth_aos", "depth_soa", "cuts_aos", "cuts_soa", "equivalent" );
+
+  constexpr uint32_t sim_rounds = 256u;
+  constexpr uint32_t depth_rounds = 32u;
+
+  for ( auto const& benchmark : epfl_benchmarks( experiments::hyp | experiments::log2 | experiments::multiplier | experiments::div ) )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+    auto const soa = cleanup_dangling<aig_network, soa_aig_network>( aig );
+
+    stopwatch<>::duration t_sim_aos{ 0 }, t_sim_soa{ 0 };
+    stopwatch<>::duration t_depth_aos{ 0 }, t_depth_soa{ 0 };
+    stopwatch<>::duration t_cuts_aos{ 0 }, t_cuts_soa{ 0 };
+
+    auto const sim_aos = call_with_stopwatch( t_sim_aos, [&]() { return simulation_sweep( aig, sim_rounds ); } );
+    auto const sim_soa = call_with_stopwatch( t_sim_soa, [&]() { return simulation_sweep( soa, sim_rounds ); } );
+    auto const depth_aos = call_with_stopwatch( t_depth_aos, [&]() { return depth_sweep( aig, depth_rounds ); } );
+    auto const depth_soa = call_with_stopwatch( t_depth_soa, [&]() { return depth_sweep( soa, depth_rounds ); } );
+    auto const cuts_aos = call_with_stopwatch( t_cuts_aos, [&]() { return cut_sweep( aig ); } );
+    auto const cuts_soa = call_with_stopwatch( t_cuts_soa, [&]() { return cut_sweep( soa ); } );
+
+    bool const same = sim_aos == sim_soa && depth_aos == depth_soa && cuts_aos == cuts_soa;
+    exp( benchmark, aig.num_gates(),
+         to_seconds( t_sim_aos ), to_seconds( t_sim_soa ),
+         to_seconds( t_depth_aos ), to_seconds( t_depth_soa ),
+         to_seconds( t_cuts_aos ), to_seconds( t_cuts_soa ), same );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -36,6 +36,7 @@
 
 #include "../networks/crossed.hpp"
 #include "../traits.hpp"
+#include "../utils/network_builder.hpp"
 #include "../utils/node_map.hpp"
 #include "../views/topo_view.hpp"
 
@@ -75,6 +76,9 @@ void cleanup_dangling_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator beg
   assert( it == end );
   (void)end;
 
+  /* gates are created without structural hashing if dest supports it */
+  network_builder<NtkDest> builder( dest, dest.size() + ntk.size() );
+
   /* foreach node in topological order */
   topo_view topo{ ntk };
   topo.foreach_node( [&]( auto node ) {
@@ -98,7 +102,7 @@ void cleanup_dangling_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator beg
     /* clone node */
     if constexpr ( std::is_same_v<NtkSrc, NtkDest> )
     {
-      old_to_new[node] = dest.clone_node( ntk, node, children );
+      old_to_new[node] = builder.clone_node( ntk, node, children );
     }
     else
     {
@@ -109,7 +113,7 @@ void cleanup_dangling_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator beg
           static_assert( has_create_and_v<NtkDest>, "NtkDest cannot create AND gates" );
           if ( ntk.is_and( node ) )
           {
-            old_to_new[node] = dest.create_and( children[0], children[1] );
+            old_to_new[node] = builder.create_and( children[0], children[1] );
             break;
           }
         }
@@ -127,7 +131,7 @@ void cleanup_dangling_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator beg
           static_assert( has_create_xor_v<NtkDest>, "NtkDest cannot create XOR gates" );
           if ( ntk.is_xor( node ) )
           {
-            old_to_new[node] = dest.create_xor( children[0], children[1] );
+            old_to_new[node] = builder.create_xor( children[0], children[1] );
             break;
           }
         }
@@ -212,10 +216,21 @@ void cleanup_dangling_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator beg
         std::cerr << "[e] something went wrong, could not copy node " << ntk.node_to_index( node ) << "\n";
       } while ( false );
     }
+  } );
+
+  /* merge structurally equivalent gates */
+  builder.finalize();
+  topo.foreach_node( [&]( auto node ) {
+    old_to_new[node] = builder.resolve( old_to_new[node] );
+  } );
+
+  /* copy names */
+  if constexpr ( has_has_name_v<NtkSrc> && has_get_name_v<NtkSrc> && has_set_name_v<NtkDest> )
+  {
+    topo.foreach_node( [&]( auto node ) {
+      if ( ntk.is_constant( node ) || ntk.is_ci( node ) )
+        return;
 
-    /* copy name */
-    if constexpr ( has_has_name_v<NtkSrc> && has_get_name_v<NtkSrc> && has_set_name_v<NtkDest> )
-    {
       auto const s = ntk.make_signal( node );
       if ( ntk.has_name( s ) )
       {
@@ -225,8 +240,8 @@ void cleanup_dangling_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator beg
       {
         dest.set_name( !old_to_new[node], ntk.get_name( !s ) );
       }
-    }
-  } );
+    } );
+  }
 }
 
 template<typename NtkSrc, typename NtkDest, typename LeavesIterator>
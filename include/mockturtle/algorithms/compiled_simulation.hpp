@@ -0,0 +1,715 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compiled_simulation.hpp
+  \brief Simulate networks lowered into a flat instruction stream
+
+  \author Heinz Riener
+  \author Mathias Soeken
+  \author Siang-Yun (Sonia) Lee
+  \author Marcel Walter
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../traits.hpp"
+#include "detail/simulation_kernels.hpp"
+#include "simulation.hpp"
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Operation of a compiled gate. */
+enum class compiled_opcode : uint8_t
+{
+  and2,
+  xor2,
+  maj3,
+  xor3,
+  mux,
+  lut
+};
+
+/*! \brief A gate of a compiled network.
+ *
+ * The fan-ins of the gate are the slots `fanins[first_fanin]`, ...,
+ * `fanins[first_fanin + num_fanins - 1]` of the compiled program, and bit
+ * `i` of `complements` is set if the `i`-th fan-in is complemented.  For
+ * LUTs, `num_minterms` minterms starting at `first_minterm` list the onset
+ * of the function, or its offset if `offset` is set.
+ */
+struct compiled_instruction
+{
+  compiled_opcode opcode{ compiled_opcode::lut };
+  bool offset{ false };
+  uint8_t num_fanins{ 0u };
+  uint32_t complements{ 0u };
+  uint32_t first_fanin{ 0u };
+  uint32_t first_minterm{ 0u };
+  uint32_t num_minterms{ 0u };
+};
+
+namespace detail
+{
+
+/* the dedicated instruction of a gate, or `lut` to evaluate its node function */
+template<class Ntk>
+compiled_opcode compiled_opcode_of( Ntk const& ntk, node<Ntk> const& n, uint32_t num_fanins )
+{
+  if constexpr ( has_is_maj_v<Ntk> )
+  {
+    if ( num_fanins == 3u && ntk.is_maj( n ) )
+    {
+      return compiled_opcode::maj3;
+    }
+  }
+  if constexpr ( has_is_xor3_v<Ntk> )
+  {
+    if ( num_fanins == 3u && ntk.is_xor3( n ) )
+    {
+      return compiled_opcode::xor3;
+    }
+  }
+  if constexpr ( has_is_ite_v<Ntk> )
+  {
+    if ( num_fanins == 3u && ntk.is_ite( n ) )
+    {
+      return compiled_opcode::mux;
+    }
+  }
+  if constexpr ( has_is_xor_v<Ntk> )
+  {
+    if ( num_fanins == 2u && ntk.is_xor( n ) )
+    {
+      return compiled_opcode::xor2;
+    }
+  }
+  if constexpr ( has_is_and_v<Ntk> )
+  {
+    if ( num_fanins == 2u && ntk.is_and( n ) )
+    {
+      return compiled_opcode::and2;
+    }
+  }
+  return compiled_opcode::lut;
+}
+
+} // namespace detail
+
+/*! \brief Bit-parallel simulator for a network compiled into instructions.
+ *
+ * The constructor lowers the network once into a flat stream of
+ * instructions, one per gate in topological order.  AND, XOR, majority,
+ * XOR3, and if-then-else gates are recognized by `is_and`, `is_xor`,
+ * `is_maj`, `is_xor3`, and `is_ite`; every other gate is evaluated from its
+ * `node_function`.  Values are stored in one arena aligned to 64 bytes, with
+ * `num_words()` 64-bit words for each constant, primary input, and gate
+ * padded to a multiple of 8 words, so that `run` evaluates the network
+ * without allocating memory.
+ *
+ * The gate kernels use AVX2 or AVX-512 instructions if the CPU supports them
+ * (see `simd_backend`), and portable code otherwise.
+ *
+ * The complemented fan-ins of a gate are kept in a 32-bit mask, hence the
+ * constructor throws `std::invalid_argument` for gates with more than 32
+ * fan-ins.
+ *
+ * The simulator does not observe the network: changes made to the network
+ * after compilation require a new `compiled_simulator`.  The network is only
+ * referenced to map nodes to their slots.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `get_constant`
+ * - `constant_value`
+ * - `node_to_index`
+ * - `is_complemented`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `node_function`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network const aig = ...;
+      partial_simulator const sim( aig.num_pis(), 1024 );
+
+      compiled_simulator<aig_network> csim( aig );
+      csim.set_patterns( sim.get_patterns() );
+      csim.run();
+
+      auto const tt = csim.po_value( 0 );
+   \endverbatim
+ */
+template<class Ntk>
+class compiled_simulator
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit compiled_simulator( Ntk const& ntk, simd_backend backend = simd_backend::automatic )
+      : _ntk( ntk ), _backend( detail::resolve_simd_backend( backend ) )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( !is_crossed_network_type_v<Ntk>, "Ntk must not have crossings" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+    static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
+
+    compile();
+  }
+
+  /*! \brief Number of compiled gates. */
+  uint32_t num_instructions() const
+  {
+    return static_cast<uint32_t>( _instructions.size() );
+  }
+
+  /*! \brief Compiled gates in evaluation order. */
+  std::vector<compiled_instruction> const& instructions() const
+  {
+    return _instructions;
+  }
+
+  /*! \brief Instruction set used by `run`. */
+  simd_backend backend() const
+  {
+    return _backend;
+  }
+
+  /*! \brief Number of simulated patterns. */
+  uint32_t num_bits() const
+  {
+    return _num_bits;
+  }
+
+  /*! \brief Number of 64-bit words holding the patterns of each node. */
+  uint32_t num_words() const
+  {
+    return _num_words;
+  }
+
+  /*! \brief Resizes the arena to hold `num_bits` patterns for each node.
+   *
+   * The patterns of the primary inputs are reset to 0.
+   */
+  void set_num_bits( uint32_t num_bits )
+  {
+    _num_bits = num_bits;
+    _num_words = ( num_bits + 63u ) >> 6;
+    _stride = ( _num_words + detail::simd_words - 1u ) / detail::simd_words * detail::simd_words;
+    _arena.assign( static_cast<std::size_t>( _stride ) * _num_slots, UINT64_C( 0 ) );
+    _slots.resize( _num_slots );
+    for ( auto i = 0u; i < _num_slots; ++i )
+    {
+      _slots[i] = _arena.data() + static_cast<std::size_t>( i ) * _stride;
+    }
+    std::fill_n( slot_words( 1u ), _stride, ~UINT64_C( 0 ) );
+  }
+
+  /*! \brief Sets the patterns of the primary inputs.
+   *
+   * \param patterns One partial truth table of the same length for each primary input
+   */
+  void set_patterns( std::vector<kitty::partial_truth_table> const& patterns )
+  {
+    assert( patterns.size() == _num_pis );
+    set_num_bits( patterns.empty() ? 0u : patterns.front().num_bits() );
+    for ( auto i = 0u; i < _num_pis; ++i )
+    {
+      assert( patterns[i].num_bits() == _num_bits );
+      std::copy( patterns[i].begin(), patterns[i].end(), pi_words( i ) );
+    }
+  }
+
+  /*! \brief Writable words of the `index`-th primary input. */
+  uint64_t* pi_words( uint32_t index )
+  {
+    assert( index < _num_pis );
+    return slot_words( 2u + index );
+  }
+
+  /*! \brief Evaluates all gates on the current patterns. */
+  void run()
+  {
+    evaluate( _slots.data(), _stride );
+  }
+
+  /*! \brief Evaluates all gates on values stored outside of the arena.
+   *
+   * `words_of( n )` must return a pointer to `( num_bits + 63 ) / 64` words
+   * for every primary input and every gate `n`.  The words of the primary
+   * inputs hold the patterns and the words of the gates are overwritten with
+   * their values.  The arena is not used.
+   */
+  template<class Fn>
+  void run_on( uint32_t num_bits, Fn&& words_of )
+  {
+    auto const num_words = ( num_bits + 63u ) >> 6;
+    _constants.assign( 2u * num_words, UINT64_C( 0 ) );
+    std::fill_n( _constants.data() + num_words, num_words, ~UINT64_C( 0 ) );
+
+    _external_slots.resize( _num_slots );
+    _external_slots[0] = _constants.data();
+    _external_slots[1] = _constants.data() + num_words;
+    for ( auto i = 2u; i < _num_slots; ++i )
+    {
+      _external_slots[i] = words_of( _slot_nodes[i - 2u] );
+    }
+    evaluate( _external_slots.data(), num_words );
+  }
+
+  /*! \brief Words of a node, valid after `run`. */
+  uint64_t const* node_words( node const& n ) const
+  {
+    return slot_words( _node_to_slot.at( _ntk.node_to_index( n ) ) );
+  }
+
+  /*! \brief Simulation value of a node, valid after `run`. */
+  kitty::partial_truth_table node_value( node const& n ) const
+  {
+    return to_truth_table( _node_to_slot.at( _ntk.node_to_index( n ) ), false );
+  }
+
+  /*! \brief Simulation value of the `index`-th primary output, valid after `run`. */
+  kitty::partial_truth_table po_value( uint32_t index ) const
+  {
+    auto const& [slot, complemented] = _pos.at( index );
+    return to_truth_table( slot, complemented );
+  }
+
+private:
+  void compile()
+  {
+    auto const& ntk = _ntk;
+    _node_to_slot.assign( ntk.size(), std::numeric_limits<uint32_t>::max() );
+
+    auto const c0 = ntk.get_node( ntk.get_constant( false ) );
+    auto const c1 = ntk.get_node( ntk.get_constant( true ) );
+    _node_to_slot[ntk.node_to_index( c0 )] = ntk.constant_value( c0 ) ? 1u : 0u;
+    _node_to_slot[ntk.node_to_index( c1 )] = ntk.constant_value( c1 ) ? 1u : 0u;
+
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      _node_to_slot[ntk.node_to_index( n )] = 2u + i;
+      _slot_nodes.push_back( n );
+      ++_num_pis;
+    } );
+
+    /* gates are compiled after their fan-ins, also if `foreach_gate` is not topological */
+    auto const compiled = [&]( node const& n ) {
+      return _node_to_slot[ntk.node_to_index( n )] != std::numeric_limits<uint32_t>::max();
+    };
+    std::vector<node> stack;
+    uint32_t max_fanins{ 0u };
+    ntk.foreach_gate( [&]( auto const& root ) {
+      stack.push_back( root );
+      while ( !stack.empty() )
+      {
+        auto const n = stack.back();
+        if ( compiled( n ) )
+        {
+          stack.pop_back();
+          continue;
+        }
+
+        bool ready{ true };
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          if ( !compiled( ntk.get_node( f ) ) )
+          {
+            stack.push_back( ntk.get_node( f ) );
+            ready = false;
+          }
+        } );
+        if ( ready )
+        {
+          stack.pop_back();
+          compile_gate( n, max_fanins );
+        }
+      }
+    } );
+
+    ntk.foreach_po( [&]( auto const& f ) {
+      _pos.emplace_back( _node_to_slot[ntk.node_to_index( ntk.get_node( f ) )], ntk.is_complemented( f ) );
+    } );
+
+    _num_slots = 2u + _num_pis + static_cast<uint32_t>( _instructions.size() );
+    _lut_inputs.resize( max_fanins );
+    _lut_masks.resize( max_fanins );
+    set_num_bits( 0u );
+  }
+
+  void compile_gate( node const& n, uint32_t& max_fanins )
+  {
+    auto const& ntk = _ntk;
+
+    if ( ntk.fanin_size( n ) > 32u )
+    {
+      throw std::invalid_argument( "compiled_simulator supports gates with at most 32 fan-ins" );
+    }
+
+    compiled_instruction ins;
+    ins.first_fanin = static_cast<uint32_t>( _fanins.size() );
+    ntk.foreach_fanin( n, [&]( auto const& f, uint32_t j ) {
+      _fanins.push_back( _node_to_slot[ntk.node_to_index( ntk.get_node( f ) )] );
+      if ( ntk.is_complemented( f ) )
+      {
+        ins.complements |= 1u << j;
+      }
+    } );
+    ins.num_fanins = static_cast<uint8_t>( _fanins.size() - ins.first_fanin );
+    ins.opcode = detail::compiled_opcode_of( ntk, n, ins.num_fanins );
+    if ( ins.opcode == compiled_opcode::lut )
+    {
+      add_minterms( ins, ntk.node_function( n ) );
+      max_fanins = std::max<uint32_t>( max_fanins, ins.num_fanins );
+    }
+
+    _node_to_slot[ntk.node_to_index( n )] = 2u + _num_pis + static_cast<uint32_t>( _instructions.size() );
+    _slot_nodes.push_back( n );
+    _instructions.push_back( ins );
+  }
+
+  /* stores the smaller one of the onset and the offset of `function` */
+  void add_minterms( compiled_instruction& ins, kitty::dynamic_truth_table const& function )
+  {
+    assert( function.num_vars() == ins.num_fanins );
+    auto const num_ones = static_cast<uint32_t>( kitty::count_ones( function ) );
+    ins.offset = 2u * num_ones > function.num_bits();
+    ins.first_minterm = static_cast<uint32_t>( _minterms.size() );
+    for ( auto m = 0u; m < function.num_bits(); ++m )
+    {
+      if ( kitty::get_bit( function, m ) != ins.offset )
+      {
+        _minterms.push_back( m );
+      }
+    }
+    ins.num_minterms = static_cast<uint32_t>( _minterms.size() ) - ins.first_minterm;
+  }
+
+  void evaluate( uint64_t* const* slots, uint32_t num_words )
+  {
+    switch ( _backend )
+    {
+    case simd_backend::avx512:
+      evaluate_with<simd_backend::avx512>( slots, num_words );
+      break;
+    case simd_backend::avx2:
+      evaluate_with<simd_backend::avx2>( slots, num_words );
+      break;
+    default:
+      evaluate_with<simd_backend::scalar>( slots, num_words );
+      break;
+    }
+  }
+
+  template<simd_backend Backend>
+  void evaluate_with( uint64_t* const* slots, uint32_t num_words )
+  {
+    using kernels = detail::simulation_kernels<Backend>;
+    using detail::complement_mask;
+
+    auto const first_gate = 2u + _num_pis;
+    for ( auto i = 0u; i < _instructions.size(); ++i )
+    {
+      auto const& ins = _instructions[i];
+      uint32_t const* fanins = _fanins.data() + ins.first_fanin;
+      uint64_t* out = slots[first_gate + i];
+
+      switch ( ins.opcode )
+      {
+      case compiled_opcode::and2:
+        kernels::and2( out, slots[fanins[0]], complement_mask( ins.complements, 0u ),
+                       slots[fanins[1]], complement_mask( ins.complements, 1u ), num_words );
+        break;
+      case compiled_opcode::xor2:
+        kernels::xor2( out, slots[fanins[0]], slots[fanins[1]],
+                       complement_mask( ins.complements, 0u ) ^ complement_mask( ins.complements, 1u ), num_words );
+        break;
+      case compiled_opcode::maj3:
+        kernels::maj3( out, slots[fanins[0]], complement_mask( ins.complements, 0u ),
+                       slots[fanins[1]], complement_mask( ins.complements, 1u ),
+                       slots[fanins[2]], complement_mask( ins.complements, 2u ), num_words );
+        break;
+      case compiled_opcode::xor3:
+        kernels::xor3( out, slots[fanins[0]], slots[fanins[1]], slots[fanins[2]],
+                       complement_mask( ins.complements, 0u ) ^ complement_mask( ins.complements, 1u ) ^ complement_mask( ins.complements, 2u ), num_words );
+        break;
+      case compiled_opcode::mux:
+        kernels::mux( out, slots[fanins[0]], complement_mask( ins.complements, 0u ),
+                      slots[fanins[1]], complement_mask( ins.complements, 1u ),
+                      slots[fanins[2]], complement_mask( ins.complements, 2u ), num_words );
+        break;
+      case compiled_opcode::lut:
+        for ( auto j = 0u; j < ins.num_fanins; ++j )
+        {
+          _lut_inputs[j] = slots[fanins[j]];
+          _lut_masks[j] = complement_mask( ins.complements, j );
+        }
+        kernels::lut( out, _lut_inputs.data(), _lut_masks.data(), ins.num_fanins,
+                      _minterms.data() + ins.first_minterm, ins.num_minterms,
+                      ins.offset ? ~UINT64_C( 0 ) : UINT64_C( 0 ), num_words );
+        break;
+      }
+    }
+  }
+
+  kitty::partial_truth_table to_truth_table( uint32_t slot, bool complemented ) const
+  {
+    assert( slot < _num_slots );
+    kitty::partial_truth_table tt( _num_bits );
+    uint64_t const* words = slot_words( slot );
+    uint64_t const c = complemented ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+    std::transform( words, words + _num_words, tt.begin(), [c]( auto word ) { return word ^ c; } );
+    tt.mask_bits();
+    return tt;
+  }
+
+  uint64_t* slot_words( uint32_t slot )
+  {
+    return _slots[slot];
+  }
+
+  uint64_t const* slot_words( uint32_t slot ) const
+  {
+    return _slots[slot];
+  }
+
+private:
+  Ntk const& _ntk;
+  simd_backend _backend;
+
+  /* slot 0 is constant 0, slot 1 is constant 1, followed by PIs and gates */
+  std::vector<uint32_t> _node_to_slot;
+  std::vector<compiled_instruction> _instructions;
+  std::vector<uint32_t> _fanins;
+  std::vector<uint32_t> _minterms;
+  std::vector<std::pair<uint32_t, bool>> _pos;
+  uint32_t _num_pis{ 0u };
+  uint32_t _num_slots{ 2u };
+
+  std::vector<node> _slot_nodes;
+
+  std::vector<uint64_t, detail::aligned_allocator<uint64_t>> _arena;
+  std::vector<uint64_t*> _slots;
+  uint32_t _num_bits{ 0u };
+  uint32_t _num_words{ 0u };
+  uint32_t _stride{ 0u };
+
+  /* constants and slots for `run_on` */
+  std::vector<uint64_t, detail::aligned_allocator<uint64_t>> _constants;
+  std::vector<uint64_t*> _external_slots;
+
+  /* scratch space for LUT evaluation, sized at compilation */
+  std::vector<uint64_t const*> _lut_inputs;
+  std::vector<uint64_t> _lut_masks;
+};
+
+/*! \brief Simulates partial truth tables with SIMD kernels.
+ *
+ * This class has the same interfaces as `partial_simulator` and can be used
+ * in its place, for example in `sim_resubstitution` and
+ * `functional_reduction`.  Simulating whole truth tables with
+ * `simulate_nodes( ntk, node_to_value, sim, true )` evaluates all gates with
+ * a `compiled_simulator` using the instruction set `backend()`, directly on
+ * the partial truth tables in `node_to_value`.
+ * Re-simulating the last block and `simulate_node` use the implementation of
+ * `partial_simulator`.
+ */
+class simd_simulator : public partial_simulator
+{
+public:
+  using partial_simulator::partial_simulator;
+
+  simd_simulator() = default;
+
+  /*! \brief Instruction set used to simulate whole truth tables. */
+  simd_backend backend() const
+  {
+    return _backend;
+  }
+
+  /*! \brief Selects the instruction set used to simulate whole truth tables. */
+  void set_backend( simd_backend backend )
+  {
+    _backend = backend;
+  }
+
+private:
+  simd_backend _backend{ simd_backend::automatic };
+};
+
+namespace detail
+{
+
+/* Simulates whole truth tables of all gates with a `compiled_simulator`,
+ * evaluating ranges of words on up to `num_threads` threads.  Each thread
+ * writes to disjoint words of the truth tables, hence the result does not
+ * depend on the number of threads.  Networks without in-place computation
+ * of partial truth tables are always simulated as a whole. */
+template<class Ntk, class Simulator, class Container>
+void simulate_nodes_compiled( Ntk const& ntk, Container& node_to_value, Simulator const& sim, bool simulate_whole_tt, uint32_t num_threads )
+{
+  if constexpr ( has_compute_inplace_v<Ntk, kitty::partial_truth_table> )
+  {
+    if ( !simulate_whole_tt )
+    {
+      simulate_nodes<Ntk, partial_simulator, Container>( ntk, node_to_value, sim, false );
+      return;
+    }
+
+    /* keep the semantics of `partial_simulator` for given values of gates */
+    bool has_values{ false };
+    ntk.foreach_gate( [&]( auto const& n ) {
+      has_values = has_values || node_to_value.has( n );
+    } );
+    if ( has_values )
+    {
+      simulate_nodes<Ntk, partial_simulator, Container>( ntk, node_to_value, sim, true );
+      return;
+    }
+  }
+
+  update_const_pi( ntk, node_to_value, sim );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    node_to_value[n] = kitty::partial_truth_table( sim.num_bits() );
+  } );
+
+  /* the gates are evaluated in place */
+  std::vector<uint64_t*> words( ntk.size(), nullptr );
+  ntk.foreach_pi( [&]( auto const& n ) {
+    words[ntk.node_to_index( n )] = node_to_value[n]._bits.data();
+  } );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    words[ntk.node_to_index( n )] = node_to_value[n]._bits.data();
+  } );
+
+  compiled_simulator<Ntk> csim( ntk, sim.backend() );
+  auto const num_words = ( sim.num_bits() + 63u ) >> 6;
+  auto const evaluate = [&]( compiled_simulator<Ntk>& local, uint32_t begin, uint32_t end ) {
+    local.run_on( ( end - begin ) * 64u, [&]( auto const& n ) {
+      return words[ntk.node_to_index( n )] + begin;
+    } );
+  };
+
+  /* ranges of words are multiples of a vector */
+  auto chunk = ( num_words + std::max( num_threads, 1u ) - 1u ) / std::max( num_threads, 1u );
+  chunk = std::max( simd_words, ( chunk + simd_words - 1u ) / simd_words * simd_words );
+  if ( chunk >= num_words )
+  {
+    evaluate( csim, 0u, num_words );
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for ( auto begin = 0u; begin < num_words; begin += chunk )
+    {
+      threads.emplace_back( [&, begin]() {
+        /* each thread has its own scratch space */
+        auto local = csim;
+        evaluate( local, begin, std::min( begin + chunk, num_words ) );
+      } );
+    }
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+  }
+
+  ntk.foreach_gate( [&]( auto const& n ) {
+    node_to_value[n].mask_bits();
+  } );
+}
+
+} // namespace detail
+
+/*! \brief Simulates a network with `simd_simulator`.
+ *
+ * This overload has the same semantics as `simulate_nodes` with a
+ * `partial_simulator`.  When `simulate_whole_tt` is true and no gate has a
+ * value in `node_to_value`, the network is compiled and evaluated with
+ * vectorized kernels.
+ */
+template<class Ntk, class Container>
+void simulate_nodes( Ntk const& ntk, Container& node_to_value, simd_simulator const& sim, bool simulate_whole_tt )
+{
+  detail::simulate_nodes_compiled( ntk, node_to_value, sim, simulate_whole_tt, 1u );
+}
+
+/*! \brief Simulates the primary outputs of a network with a compiled simulator.
+ *
+ * Computes the same values as `simulate<kitty::partial_truth_table>` with a
+ * `partial_simulator`, by compiling the network into a `compiled_simulator`
+ * and evaluating it once on the patterns of `sim`.
+ *
+ * \param ntk Network
+ * \param sim Simulator providing the patterns of the primary inputs
+ */
+template<class Ntk>
+std::vector<kitty::partial_truth_table> simulate_compiled( Ntk const& ntk, partial_simulator const& sim )
+{
+  compiled_simulator<Ntk> csim( ntk );
+  csim.set_patterns( sim.get_patterns() );
+  csim.run();
+
+  std::vector<kitty::partial_truth_table> po_values;
+  po_values.reserve( ntk.num_pos() );
+  for ( auto i = 0u; i < ntk.num_pos(); ++i )
+  {
+    po_values.push_back( csim.po_value( i ) );
+  }
+  return po_values;
+}
+
+} // namespace mockturtle
@@ -36,11 +36,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <deque>
 #include <iostream>
 #include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <kitty/constructors.hpp>
@@ -76,6 +81,15 @@ struct cut_enumeration_params
   /*! \brief Prune cuts by removing don't cares. */
   bool minimize_truth_table{ false };
 
+  /*! \brief Number of threads.
+   *
+   * When larger than 1, `cut_enumeration` levelizes the network and computes
+   * the cuts of the nodes of a level concurrently.  The cuts and truth table
+   * literals are the same as with a single thread.  Only used by
+   * `cut_enumeration`.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 
@@ -91,11 +105,23 @@ struct cut_enumeration_stats
   /*! \brief Time for truth table computation. */
   stopwatch<>::duration time_truth_table{ 0 };
 
+  /*! \brief Number of merged cuts within the cut size. */
+  uint64_t num_merged{ 0 };
+
+  /*! \brief Number of merged cuts discarded as dominated. */
+  uint64_t num_dominated{ 0 };
+
+  /*! \brief Number of merged cuts discarded by the priority-cut cutoff. */
+  uint64_t num_pruned{ 0 };
+
   /*! \brief Prints report. */
   void report() const
   {
     std::cout << fmt::format( "[i] total time       = {:>5.2f} secs\n", to_seconds( time_total ) );
     std::cout << fmt::format( "[i] truth table time = {:>5.2f} secs\n", to_seconds( time_truth_table ) );
+    std::cout << fmt::format( "[i] merged cuts      = {:>8d}\n", num_merged );
+    std::cout << fmt::format( "[i] dominated cuts   = {:>8d}\n", num_dominated );
+    std::cout << fmt::format( "[i] pruned cuts      = {:>8d}\n", num_pruned );
   }
 };
 
@@ -125,9 +151,15 @@ using cut_type = cut<max_cut_size, cut_data<ComputeTruth, T>>;
 template<typename Ntk, bool ComputeTruth, typename CutData>
 struct network_cuts;
 
+template<typename Ntk, bool ComputeTruth, typename CutData>
+struct lazy_network_cuts;
+
 template<typename Ntk, bool ComputeTruth = false, typename CutData = empty_cut_data>
 network_cuts<Ntk, ComputeTruth, CutData> cut_enumeration( Ntk const& ntk, cut_enumeration_params const& ps = {}, cut_enumeration_stats* pst = nullptr );
 
+template<typename Ntk, bool ComputeTruth = false, typename CutData = empty_cut_data, typename CutCost>
+network_cuts<Ntk, ComputeTruth, CutData> priority_cut_enumeration( Ntk const& ntk, CutCost const& cost, cut_enumeration_params const& ps = {}, cut_enumeration_stats* pst = nullptr );
+
 /* function to update a cut */
 template<typename CutData>
 struct cut_enumeration_update_cut
@@ -144,7 +176,7 @@ struct cut_enumeration_update_cut
 
 namespace detail
 {
-template<typename Ntk, bool ComputeTruth, typename CutData>
+template<typename Ntk, bool ComputeTruth, typename CutData, typename NetworkCuts = network_cuts<Ntk, ComputeTruth, CutData>, typename CutCost = void>
 class cut_enumeration_impl;
 }
 /*! \endcond */
@@ -188,7 +220,20 @@ public:
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
   {
-    return _truth_tables[cut->func_id];
+    kitty::dynamic_truth_table tt;
+    tt = lookup_truth_table( cut->func_id );
+    return tt;
+  }
+
+  /*! \brief Returns a view on the truth table of a cut
+   *
+   * The view points into the truth table cache and is valid until the next
+   * truth table is inserted.
+   */
+  template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
+  truth_table_view truth_table_ref( cut_t const& cut ) const
+  {
+    return lookup_truth_table( cut->func_id );
   }
 
   /*! \brief Returns the total number of tuples that were tried to be merged */
@@ -240,16 +285,27 @@ public:
    */
   uint32_t insert_truth_table( kitty::dynamic_truth_table const& tt )
   {
-    return _truth_tables.insert( tt );
+    if ( _local == nullptr )
+    {
+      return _truth_tables.insert( tt );
+    }
+
+    /* inside a thread of the parallel enumeration */
+    auto const lit = _local->cache.insert( tt ) | local_literal;
+    _local->log->emplace_back( lit );
+    return lit;
   }
 
 private:
-  template<typename _Ntk, bool _ComputeTruth, typename _CutData>
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData, typename _NetworkCuts, typename _CutCost>
   friend class detail::cut_enumeration_impl;
 
   template<typename _Ntk, bool _ComputeTruth, typename _CutData>
   friend network_cuts<_Ntk, _ComputeTruth, _CutData> cut_enumeration( _Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats* pst );
 
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData, typename _CutCost>
+  friend network_cuts<_Ntk, _ComputeTruth, _CutData> priority_cut_enumeration( _Ntk const& ntk, _CutCost const& cost, cut_enumeration_params const& ps, cut_enumeration_stats* pst );
+
 private:
   void add_zero_cut( uint32_t index )
   {
@@ -271,12 +327,29 @@ private:
     }
   }
 
+  truth_table_view lookup_truth_table( uint32_t lit ) const
+  {
+    return ( lit & local_literal ) ? _local->cache[lit ^ local_literal] : _truth_tables[lit];
+  }
+
+  /* truth tables computed by a thread of the parallel enumeration, until
+   * they are merged into `_truth_tables`; `log` records the literals
+   * inserted for the current node in order */
+  struct local_truth_tables
+  {
+    truth_table_arena_cache<kitty::dynamic_truth_table> cache;
+    std::vector<uint32_t>* log{ nullptr };
+  };
+
+  static constexpr uint32_t local_literal = 0x80000000u;
+  static inline thread_local local_truth_tables* _local{ nullptr };
+
 private:
   /* compressed representation of cuts */
   std::vector<cut_set_t> _cuts;
 
   /* cut truth tables */
-  truth_table_cache<kitty::dynamic_truth_table> _truth_tables;
+  truth_table_arena_cache<kitty::dynamic_truth_table> _truth_tables;
 
   /* statistics */
   uint32_t _total_tuples{};
@@ -287,14 +360,84 @@ private:
 namespace detail
 {
 
-template<typename Ntk, bool ComputeTruth, typename CutData>
+/* the best cuts of a node with respect to a cost, sorted by cost and size */
+template<typename CutCost, typename Cut, typename NetworkCuts>
+struct priority_cuts
+{
+  using cost_t = std::decay_t<std::invoke_result_t<CutCost const&, Cut const&, NetworkCuts const&>>;
+
+  explicit priority_cuts( CutCost const& cost )
+      : cost( cost )
+  {
+  }
+
+  /* whether a cut with cost `c` would not be among the best `limit` cuts */
+  bool is_pruned( cost_t const& c, Cut const& cut, uint32_t limit ) const
+  {
+    return cuts.size() >= limit && ( limit == 0u || !less( c, cut, cuts.back() ) );
+  }
+
+  bool is_dominated( Cut const& cut ) const
+  {
+    return std::any_of( cuts.begin(), cuts.end(), [&]( auto const& other ) { return other.second.dominates( cut ); } );
+  }
+
+  /* removes the cuts dominated by `cut` and the worst cut if there are more than `limit` */
+  void insert( cost_t const& c, Cut const& cut, uint32_t limit )
+  {
+    cuts.erase( std::remove_if( cuts.begin(), cuts.end(), [&]( auto const& other ) { return cut.dominates( other.second ); } ), cuts.end() );
+    auto const it = std::find_if( cuts.begin(), cuts.end(), [&]( auto const& other ) { return less( c, cut, other ); } );
+    cuts.emplace( it, c, cut );
+    if ( cuts.size() > limit )
+    {
+      cuts.pop_back();
+    }
+  }
+
+  /* moves the cuts into a cut set in order */
+  template<typename CutSet>
+  void move_to( CutSet& set )
+  {
+    for ( auto const& [c, cut] : cuts )
+    {
+      set.add_cut( cut.begin(), cut.end() ).data() = cut.data();
+    }
+    cuts.clear();
+  }
+
+  static bool less( cost_t const& c, Cut const& cut, std::pair<cost_t, Cut> const& other )
+  {
+    if ( c < other.first )
+    {
+      return true;
+    }
+    if ( other.first < c )
+    {
+      return false;
+    }
+    return cut.size() < other.second.size();
+  }
+
+  CutCost const& cost;
+  std::vector<std::pair<cost_t, Cut>> cuts;
+};
+
+template<typename Cut, typename NetworkCuts>
+struct priority_cuts<void, Cut, NetworkCuts>
+{
+};
+
+template<typename Ntk, bool ComputeTruth, typename CutData, typename NetworkCuts, typename CutCost>
 class cut_enumeration_impl
 {
 public:
-  using cut_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_t;
-  using cut_set_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_set_t;
+  using cut_t = typename NetworkCuts::cut_t;
+  using cut_set_t = typename NetworkCuts::cut_set_t;
 
-  explicit cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, network_cuts<Ntk, ComputeTruth, CutData>& cuts )
+  /* keep the best cuts with respect to a cost instead of the cut order */
+  static constexpr bool priority = !std::is_void_v<CutCost>;
+
+  explicit cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, NetworkCuts& cuts )
       : ntk( ntk ),
         ps( ps ),
         st( st ),
@@ -303,42 +446,256 @@ public:
     assert( ps.cut_limit < cuts.max_cut_num && "cut_limit exceeds the compile-time limit for the maximum number of cuts" );
   }
 
+  template<typename Cost = CutCost, typename = std::enable_if_t<!std::is_void_v<Cost>>>
+  explicit cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, NetworkCuts& cuts, Cost const& cost )
+      : ntk( ntk ),
+        ps( ps ),
+        st( st ),
+        cuts( cuts ),
+        pcuts( cost )
+  {
+    assert( ps.cut_limit < cuts.max_cut_num && "cut_limit exceeds the compile-time limit for the maximum number of cuts" );
+  }
+
 public:
   void run()
   {
     stopwatch t( st.time_total );
 
+    if ( ps.num_threads > 1u )
+    {
+      run_parallel();
+      return;
+    }
+
     ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+      compute_cuts( ntk.node_to_index( node ) );
+    } );
 
-      if ( ps.very_verbose )
+    cuts._total_tuples += total_tuples;
+    cuts._total_cuts += total_cuts;
+  }
+
+  /* computes the cuts of a node, the cuts of its fanins must be available */
+  void compute_cuts( uint32_t index )
+  {
+    const auto node = ntk.index_to_node( index );
+
+    if ( ps.very_verbose )
+    {
+      std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+    }
+
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_ci( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
       {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+        merge_cuts2( index );
       }
+      else
+      {
+        merge_cuts( index );
+      }
+    }
+  }
 
-      if ( ntk.is_constant( node ) )
+private:
+  /* The nodes of a level only depend on the cuts of lower levels and are
+   * distributed over the threads.  Each thread inserts truth tables into
+   * its own cache; the literals are merged into the shared cache after each
+   * level, in node order.  Finally, the shared cache is renumbered in the
+   * order of the sequential enumeration, which is replayed from the logged
+   * insertions of each node. */
+  void run_parallel()
+  {
+    using local_truth_tables = typename network_cuts<Ntk, ComputeTruth, CutData>::local_truth_tables;
+    static constexpr uint32_t min_nodes_per_thread = 32u;
+
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> node_level( ntk.size(), 0u );
+    std::vector<std::vector<uint32_t>> levels( 1u );
+    ntk.foreach_node( [&]( auto const& n ) {
+      auto const index = ntk.node_to_index( n );
+      order.emplace_back( index );
+
+      uint32_t level{ 0u };
+      if ( !ntk.is_constant( n ) && !ntk.is_ci( n ) )
       {
-        cuts.add_zero_cut( index );
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          level = std::max( level, node_level[ntk.node_to_index( ntk.get_node( f ) )] + 1u );
+        } );
       }
-      else if ( ntk.is_ci( node ) )
+      node_level[index] = level;
+      if ( level >= levels.size() )
       {
-        cuts.add_unit_cut( index );
+        levels.resize( level + 1u );
+      }
+      levels[level].emplace_back( index );
+    } );
+
+    auto const num_threads = ps.num_threads;
+    std::vector<cut_enumeration_stats> worker_st( num_threads );
+    std::vector<cut_enumeration_impl> workers;
+    workers.reserve( num_threads );
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      if constexpr ( priority )
+      {
+        workers.emplace_back( ntk, ps, worker_st[t], cuts, pcuts.cost );
       }
       else
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+        workers.emplace_back( ntk, ps, worker_st[t], cuts );
+      }
+    }
+
+    std::vector<local_truth_tables> locals( num_threads );
+    std::vector<std::vector<uint32_t>> logs( ComputeTruth ? ntk.size() : 0u );
+    std::vector<uint32_t> owner( ComputeTruth ? ntk.size() : 0u );
+
+    auto const process = [&]( uint32_t t, std::vector<uint32_t> const& nodes, uint32_t begin, uint32_t end ) {
+      if constexpr ( ComputeTruth )
+      {
+        network_cuts<Ntk, ComputeTruth, CutData>::_local = &locals[t];
+      }
+      for ( auto i = begin; i < end; ++i )
+      {
+        if constexpr ( ComputeTruth )
         {
-          merge_cuts2( index );
+          owner[nodes[i]] = t;
+          locals[t].log = &logs[nodes[i]];
         }
-        else
+        workers[t].compute_cuts( nodes[i] );
+      }
+      if constexpr ( ComputeTruth )
+      {
+        network_cuts<Ntk, ComputeTruth, CutData>::_local = nullptr;
+      }
+    };
+
+    for ( auto const& nodes : levels )
+    {
+      auto const num_nodes = static_cast<uint32_t>( nodes.size() );
+      if ( num_nodes < num_threads * min_nodes_per_thread )
+      {
+        process( 0u, nodes, 0u, num_nodes );
+      }
+      else
+      {
+        auto const chunk = ( num_nodes + num_threads - 1u ) / num_threads;
+        std::vector<std::thread> threads;
+        for ( auto t = 0u; t < num_threads; ++t )
         {
-          merge_cuts( index );
+          threads.emplace_back( [&, t]() {
+            process( t, nodes, std::min( t * chunk, num_nodes ), std::min( ( t + 1u ) * chunk, num_nodes ) );
+          } );
+        }
+        for ( auto& thread : threads )
+        {
+          thread.join();
         }
       }
-    } );
+
+      if constexpr ( ComputeTruth )
+      {
+        merge_local_truth_tables( nodes, locals, logs, owner );
+      }
+    }
+
+    if constexpr ( ComputeTruth )
+    {
+      renumber_truth_tables( order, logs );
+    }
+
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      st.time_truth_table += worker_st[t].time_truth_table;
+      st.num_merged += worker_st[t].num_merged;
+      st.num_dominated += worker_st[t].num_dominated;
+      st.num_pruned += worker_st[t].num_pruned;
+      cuts._total_tuples += workers[t].total_tuples;
+      cuts._total_cuts += workers[t].total_cuts;
+    }
+  }
+
+  template<typename LocalTruthTables>
+  void merge_local_truth_tables( std::vector<uint32_t> const& nodes, std::vector<LocalTruthTables>& locals, std::vector<std::vector<uint32_t>>& logs, std::vector<uint32_t> const& owner )
+  {
+    auto const local_literal = network_cuts<Ntk, ComputeTruth, CutData>::local_literal;
+
+    std::vector<std::vector<uint32_t>> to_shared( locals.size() );
+    for ( auto t = 0u; t < locals.size(); ++t )
+    {
+      to_shared[t].assign( locals[t].cache.size(), UINT32_MAX );
+    }
+    auto const merge = [&]( uint32_t t, uint32_t lit ) {
+      if ( ( lit & local_literal ) == 0u )
+      {
+        return lit;
+      }
+      lit ^= local_literal;
+      auto& index = to_shared[t][lit >> 1];
+      if ( index == UINT32_MAX )
+      {
+        index = cuts._truth_tables.insert( locals[t].cache[lit & ~1u] ) >> 1;
+      }
+      return ( index << 1 ) | ( lit & 1u );
+    };
+
+    for ( auto const& index : nodes )
+    {
+      for ( auto& lit : logs[index] )
+      {
+        lit = merge( owner[index], lit );
+      }
+      for ( auto& cut : cuts.cuts( index ) )
+      {
+        ( *cut )->func_id = merge( owner[index], ( *cut )->func_id );
+      }
+    }
+
+    for ( auto& local : locals )
+    {
+      local.cache = truth_table_arena_cache<kitty::dynamic_truth_table>();
+    }
+  }
+
+  void renumber_truth_tables( std::vector<uint32_t> const& order, std::vector<std::vector<uint32_t>> const& logs )
+  {
+    truth_table_arena_cache<kitty::dynamic_truth_table> ordered;
+    std::vector<uint32_t> to_ordered( cuts._truth_tables.size(), UINT32_MAX );
+    to_ordered[0] = ordered.insert( cuts._truth_tables[0] ) >> 1;
+    to_ordered[1] = ordered.insert( cuts._truth_tables[2] ) >> 1;
+
+    for ( auto const& index : order )
+    {
+      for ( auto const& lit : logs[index] )
+      {
+        if ( to_ordered[lit >> 1] == UINT32_MAX )
+        {
+          to_ordered[lit >> 1] = ordered.insert( cuts._truth_tables[lit & ~1u] ) >> 1;
+        }
+      }
+    }
+
+    for ( auto const& index : order )
+    {
+      for ( auto& cut : cuts.cuts( index ) )
+      {
+        ( *cut )->func_id = ( to_ordered[( *cut )->func_id >> 1] << 1 ) | ( ( *cut )->func_id & 1u );
+      }
+    }
+    cuts._truth_tables = std::move( ordered );
   }
 
-private:
   uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
   {
     stopwatch t( st.time_truth_table );
@@ -347,7 +704,7 @@ private:
     auto i = 0;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = kitty::extend_to( cuts._truth_tables[( *cut )->func_id], res.size() );
+      tt[i] = kitty::extend_to( cuts.lookup_truth_table( ( *cut )->func_id ), res.size() );
       const auto supp = cuts.compute_truth_table_support( *cut, res );
       kitty::expand_inplace( tt[i], supp );
       ++i;
@@ -371,11 +728,11 @@ private:
           *it_leaves++ = leaves_before[*it_support++];
         }
         res.set_leaves( leaves_after.begin(), leaves_after.end() );
-        return cuts._truth_tables.insert( tt_res_shrink );
+        return cuts.insert_truth_table( tt_res_shrink );
       }
     }
 
-    return cuts._truth_tables.insert( tt_res );
+    return cuts.insert_truth_table( tt_res );
   }
 
   void merge_cuts2( uint32_t index )
@@ -395,7 +752,7 @@ private:
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
+    total_tuples += pairs;
     for ( auto const& c1 : *lcuts[0] )
     {
       for ( auto const& c2 : *lcuts[1] )
@@ -404,161 +761,761 @@ private:
         {
           continue;
         }
+        ++st.num_merged;
+
+        if constexpr ( priority )
+        {
+          vcuts[0] = c1;
+          vcuts[1] = c2;
+          insert_priority_cut( index, vcuts, new_cut );
+          continue;
+        }
 
         if ( rcuts.is_dominated( new_cut ) )
         {
+          ++st.num_dominated;
           continue;
         }
 
-        if constexpr ( ComputeTruth )
-        {
-          vcuts[0] = c1;
-          vcuts[1] = c2;
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
-        }
+        if constexpr ( ComputeTruth )
+        {
+          vcuts[0] = c1;
+          vcuts[1] = c2;
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+        }
+
+        cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
+
+        rcuts.insert( new_cut );
+      }
+    }
+
+    if constexpr ( priority )
+    {
+      pcuts.move_to( rcuts );
+    }
+
+    /* limit the maximum number of cuts */
+    rcuts.limit( ps.cut_limit - 1 );
+
+    total_cuts += rcuts.size();
+
+    if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
+    {
+      cuts.add_unit_cut( index );
+    }
+  }
+
+  void merge_cuts( uint32_t index )
+  {
+    uint32_t pairs{ 1 };
+    std::vector<uint32_t> cut_sizes;
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
+      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
+      cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
+      pairs *= cut_sizes.back();
+    } );
+
+    const auto fanin = cut_sizes.size();
+    lcuts[fanin] = &cuts.cuts( index );
+
+    auto& rcuts = *lcuts[fanin];
+
+    if ( fanin > 1 && fanin <= ps.fanin_limit )
+    {
+      rcuts.clear();
+
+      cut_t new_cut, tmp_cut;
+
+      std::vector<cut_t const*> vcuts( fanin );
+
+      total_tuples += pairs;
+      foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
+        auto it = vcuts.begin();
+        auto i = 0u;
+        while ( begin != end )
+        {
+          *it++ = &( ( *lcuts[i++] )[*begin++] );
+        }
+
+        if ( !vcuts[0]->merge( *vcuts[1], new_cut, ps.cut_size ) )
+        {
+          return true; /* continue */
+        }
+
+        for ( i = 2; i < fanin; ++i )
+        {
+          tmp_cut = new_cut;
+          if ( !vcuts[i]->merge( tmp_cut, new_cut, ps.cut_size ) )
+          {
+            return true; /* continue */
+          }
+        }
+        ++st.num_merged;
+
+        if constexpr ( priority )
+        {
+          insert_priority_cut( index, vcuts, new_cut );
+          return true; /* continue */
+        }
+
+        if ( rcuts.is_dominated( new_cut ) )
+        {
+          ++st.num_dominated;
+          return true; /* continue */
+        }
+
+        if constexpr ( ComputeTruth )
+        {
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+        }
+
+        cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
+
+        rcuts.insert( new_cut );
+
+        return true;
+      } );
+
+      if constexpr ( priority )
+      {
+        pcuts.move_to( rcuts );
+      }
+
+      /* limit the maximum number of cuts */
+      rcuts.limit( ps.cut_limit - 1 );
+    }
+    else if ( fanin == 1 )
+    {
+      rcuts.clear();
+
+      for ( auto const& cut : *lcuts[0] )
+      {
+        cut_t new_cut = *cut;
+
+        if constexpr ( priority )
+        {
+          insert_priority_cut( index, { cut }, new_cut );
+          continue;
+        }
+
+        if constexpr ( ComputeTruth )
+        {
+          new_cut->func_id = compute_truth_table( index, { cut }, new_cut );
+        }
+
+        cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
+
+        rcuts.insert( new_cut );
+      }
+
+      if constexpr ( priority )
+      {
+        pcuts.move_to( rcuts );
+      }
+
+      /* limit the maximum number of cuts */
+      rcuts.limit( ps.cut_limit - 1 );
+    }
+
+    total_cuts += static_cast<uint32_t>( rcuts.size() );
+
+    cuts.add_unit_cut( index );
+  }
+
+  /* Keeps a merged cut if it is among the best cuts of the node.  The cost
+   * only depends on the leaves, such that cuts that cannot beat the worst
+   * cut are discarded before their truth table and data are computed. */
+  void insert_priority_cut( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& new_cut )
+  {
+    auto const limit = ps.cut_limit - 1;
+    auto const cost = pcuts.cost( std::as_const( new_cut ), std::as_const( cuts ) );
+    if ( pcuts.is_pruned( cost, new_cut, limit ) )
+    {
+      ++st.num_pruned;
+      return;
+    }
+    if ( pcuts.is_dominated( new_cut ) )
+    {
+      ++st.num_dominated;
+      return;
+    }
+
+    if constexpr ( ComputeTruth )
+    {
+      new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+    }
+    else
+    {
+      (void)vcuts;
+    }
+
+    cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
+
+    pcuts.insert( cost, new_cut, limit );
+  }
+
+private:
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData>
+  friend struct mockturtle::lazy_network_cuts;
+
+  Ntk const& ntk;
+  cut_enumeration_params const& ps;
+  cut_enumeration_stats& st;
+  NetworkCuts& cuts;
+
+  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  priority_cuts<CutCost, cut_t, NetworkCuts> pcuts;
+
+  uint32_t total_tuples{};
+  std::size_t total_cuts{};
+};
+} /* namespace detail */
+/*! \endcond */
+
+/*! \brief Cut enumeration.
+ *
+ * This function implements the cut enumeration algorithm.  The algorithm
+ * traverses all nodes in topological order and computes a node's cuts based
+ * on its fanins' cuts.  Dominated cuts are filtered and are not added to the
+ * cut set.  For each node a unit cut is added to the end of each cut set.
+ *
+ * The template parameter `ComputeTruth` controls whether truth tables should
+ * be computed for each cut.  Computing truth tables slows down the execution
+ * time of the algorithm.
+ *
+ * The number of computed cuts is controlled via the `cut_limit` parameter.
+ * To decide which cuts are collected in each node's cut set, cuts are sorted.
+ * Unit cuts do not participate in the sorting and are always added to the end
+ * of each cut set.
+ *
+ * The algorithm can be configured by specifying the template argument `CutData`
+ * which holds the application specific data assigned to each cut.  Examples
+ * on how to specify custom cost functions for sorting cuts based on the
+ * application specific cut data can be found in the files contained in the
+ * directory `include/mockturtle/algorithms/cut_enumeration`.
+ *
+ * **Required network functions:**
+ * - `is_constant`
+ * - `is_ci`
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `foreach_node`
+ * - `foreach_fanin`
+ * - `compute` for `kitty::dynamic_truth_table` (if `ComputeTruth` is true)
+ *
+   \verbatim embed:rst
+
+   .. warning::
+
+      This algorithm expects the nodes in the network to be in topological
+      order.  If the network does not guarantee a topological order of nodes
+      one can wrap the network parameter in a ``topo_view`` view.
+
+   .. note::
+
+      The implementation of this algorithm was heavily inspired buy cut
+      enumeration implementations in ABC.
+   \endverbatim
+ */
+template<typename Ntk, bool ComputeTruth, typename CutData>
+network_cuts<Ntk, ComputeTruth, CutData> cut_enumeration( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats* pst )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( !ComputeTruth || has_compute_v<Ntk, kitty::dynamic_truth_table>, "Ntk does not implement the compute method for kitty::dynamic_truth_table" );
+
+  cut_enumeration_stats st;
+  network_cuts<Ntk, ComputeTruth, CutData> res( ntk.size() );
+  detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData> p( ntk, ps, st, res );
+  p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return res;
+}
+
+/*! \brief Priority-cut enumeration.
+ *
+ * This function runs `cut_enumeration` in priority-cuts mode: the cut set of
+ * each node keeps the `cut_limit - 1` best cuts with respect to a cost,
+ * followed by the unit cut.  The cost of a merged cut is computed by
+ * `cost( cut, cuts )`, where `cut` holds the leaves of the cut, and `cuts`
+ * is the cut database, in which the cut sets of the leaves are available.
+ * The cost must not depend on the truth table and the data of `cut`, which
+ * are not computed yet.  It can be of any type that is ordered by `<`;
+ * smaller is better, and ties are broken by the number of leaves.
+ *
+ * A merged cut whose cost is not smaller than the one of the worst cut of a
+ * full cut set is discarded before its truth table and data are computed.
+ * The numbers of merged, dominated, and discarded cuts are reported in
+ * `cut_enumeration_stats`.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      // area flow, using the best cuts of the leaves
+      auto const area_flow = [&]( auto const& cut, auto const& cuts ) {
+        float flow = 1.0f;
+        for ( auto leaf : cut )
+        {
+          flow += cuts.cuts( leaf )[0]->data.flow;
+        }
+        return flow;
+      };
+
+      cut_enumeration_params ps;
+      ps.cut_limit = 8;
+      auto cuts = priority_cut_enumeration<aig_network, true, cut_enumeration_mf_cut>( aig, area_flow, ps );
+   \endverbatim
+ */
+template<typename Ntk, bool ComputeTruth, typename CutData, typename CutCost>
+network_cuts<Ntk, ComputeTruth, CutData> priority_cut_enumeration( Ntk const& ntk, CutCost const& cost, cut_enumeration_params const& ps, cut_enumeration_stats* pst )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( !ComputeTruth || has_compute_v<Ntk, kitty::dynamic_truth_table>, "Ntk does not implement the compute method for kitty::dynamic_truth_table" );
+
+  using cut_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_t;
+  static_assert( std::is_invocable_v<CutCost const&, cut_t const&, network_cuts<Ntk, ComputeTruth, CutData> const&>, "CutCost cannot be called with a cut and the cut database" );
+
+  cut_enumeration_stats st;
+  network_cuts<Ntk, ComputeTruth, CutData> res( ntk.size() );
+  detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData, network_cuts<Ntk, ComputeTruth, CutData>, CutCost> p( ntk, ps, st, res, cost );
+  p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return res;
+}
+
+/*! \brief Cut database that computes cuts on demand.
+ *
+ * Contrary to `network_cuts`, which stores the cuts of all nodes,
+ * `lazy_network_cuts` computes the cuts of a node when they are first
+ * requested with `cuts` and keeps at most `capacity` cut sets in memory.
+ * When the capacity is reached, the least recently used cut set is evicted.
+ * It is recomputed from the cuts of the fanins when it is requested again,
+ * which gives the same cuts and truth table literals as before.
+ *
+ * A reference returned by `cuts` is valid until the next call to `cuts`.
+ * The cut sets of the fanins of the nodes being computed are not evicted,
+ * such that the capacity can be exceeded temporarily.  Modifications of
+ * the cut data are lost on eviction.  The network must not be modified
+ * while the cut database is used.
+ *
+ * The capacity only bounds the memory used for cuts.  If `ComputeTruth` is
+ * true, the truth tables of all cuts that have been computed are kept in a
+ * cache that is never evicted, such that recomputed cuts refer to the same
+ * truth table literals.  The cache grows with the number of distinct cut
+ * functions, which is usually much smaller than the number of cuts.
+ *
+ * An instance of type `lazy_network_cuts` is created with
+ * `lazy_cut_enumeration`.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      auto cuts = lazy_cut_enumeration<aig_network, true>( aig, 10000u, ps );
+      aig.foreach_gate( [&]( auto const& n ) {
+        for ( auto const& cut : cuts.cuts( aig.node_to_index( n ) ) )
+        {
+          auto const tt = cuts.truth_table( *cut );
+          // ...
+        }
+      } );
+   \endverbatim
+ */
+template<typename Ntk, bool ComputeTruth, typename CutData>
+struct lazy_network_cuts
+{
+public:
+  static constexpr uint32_t max_cut_num = network_cuts<Ntk, ComputeTruth, CutData>::max_cut_num;
+  using cut_t = cut_type<ComputeTruth, CutData>;
+  using cut_set_t = cut_set<cut_t, max_cut_num>;
+  static constexpr bool compute_truth = ComputeTruth;
+
+public:
+  explicit lazy_network_cuts( Ntk const& ntk, uint32_t capacity, cut_enumeration_params const& ps )
+      : _ntk( ntk ),
+        _ps( ps ),
+        _capacity( std::max( capacity, 1u ) ),
+        _slot_of( ntk.size(), none ),
+        _computed( ntk.size(), false )
+  {
+    assert( ps.cut_limit < max_cut_num && "cut_limit exceeds the compile-time limit for the maximum number of cuts" );
+
+    kitty::dynamic_truth_table zero( 0u ), proj( 1u );
+    kitty::create_nth_var( proj, 0u );
+
+    _truth_tables.insert( zero );
+    _truth_tables.insert( proj );
+  }
+
+public:
+  /*! \brief Returns the cut set of a node, computing it if needed */
+  cut_set_t& cuts( uint32_t node_index )
+  {
+    assert( node_index < _slot_of.size() );
+    if ( auto const slot = _slot_of[node_index]; slot != none )
+    {
+      touch( slot );
+      return _slots[slot];
+    }
+
+    if ( _busy )
+    {
+      /* requested while computing other cuts, e.g., by the cut data */
+      compute( node_index );
+    }
+    else
+    {
+      _busy = true;
+      {
+        stopwatch t( _st.time_total );
+        compute( node_index );
+      }
+      _busy = false;
+    }
+    return _slots[_slot_of[node_index]];
+  }
+
+  /*! \brief Returns the cut set of a node, computing it if needed
+   *
+   * Computing cut sets does not change the cuts of any node.
+   */
+  cut_set_t const& cuts( uint32_t node_index ) const
+  {
+    return const_cast<lazy_network_cuts*>( this )->cuts( node_index );
+  }
+
+  /*! \brief Returns the truth table of a cut */
+  template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
+  auto truth_table( cut_t const& cut ) const
+  {
+    kitty::dynamic_truth_table tt;
+    tt = _truth_tables[cut->func_id];
+    return tt;
+  }
 
-        cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
+  /*! \brief Returns a view on the truth table of a cut
+   *
+   * The view points into the truth table cache and is valid until the next
+   * cut set is computed.
+   */
+  template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
+  truth_table_view truth_table_ref( cut_t const& cut ) const
+  {
+    return _truth_tables[cut->func_id];
+  }
 
-        rcuts.insert( new_cut );
-      }
-    }
+  /*! \brief Returns the total number of tuples that were tried to be merged */
+  auto total_tuples() const
+  {
+    return _total_tuples;
+  }
 
-    /* limit the maximum number of cuts */
-    rcuts.limit( ps.cut_limit - 1 );
+  /*! \brief Returns the total number of cuts computed, including recomputations. */
+  auto total_cuts() const
+  {
+    return _total_cuts;
+  }
 
-    cuts._total_cuts += rcuts.size();
+  /*! \brief Returns the number of nodes for which cuts can be requested */
+  auto nodes_size() const
+  {
+    return _slot_of.size();
+  }
 
-    if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
-    {
-      cuts.add_unit_cut( index );
-    }
+  /*! \brief Returns the number of cut sets in memory */
+  auto num_cut_sets() const
+  {
+    return _slots.size();
   }
 
-  void merge_cuts( uint32_t index )
+  /*! \brief Returns the number of evicted cut sets */
+  auto num_evictions() const
   {
-    uint32_t pairs{ 1 };
-    std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
-      cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
-      pairs *= cut_sizes.back();
-    } );
+    return _num_evictions;
+  }
 
-    const auto fanin = cut_sizes.size();
-    lcuts[fanin] = &cuts.cuts( index );
+  /*! \brief Returns the number of cut sets computed again after eviction */
+  auto num_recomputations() const
+  {
+    return _num_recomputations;
+  }
 
-    auto& rcuts = *lcuts[fanin];
+  /*! \brief Returns the statistics of the cut computations */
+  cut_enumeration_stats const& stats() const
+  {
+    return _st;
+  }
 
-    if ( fanin > 1 && fanin <= ps.fanin_limit )
+  /* compute positions of leave indices in cut `sub` (subset) with respect to
+   * leaves in cut `sup` (super set). */
+  std::vector<uint8_t> compute_truth_table_support( cut_t const& sub, cut_t const& sup ) const
+  {
+    std::vector<uint8_t> support;
+    support.reserve( sub.size() );
+
+    auto itp = sup.begin();
+    for ( auto i : sub )
     {
-      rcuts.clear();
+      itp = std::find( itp, sup.end(), i );
+      support.push_back( static_cast<uint8_t>( std::distance( sup.begin(), itp ) ) );
+    }
 
-      cut_t new_cut, tmp_cut;
+    return support;
+  }
 
-      std::vector<cut_t const*> vcuts( fanin );
+  /*! \brief Inserts a truth table into the truth table cache.
+   *
+   * \param tt Truth table to add
+   * \return Literal id from the truth table store
+   */
+  uint32_t insert_truth_table( kitty::dynamic_truth_table const& tt )
+  {
+    return _truth_tables.insert( tt );
+  }
 
-      cuts._total_tuples += pairs;
-      foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
-        auto it = vcuts.begin();
-        auto i = 0u;
-        while ( begin != end )
-        {
-          *it++ = &( ( *lcuts[i++] )[*begin++] );
-        }
+private:
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData, typename _NetworkCuts, typename _CutCost>
+  friend class detail::cut_enumeration_impl;
 
-        if ( !vcuts[0]->merge( *vcuts[1], new_cut, ps.cut_size ) )
-        {
-          return true; /* continue */
-        }
+  using enumeration_impl = detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData, lazy_network_cuts>;
 
-        for ( i = 2; i < fanin; ++i )
+  static constexpr uint32_t none = UINT32_MAX;
+
+private:
+  /* Computes the cuts of `root` and of the missing cut sets in its
+   * transitive fanin, depth-first.  Each fanin of an expanded node is
+   * pinned once, either when the node is expanded or when the fanin is
+   * computed, and unpinned after the node is computed. */
+  void compute( uint32_t root )
+  {
+    std::vector<std::pair<uint32_t, bool>> stack{ { root, false } };
+    while ( !stack.empty() )
+    {
+      auto const [index, expanded] = stack.back();
+      auto const n = _ntk.index_to_node( index );
+
+      if ( !expanded )
+      {
+        if ( auto const slot = _slot_of[index]; slot != none )
         {
-          tmp_cut = new_cut;
-          if ( !vcuts[i]->merge( tmp_cut, new_cut, ps.cut_size ) )
+          stack.pop_back();
+          if ( !stack.empty() )
           {
-            return true; /* continue */
+            ++_pins[slot];
           }
+          continue;
         }
 
-        if ( rcuts.is_dominated( new_cut ) )
+        stack.back().second = true;
+        if ( !_ntk.is_constant( n ) && !_ntk.is_ci( n ) )
         {
-          return true; /* continue */
+          _ntk.foreach_fanin( n, [&]( auto const& f ) {
+            auto const fanin = _ntk.node_to_index( _ntk.get_node( f ) );
+            if ( auto const slot = _slot_of[fanin]; slot != none )
+            {
+              ++_pins[slot];
+            }
+            else
+            {
+              stack.emplace_back( fanin, false );
+            }
+          } );
         }
+        continue;
+      }
 
-        if constexpr ( ComputeTruth )
-        {
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
-        }
+      /* all fanins are available */
+      auto const slot = allocate( index );
+      ++_pins[slot];
+      enumeration_impl impl( _ntk, _ps, _st, *this );
+      impl.compute_cuts( index );
+      _total_tuples += impl.total_tuples;
+      _total_cuts += impl.total_cuts;
+      --_pins[slot];
 
-        cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
+      if ( _computed[index] )
+      {
+        ++_num_recomputations;
+      }
+      _computed[index] = true;
 
-        rcuts.insert( new_cut );
+      if ( !_ntk.is_constant( n ) && !_ntk.is_ci( n ) )
+      {
+        _ntk.foreach_fanin( n, [&]( auto const& f ) {
+          --_pins[_slot_of[_ntk.node_to_index( _ntk.get_node( f ) )]];
+        } );
+      }
 
-        return true;
-      } );
+      stack.pop_back();
+      if ( !stack.empty() )
+      {
+        ++_pins[slot];
+      }
+    }
+  }
 
-      /* limit the maximum number of cuts */
-      rcuts.limit( ps.cut_limit - 1 );
+  /* returns an empty slot for the cut set of `index`, evicting the least
+   * recently used cut set that is not pinned if the capacity is reached */
+  uint32_t allocate( uint32_t index )
+  {
+    auto slot = _tail;
+    if ( _slots.size() < _capacity )
+    {
+      slot = none;
     }
-    else if ( fanin == 1 )
+    while ( slot != none && _pins[slot] > 0u )
     {
-      rcuts.clear();
+      slot = _prev[slot];
+    }
 
-      for ( auto const& cut : *lcuts[0] )
-      {
-        cut_t new_cut = *cut;
+    if ( slot == none )
+    {
+      slot = static_cast<uint32_t>( _slots.size() );
+      _slots.emplace_back();
+      _pins.emplace_back( 0u );
+      _owner.emplace_back( none );
+      _prev.emplace_back( none );
+      _next.emplace_back( none );
+    }
+    else
+    {
+      _slot_of[_owner[slot]] = none;
+      unlink( slot );
+      ++_num_evictions;
+    }
 
-        if constexpr ( ComputeTruth )
-        {
-          new_cut->func_id = compute_truth_table( index, { cut }, new_cut );
-        }
+    _owner[slot] = index;
+    _slot_of[index] = slot;
+    _slots[slot].clear();
+    link_front( slot );
+    return slot;
+  }
 
-        cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
+  void touch( uint32_t slot )
+  {
+    if ( slot != _head )
+    {
+      unlink( slot );
+      link_front( slot );
+    }
+  }
 
-        rcuts.insert( new_cut );
-      }
+  void unlink( uint32_t slot )
+  {
+    ( _prev[slot] == none ? _head : _next[_prev[slot]] ) = _next[slot];
+    ( _next[slot] == none ? _tail : _prev[_next[slot]] ) = _prev[slot];
+  }
 
-      /* limit the maximum number of cuts */
-      rcuts.limit( ps.cut_limit - 1 );
+  void link_front( uint32_t slot )
+  {
+    _prev[slot] = none;
+    _next[slot] = _head;
+    ( _head == none ? _tail : _prev[_head] ) = slot;
+    _head = slot;
+  }
+
+  void add_zero_cut( uint32_t index )
+  {
+    auto& cut = _slots[_slot_of[index]].add_cut( &index, &index ); /* fake iterator for emptyness */
+    cut->data = CutData{}; /* the slot may hold the data of an evicted cut */
+
+    if constexpr ( ComputeTruth )
+    {
+      cut->func_id = 0;
     }
+  }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+  void add_unit_cut( uint32_t index )
+  {
+    auto& cut = _slots[_slot_of[index]].add_cut( &index, &index + 1 );
+    cut->data = CutData{};
 
-    cuts.add_unit_cut( index );
+    if constexpr ( ComputeTruth )
+    {
+      cut->func_id = 2;
+    }
+  }
+
+  truth_table_view lookup_truth_table( uint32_t lit ) const
+  {
+    return _truth_tables[lit];
   }
 
 private:
-  Ntk const& ntk;
-  cut_enumeration_params const& ps;
-  cut_enumeration_stats& st;
-  network_cuts<Ntk, ComputeTruth, CutData>& cuts;
+  Ntk const& _ntk;
+  cut_enumeration_params const _ps;
+  cut_enumeration_stats _st;
+  uint32_t const _capacity;
+
+  /* cut sets in memory, a deque keeps them in place when it grows */
+  std::deque<cut_set_t> _slots;
+  std::vector<uint32_t> _pins;
+  std::vector<uint32_t> _owner;
+
+  /* least recently used list of the slots */
+  std::vector<uint32_t> _prev;
+  std::vector<uint32_t> _next;
+  uint32_t _head{ none };
+  uint32_t _tail{ none };
+
+  std::vector<uint32_t> _slot_of;
+  std::vector<bool> _computed;
+  bool _busy{ false };
 
-  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  /* cut truth tables */
+  truth_table_arena_cache<kitty::dynamic_truth_table> _truth_tables;
+
+  /* statistics */
+  uint32_t _total_tuples{};
+  std::size_t _total_cuts{};
+  uint64_t _num_evictions{};
+  uint64_t _num_recomputations{};
 };
-} /* namespace detail */
-/*! \endcond */
 
-/*! \brief Cut enumeration.
+/*! \brief Lazy cut enumeration.
  *
- * This function implements the cut enumeration algorithm.  The algorithm
- * traverses all nodes in topological order and computes a node's cuts based
- * on its fanins' cuts.  Dominated cuts are filtered and are not added to the
- * cut set.  For each node a unit cut is added to the end of each cut set.
- *
- * The template parameter `ComputeTruth` controls whether truth tables should
- * be computed for each cut.  Computing truth tables slows down the execution
- * time of the algorithm.
- *
- * The number of computed cuts is controlled via the `cut_limit` parameter.
- * To decide which cuts are collected in each node's cut set, cuts are sorted.
- * Unit cuts do not participate in the sorting and are always added to the end
- * of each cut set.
- *
- * The algorithm can be configured by specifying the template argument `CutData`
- * which holds the application specific data assigned to each cut.  Examples
- * on how to specify custom cost functions for sorting cuts based on the
- * application specific cut data can be found in the files contained in the
- * directory `include/mockturtle/algorithms/cut_enumeration`.
+ * Returns a cut database in which the cuts of a node are computed when they
+ * are first requested, using the same algorithm as `cut_enumeration`.  At
+ * most `capacity` cut sets are kept in memory (see `lazy_network_cuts`).
+ * The parameter `num_threads` is ignored.
  *
  * **Required network functions:**
  * - `is_constant`
@@ -566,52 +1523,28 @@ private:
  * - `size`
  * - `get_node`
  * - `node_to_index`
- * - `foreach_node`
+ * - `index_to_node`
  * - `foreach_fanin`
  * - `compute` for `kitty::dynamic_truth_table` (if `ComputeTruth` is true)
  *
-   \verbatim embed:rst
-
-   .. warning::
-
-      This algorithm expects the nodes in the network to be in topological
-      order.  If the network does not guarantee a topological order of nodes
-      one can wrap the network parameter in a ``topo_view`` view.
-
-   .. note::
-
-      The implementation of this algorithm was heavily inspired buy cut
-      enumeration implementations in ABC.
-   \endverbatim
+ * \param ntk Network
+ * \param capacity Maximum number of cut sets in memory
+ * \param ps Cut enumeration parameters
  */
-template<typename Ntk, bool ComputeTruth, typename CutData>
-network_cuts<Ntk, ComputeTruth, CutData> cut_enumeration( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats* pst )
+template<typename Ntk, bool ComputeTruth = false, typename CutData = empty_cut_data>
+lazy_network_cuts<Ntk, ComputeTruth, CutData> lazy_cut_enumeration( Ntk const& ntk, uint32_t capacity, cut_enumeration_params const& ps = {} )
 {
   static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
   static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
   static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
   static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
   static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
-  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
   static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
   static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
   static_assert( !ComputeTruth || has_compute_v<Ntk, kitty::dynamic_truth_table>, "Ntk does not implement the compute method for kitty::dynamic_truth_table" );
 
-  cut_enumeration_stats st;
-  network_cuts<Ntk, ComputeTruth, CutData> res( ntk.size() );
-  detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData> p( ntk, ps, st, res );
-  p.run();
-
-  if ( ps.verbose )
-  {
-    st.report();
-  }
-  if ( pst )
-  {
-    *pst = st;
-  }
-
-  return res;
+  return lazy_network_cuts<Ntk, ComputeTruth, CutData>( ntk, capacity, ps );
 }
 
 /* forward declarations */
@@ -670,6 +1603,17 @@ public:
   /*! \brief Returns the truth table of a cut */
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
+  {
+    return _truth_tables.copy( cut->func_id );
+  }
+
+  /*! \brief Returns a view on the truth table of a cut
+   *
+   * The view points into the truth table cache and is valid until the next
+   * truth table is inserted.
+   */
+  template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
+  truth_table_view truth_table_ref( cut_t const& cut ) const
   {
     return _truth_tables[cut->func_id];
   }
@@ -759,7 +1703,7 @@ private:
   std::vector<cut_set_t> _cuts;
 
   /* cut truth tables */
-  truth_table_cache<kitty::static_truth_table<NumVars>> _truth_tables;
+  truth_table_arena_cache<kitty::static_truth_table<NumVars>> _truth_tables;
 
   /* statistics */
   uint32_t _total_tuples{};
@@ -830,7 +1774,8 @@ private:
     auto i = 0;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = cuts._truth_tables[( *cut )->func_id];
+      auto const fanin_tt = cuts._truth_tables[( *cut )->func_id];
+      std::copy( fanin_tt.cbegin(), fanin_tt.cend(), tt[i].begin() );
       const auto supp = cuts.compute_truth_table_support( *cut, res );
       kitty::expand_inplace( tt[i], supp );
       ++i;
@@ -1164,6 +2109,17 @@ public:
   /*! \brief Returns the truth table of a cut */
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
+  {
+    return _truth_tables.copy( cut->func_id );
+  }
+
+  /*! \brief Returns a view on the truth table of a cut
+   *
+   * The view points into the truth table cache and is valid until the next
+   * truth table is inserted.
+   */
+  template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
+  truth_table_view truth_table_ref( cut_t const& cut ) const
   {
     return _truth_tables[cut->func_id];
   }
@@ -1255,7 +2211,7 @@ private:
   std::deque<cut_set_t> _cuts;
 
   /* cut truth tables */
-  truth_table_cache<kitty::static_truth_table<NumVars>> _truth_tables;
+  truth_table_arena_cache<kitty::static_truth_table<NumVars>> _truth_tables;
 
   /* statistics */
   uint32_t _total_tuples{};
@@ -1394,7 +2350,8 @@ private:
     auto i = 0;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = cuts._truth_tables[( *cut )->func_id];
+      auto const fanin_tt = cuts._truth_tables[( *cut )->func_id];
+      std::copy( fanin_tt.cbegin(), fanin_tt.cend(), tt[i].begin() );
       const auto supp = cuts.compute_truth_table_support( *cut, res );
       kitty::expand_inplace( tt[i], supp );
       ++i;
@@ -95,6 +95,16 @@ struct cut_rewriting_params
   /*! \brief Minimum candidate cut size */
   uint32_t min_cand_cut_size{ 3u };
 
+  /*! \brief Maximum number of cut sets in memory.
+   *
+   * If nonzero, cuts are computed on demand and only the most recently used
+   * cut sets are kept in memory (see `lazy_cut_enumeration`).  This does not
+   * bound the memory of the truth tables of the cuts, which are all kept.
+   * Only used by `cut_rewriting`, not by
+   * `cut_rewriting_with_compatibility_graph`.
+   */
+  uint32_t max_cut_sets{ 0u };
+
   /*! \brief Minimum candidate cut size override (in conflict graph) */
   std::optional<uint32_t> min_cand_cut_size_override{};
 
@@ -705,8 +715,22 @@ struct cut_rewriting_impl
     } );
 
     /* enumerate cuts */
+    if ( ps_.max_cut_sets > 0u )
+    {
+      auto cuts = lazy_cut_enumeration<Ntk, true, cut_enumeration_cut_rewriting_cut>( ntk_, ps_.max_cut_sets, ps_.cut_enumeration_ps );
+      auto ret = rewrite( cuts, old2new, res );
+      st_.time_cuts += cuts.stats().time_total;
+      return ret;
+    }
+
     const auto cuts = call_with_stopwatch( st_.time_cuts, [&]() { return cut_enumeration<Ntk, true, cut_enumeration_cut_rewriting_cut>( ntk_, ps_.cut_enumeration_ps ); } );
+    return rewrite( cuts, old2new, res );
+  }
 
+private:
+  template<class NetworkCuts>
+  NtkDest rewrite( NetworkCuts& cuts, node_map<signal<Ntk>, Ntk>& old2new, Ntk& res )
+  {
     /* for cost estimation we use reference counters initialized by the fanout size */
     initialize_values_with_fanout( ntk_ );
 
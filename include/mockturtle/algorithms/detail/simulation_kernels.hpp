@@ -0,0 +1,450 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file simulation_kernels.hpp
+  \brief Word-parallel gate kernels with AVX2 and AVX-512 variants
+
+  \author Heinz Riener
+  \author Mathias Soeken
+  \author Siang-Yun (Sonia) Lee
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define MOCKTURTLE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Instruction set used to evaluate simulation kernels.
+ *
+ * `automatic` selects the widest instruction set supported by the CPU at
+ * run-time.  Requesting an instruction set that is not supported falls back
+ * to the widest supported one.
+ */
+enum class simd_backend : uint8_t
+{
+  automatic,
+  scalar,
+  avx2,
+  avx512
+};
+
+namespace detail
+{
+
+/*! \brief Number of 64-bit words in an AVX-512 register.
+ *
+ * Kernels accept any number of words and unaligned buffers, but process
+ * whole registers fastest from buffers aligned to `8 * simd_words` bytes.
+ */
+inline constexpr uint32_t simd_words = 8u;
+
+/* allocator for buffers aligned to whole AVX-512 registers */
+template<class T, std::size_t Alignment = 64u>
+struct aligned_allocator
+{
+  using value_type = T;
+
+  template<class U>
+  struct rebind
+  {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() noexcept = default;
+
+  template<class U>
+  aligned_allocator( aligned_allocator<U, Alignment> const& ) noexcept
+  {}
+
+  T* allocate( std::size_t n )
+  {
+    if ( n > std::numeric_limits<std::size_t>::max() / sizeof( T ) )
+    {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>( ::operator new( n * sizeof( T ), std::align_val_t( Alignment ) ) );
+  }
+
+  void deallocate( T* p, std::size_t ) noexcept
+  {
+    ::operator delete( p, std::align_val_t( Alignment ) );
+  }
+
+  template<class U>
+  bool operator==( aligned_allocator<U, Alignment> const& ) const noexcept
+  {
+    return true;
+  }
+
+  template<class U>
+  bool operator!=( aligned_allocator<U, Alignment> const& ) const noexcept
+  {
+    return false;
+  }
+};
+
+/*! \brief Widest instruction set supported by the CPU. */
+inline simd_backend detect_simd_backend()
+{
+  static simd_backend const backend = []() {
+#if defined( MOCKTURTLE_X86_SIMD )
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports( "avx512f" ) )
+    {
+      return simd_backend::avx512;
+    }
+    if ( __builtin_cpu_supports( "avx2" ) )
+    {
+      return simd_backend::avx2;
+    }
+#endif
+    return simd_backend::scalar;
+  }();
+  return backend;
+}
+
+/*! \brief Replaces `automatic` and unsupported instruction sets by the widest supported one. */
+inline simd_backend resolve_simd_backend( simd_backend backend )
+{
+  auto const supported = detect_simd_backend();
+  if ( backend == simd_backend::automatic || static_cast<uint8_t>( backend ) > static_cast<uint8_t>( supported ) )
+  {
+    return supported;
+  }
+  return backend;
+}
+
+/* `mask( complements, i )` is all ones if bit `i` is set */
+inline uint64_t complement_mask( uint32_t complements, uint32_t i )
+{
+  return UINT64_C( 0 ) - ( ( complements >> i ) & 1u );
+}
+
+/*! \brief Gate kernels over `num_words` words.
+ *
+ * Every fan-in `x` comes with a mask `cx` that is XOR-ed into its words to
+ * complement it.  The vectorized variants evaluate the words that do not
+ * fill a whole register with the scalar kernels.  `lut` evaluates the sum of products of `num_minterms`
+ * minterms over `num_inputs` inputs and XORs the result with `result_mask`.
+ */
+template<simd_backend Backend>
+struct simulation_kernels
+{
+  static void and2( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint32_t num_words )
+  {
+    for ( auto w = 0u; w < num_words; ++w )
+    {
+      out[w] = ( a[w] ^ ca ) & ( b[w] ^ cb );
+    }
+  }
+
+  static void xor2( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t c, uint32_t num_words )
+  {
+    for ( auto w = 0u; w < num_words; ++w )
+    {
+      out[w] = a[w] ^ b[w] ^ c;
+    }
+  }
+
+  static void maj3( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t const* c, uint64_t cc, uint32_t num_words )
+  {
+    for ( auto w = 0u; w < num_words; ++w )
+    {
+      auto const x = a[w] ^ ca, y = b[w] ^ cb, z = c[w] ^ cc;
+      out[w] = ( x & ( y | z ) ) | ( y & z );
+    }
+  }
+
+  static void xor3( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t const* c, uint64_t cc, uint32_t num_words )
+  {
+    for ( auto w = 0u; w < num_words; ++w )
+    {
+      out[w] = a[w] ^ b[w] ^ c[w] ^ cc;
+    }
+  }
+
+  /* `s ? t : e` */
+  static void mux( uint64_t* out, uint64_t const* s, uint64_t cs, uint64_t const* t, uint64_t ct, uint64_t const* e, uint64_t ce, uint32_t num_words )
+  {
+    for ( auto w = 0u; w < num_words; ++w )
+    {
+      auto const x = s[w] ^ cs;
+      out[w] = ( x & ( t[w] ^ ct ) ) | ( ~x & ( e[w] ^ ce ) );
+    }
+  }
+
+  static void lut( uint64_t* out, uint64_t const* const* inputs, uint64_t const* masks, uint32_t num_inputs, uint32_t const* minterms, uint32_t num_minterms, uint64_t result_mask, uint32_t num_words )
+  {
+    lut_from( 0u, out, inputs, masks, num_inputs, minterms, num_minterms, result_mask, num_words );
+  }
+
+  /* evaluates words `first`, ..., `num_words - 1` */
+  static void lut_from( uint32_t first, uint64_t* out, uint64_t const* const* inputs, uint64_t const* masks, uint32_t num_inputs, uint32_t const* minterms, uint32_t num_minterms, uint64_t result_mask, uint32_t num_words )
+  {
+    for ( auto w = first; w < num_words; ++w )
+    {
+      uint64_t result{ 0u };
+      for ( auto m = 0u; m < num_minterms; ++m )
+      {
+        uint64_t term = ~UINT64_C( 0 );
+        for ( auto j = 0u; j < num_inputs; ++j )
+        {
+          /* literal is the input if bit j of the minterm is set */
+          term &= inputs[j][w] ^ masks[j] ^ complement_mask( ~minterms[m], j );
+        }
+        result |= term;
+      }
+      out[w] = result ^ result_mask;
+    }
+  }
+};
+
+#if defined( MOCKTURTLE_X86_SIMD )
+template<>
+struct simulation_kernels<simd_backend::avx2>
+{
+  using scalar_kernels = simulation_kernels<simd_backend::scalar>;
+
+  __attribute__( ( target( "avx2" ) ) ) static void and2( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint32_t num_words )
+  {
+    auto const va = _mm256_set1_epi64x( static_cast<long long>( ca ) );
+    auto const vb = _mm256_set1_epi64x( static_cast<long long>( cb ) );
+    auto w = 0u;
+    for ( ; w + 4u <= num_words; w += 4u )
+    {
+      auto const x = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + w ) ), va );
+      auto const y = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + w ) ), vb );
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + w ), _mm256_and_si256( x, y ) );
+    }
+    scalar_kernels::and2( out + w, a + w, ca, b + w, cb, num_words - w );
+  }
+
+  __attribute__( ( target( "avx2" ) ) ) static void xor2( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t c, uint32_t num_words )
+  {
+    auto const vc = _mm256_set1_epi64x( static_cast<long long>( c ) );
+    auto w = 0u;
+    for ( ; w + 4u <= num_words; w += 4u )
+    {
+      auto const x = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + w ) );
+      auto const y = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + w ) );
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + w ), _mm256_xor_si256( _mm256_xor_si256( x, y ), vc ) );
+    }
+    scalar_kernels::xor2( out + w, a + w, b + w, c, num_words - w );
+  }
+
+  __attribute__( ( target( "avx2" ) ) ) static void maj3( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t const* c, uint64_t cc, uint32_t num_words )
+  {
+    auto const va = _mm256_set1_epi64x( static_cast<long long>( ca ) );
+    auto const vb = _mm256_set1_epi64x( static_cast<long long>( cb ) );
+    auto const vc = _mm256_set1_epi64x( static_cast<long long>( cc ) );
+    auto w = 0u;
+    for ( ; w + 4u <= num_words; w += 4u )
+    {
+      auto const x = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + w ) ), va );
+      auto const y = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + w ) ), vb );
+      auto const z = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( c + w ) ), vc );
+      auto const r = _mm256_or_si256( _mm256_and_si256( x, _mm256_or_si256( y, z ) ), _mm256_and_si256( y, z ) );
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + w ), r );
+    }
+    scalar_kernels::maj3( out + w, a + w, ca, b + w, cb, c + w, cc, num_words - w );
+  }
+
+  __attribute__( ( target( "avx2" ) ) ) static void xor3( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t const* c, uint64_t cc, uint32_t num_words )
+  {
+    auto const vc = _mm256_set1_epi64x( static_cast<long long>( cc ) );
+    auto w = 0u;
+    for ( ; w + 4u <= num_words; w += 4u )
+    {
+      auto const x = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + w ) );
+      auto const y = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + w ) );
+      auto const z = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( c + w ) );
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + w ), _mm256_xor_si256( _mm256_xor_si256( x, y ), _mm256_xor_si256( z, vc ) ) );
+    }
+    scalar_kernels::xor3( out + w, a + w, b + w, c + w, cc, num_words - w );
+  }
+
+  __attribute__( ( target( "avx2" ) ) ) static void mux( uint64_t* out, uint64_t const* s, uint64_t cs, uint64_t const* t, uint64_t ct, uint64_t const* e, uint64_t ce, uint32_t num_words )
+  {
+    auto const vs = _mm256_set1_epi64x( static_cast<long long>( cs ) );
+    auto const vt = _mm256_set1_epi64x( static_cast<long long>( ct ) );
+    auto const ve = _mm256_set1_epi64x( static_cast<long long>( ce ) );
+    auto w = 0u;
+    for ( ; w + 4u <= num_words; w += 4u )
+    {
+      auto const x = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( s + w ) ), vs );
+      auto const y = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( t + w ) ), vt );
+      auto const z = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( e + w ) ), ve );
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + w ), _mm256_or_si256( _mm256_and_si256( x, y ), _mm256_andnot_si256( x, z ) ) );
+    }
+    scalar_kernels::mux( out + w, s + w, cs, t + w, ct, e + w, ce, num_words - w );
+  }
+
+  __attribute__( ( target( "avx2" ) ) ) static void lut( uint64_t* out, uint64_t const* const* inputs, uint64_t const* masks, uint32_t num_inputs, uint32_t const* minterms, uint32_t num_minterms, uint64_t result_mask, uint32_t num_words )
+  {
+    auto const vr = _mm256_set1_epi64x( static_cast<long long>( result_mask ) );
+    auto w = 0u;
+    for ( ; w + 4u <= num_words; w += 4u )
+    {
+      auto result = _mm256_setzero_si256();
+      for ( auto m = 0u; m < num_minterms; ++m )
+      {
+        auto term = _mm256_set1_epi64x( -1 );
+        for ( auto j = 0u; j < num_inputs; ++j )
+        {
+          auto const c = _mm256_set1_epi64x( static_cast<long long>( masks[j] ^ complement_mask( ~minterms[m], j ) ) );
+          term = _mm256_and_si256( term, _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( inputs[j] + w ) ), c ) );
+        }
+        result = _mm256_or_si256( result, term );
+      }
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + w ), _mm256_xor_si256( result, vr ) );
+    }
+    scalar_kernels::lut_from( w, out, inputs, masks, num_inputs, minterms, num_minterms, result_mask, num_words );
+  }
+};
+
+/* majority, XOR3, and multiplexing are single ternary-logic instructions */
+template<>
+struct simulation_kernels<simd_backend::avx512>
+{
+  using scalar_kernels = simulation_kernels<simd_backend::scalar>;
+
+  __attribute__( ( target( "avx512f" ) ) ) static void and2( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint32_t num_words )
+  {
+    auto const va = _mm512_set1_epi64( static_cast<long long>( ca ) );
+    auto const vb = _mm512_set1_epi64( static_cast<long long>( cb ) );
+    auto w = 0u;
+    for ( ; w + 8u <= num_words; w += 8u )
+    {
+      auto const x = _mm512_xor_si512( _mm512_loadu_si512( a + w ), va );
+      auto const y = _mm512_xor_si512( _mm512_loadu_si512( b + w ), vb );
+      _mm512_storeu_si512( out + w, _mm512_and_si512( x, y ) );
+    }
+    scalar_kernels::and2( out + w, a + w, ca, b + w, cb, num_words - w );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) ) static void xor2( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t c, uint32_t num_words )
+  {
+    auto const vc = _mm512_set1_epi64( static_cast<long long>( c ) );
+    auto w = 0u;
+    for ( ; w + 8u <= num_words; w += 8u )
+    {
+      _mm512_storeu_si512( out + w, _mm512_ternarylogic_epi64( _mm512_loadu_si512( a + w ), _mm512_loadu_si512( b + w ), vc, 0x96 ) );
+    }
+    scalar_kernels::xor2( out + w, a + w, b + w, c, num_words - w );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) ) static void maj3( uint64_t* out, uint64_t const* a, uint64_t ca, uint64_t const* b, uint64_t cb, uint64_t const* c, uint64_t cc, uint32_t num_words )
+  {
+    auto const va = _mm512_set1_epi64( static_cast<long long>( ca ) );
+    auto const vb = _mm512_set1_epi64( static_cast<long long>( cb ) );
+    auto const vc = _mm512_set1_epi64( static_cast<long long>( cc ) );
+    auto w = 0u;
+    for ( ; w + 8u <= num_words; w += 8u )
+    {
+      auto const x = _mm512_xor_si512( _mm512_loadu_si512( a + w ), va );
+      auto const y = _mm512_xor_si512( _mm512_loadu_si512( b + w ), vb );
+      auto const z = _mm512_xor_si512( _mm512_loadu_si512( c + w ), vc );
+      _mm512_storeu_si512( out + w, _mm512_ternarylogic_epi64( x, y, z, 0xe8 ) );
+    }
+    scalar_kernels::maj3( out + w, a + w, ca, b + w, cb, c + w, cc, num_words - w );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) ) static void xor3( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t const* c, uint64_t cc, uint32_t num_words )
+  {
+    auto const vc = _mm512_set1_epi64( static_cast<long long>( cc ) );
+    auto w = 0u;
+    for ( ; w + 8u <= num_words; w += 8u )
+    {
+      auto const x = _mm512_ternarylogic_epi64( _mm512_loadu_si512( a + w ), _mm512_loadu_si512( b + w ), _mm512_loadu_si512( c + w ), 0x96 );
+      _mm512_storeu_si512( out + w, _mm512_xor_si512( x, vc ) );
+    }
+    scalar_kernels::xor3( out + w, a + w, b + w, c + w, cc, num_words - w );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) ) static void mux( uint64_t* out, uint64_t const* s, uint64_t cs, uint64_t const* t, uint64_t ct, uint64_t const* e, uint64_t ce, uint32_t num_words )
+  {
+    auto const vs = _mm512_set1_epi64( static_cast<long long>( cs ) );
+    auto const vt = _mm512_set1_epi64( static_cast<long long>( ct ) );
+    auto const ve = _mm512_set1_epi64( static_cast<long long>( ce ) );
+    auto w = 0u;
+    for ( ; w + 8u <= num_words; w += 8u )
+    {
+      auto const x = _mm512_xor_si512( _mm512_loadu_si512( s + w ), vs );
+      auto const y = _mm512_xor_si512( _mm512_loadu_si512( t + w ), vt );
+      auto const z = _mm512_xor_si512( _mm512_loadu_si512( e + w ), ve );
+      _mm512_storeu_si512( out + w, _mm512_ternarylogic_epi64( x, y, z, 0xca ) );
+    }
+    scalar_kernels::mux( out + w, s + w, cs, t + w, ct, e + w, ce, num_words - w );
+  }
+
+  __attribute__( ( target( "avx512f" ) ) ) static void lut( uint64_t* out, uint64_t const* const* inputs, uint64_t const* masks, uint32_t num_inputs, uint32_t const* minterms, uint32_t num_minterms, uint64_t result_mask, uint32_t num_words )
+  {
+    auto const vr = _mm512_set1_epi64( static_cast<long long>( result_mask ) );
+    auto w = 0u;
+    for ( ; w + 8u <= num_words; w += 8u )
+    {
+      auto result = _mm512_setzero_si512();
+      for ( auto m = 0u; m < num_minterms; ++m )
+      {
+        auto term = _mm512_set1_epi64( -1 );
+        for ( auto j = 0u; j < num_inputs; ++j )
+        {
+          auto const c = _mm512_set1_epi64( static_cast<long long>( masks[j] ^ complement_mask( ~minterms[m], j ) ) );
+          /* term & ( input ^ c ) */
+          term = _mm512_ternarylogic_epi64( term, _mm512_loadu_si512( inputs[j] + w ), c, 0x60 );
+        }
+        result = _mm512_or_si512( result, term );
+      }
+      _mm512_storeu_si512( out + w, _mm512_xor_si512( result, vr ) );
+    }
+    scalar_kernels::lut_from( w, out, inputs, masks, num_inputs, minterms, num_minterms, result_mask, num_words );
+  }
+};
+#else
+template<>
+struct simulation_kernels<simd_backend::avx2> : simulation_kernels<simd_backend::scalar>
+{
+};
+
+template<>
+struct simulation_kernels<simd_backend::avx512> : simulation_kernels<simd_backend::scalar>
+{
+};
+#endif
+
+} // namespace detail
+
+} // namespace mockturtle
@@ -34,7 +34,10 @@
 
 #include <vector>
 
+#include "../parallel_simulation.hpp"
 #include "../simulation.hpp"
+#include "../../traits.hpp"
+#include "../../utils/node_map.hpp"
 
 #include <kitty/bit_operations.hpp>
 #include <kitty/partial_truth_table.hpp>
@@ -47,13 +50,47 @@ namespace mockturtle::detail
  * This function computes the switching activity for each node
  * in the network by performing random simulation.
  *
+ * With more than one thread, the patterns are simulated with a
+ * `parallel_simulator`, which gives the same values.
+ *
+ * If the network caches its activities, e.g., in a
+ * `switching_activity_view`, the cached activities are returned and the
+ * parameters of the view take precedence.  Use `switching_activity_engine`
+ * to estimate the activities with input statistics.
+ *
  * \param ntk Network
  * \param simulation_size Number of simulation bits
+ * \param num_threads Number of threads used for simulation
  */
 template<typename Ntk>
-std::vector<float> switching_activity( Ntk const& ntk, unsigned simulation_size = 2048 )
+std::vector<float> switching_activity( Ntk const& ntk, unsigned simulation_size = 2048, uint32_t num_threads = 1u )
 {
+  if constexpr ( has_switching_activities_v<Ntk> )
+  {
+    (void)simulation_size;
+    (void)num_threads;
+    return ntk.switching_activities();
+  }
+
   std::vector<float> sw_map( ntk.size() );
+
+  if ( num_threads > 1u )
+  {
+    parallel_simulator sim( ntk.num_pis(), simulation_size );
+    sim.set_num_threads( num_threads );
+
+    unordered_node_map<kitty::partial_truth_table, Ntk> tts( ntk );
+    simulate_nodes( ntk, tts, sim, true );
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      float ones = static_cast<float>( kitty::count_ones( tts[n] ) );
+      float activity = 2.0 * ones / simulation_size * ( simulation_size - ones ) / simulation_size;
+      sw_map[ntk.node_to_index( n )] = activity;
+    } );
+
+    return sw_map;
+  }
+
   partial_simulator sim( ntk.num_pis(), simulation_size );
 
   auto tts = simulate_nodes<kitty::partial_truth_table, Ntk, partial_simulator>( ntk, sim );
@@ -41,6 +41,7 @@
 #include "../algorithms/cnf.hpp"
 #include "../algorithms/reconv_cut.hpp"
 #include "../algorithms/simulation.hpp"
+#include "../algorithms/ternary_simulation.hpp"
 #include "../traits.hpp"
 #include "../utils/include/percy.hpp"
 #include "../utils/node_map.hpp"
@@ -308,6 +309,35 @@ bool pattern_is_observable( Ntk const& ntk, node<Ntk> const& n, std::vector<bool
   return !kitty::is_const0( care );
 }
 
+/*! \brief Computes observability don't care patterns with three-valued simulation.
+ *
+ * The node `n` is set to X and the network is simulated once for all
+ * patterns of `sim` with a `ternary_simulator`.  A pattern is unobservable if
+ * all primary outputs have a known value.  Because X values are propagated
+ * conservatively, the result is a subset of the patterns returned by
+ * `observability_dont_cares` with `levels = -1`, computed without flipping
+ * and re-simulating `n`.
+ *
+ * Return value: a `partial_truth_table` with the same length as `sim.num_bits()`.
+ * A `1` in it corresponds to an unobservable pattern.
+ */
+template<class Ntk>
+kitty::partial_truth_table ternary_observability_dont_cares( Ntk const& ntk, node<Ntk> const& n, partial_simulator const& sim )
+{
+  ternary_simulator const tsim( sim );
+  unordered_node_map<ternary_truth_table, Ntk> values( ntk );
+
+  kitty::partial_truth_table const unknown( sim.num_bits() );
+  values[n] = ternary_truth_table( unknown, unknown );
+  simulate_nodes( ntk, values, tsim );
+
+  kitty::partial_truth_table care( sim.num_bits() );
+  ntk.foreach_po( [&]( auto const& f ) {
+    care |= ~values[f].known();
+  } );
+  return ~care;
+}
+
 /*! \brief SAT-based satisfiability don't cares checker
  *
  * Initialize this class with a network and then call `is_dont_care` on a node
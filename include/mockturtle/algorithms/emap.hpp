@@ -558,7 +558,7 @@ public:
       ++begin;
 
     /* remove elements that are dominated by new cut */
-    _pcend = _pend = std::stable_partition( begin, _pend, [&cut]( auto const* other ) { return !cut.dominates( *other ); } );
+    _pcend = _pend = stable_front_partition( begin, _pend, [&cut]( auto const* other ) { return !cut.dominates( *other ); } );
 
     /* insert cut in a sorted way */
     simple_insert( cut, sort );
@@ -767,7 +767,7 @@ private:
 public:
   static constexpr float epsilon = 0.0005;
   static constexpr uint32_t max_cut_num = 20;
-  using cut_t = cut<CutSize, cut_enumeration_emap_cut<NInputs>>;
+  using cut_t = fixed_cut_t<CutSize, cut_enumeration_emap_cut<NInputs>>;
   using cut_set_t = emap_cut_set<cut_t, max_cut_num>;
   using cut_merge_t = typename std::array<cut_set_t*, Ntk::max_fanin_size + 1>;
   using fanin_cut_t = typename std::array<cut_t const*, Ntk::max_fanin_size>;
@@ -487,7 +487,7 @@ using sim_resub_stats = boolean_optimization_stats<breadth_first_windowing_stats
 template<class Ntk>
 void simulation_xag_heuristic_resub( Ntk& ntk, sim_resub_params const& ps = {}, sim_resub_stats* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk::base_type is not xag_network" );
+  static_assert( is_xag_network_type_v<Ntk>, "Ntk is not an XAG" );
 
   using ViewedNtk = depth_view<fanout_view<Ntk>>;
   fanout_view<Ntk> fntk( ntk );
@@ -516,7 +516,7 @@ void simulation_xag_heuristic_resub( Ntk& ntk, sim_resub_params const& ps = {},
 template<class Ntk>
 void simulation_aig_heuristic_resub( Ntk& ntk, sim_resub_params const& ps = {}, sim_resub_stats* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, aig_network>, "Ntk::base_type is not aig_network" );
+  static_assert( is_aig_network_type_v<Ntk>, "Ntk is not an AIG" );
 
   using ViewedNtk = depth_view<fanout_view<Ntk>>;
   fanout_view<Ntk> fntk( ntk );
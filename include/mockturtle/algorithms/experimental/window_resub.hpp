@@ -677,7 +677,7 @@ using window_resub_stats_mig = boolean_optimization_stats<complete_tt_windowing_
 template<class Ntk>
 void window_xag_heuristic_resub( Ntk& ntk, window_resub_params const& ps = {}, window_resub_stats_xag* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk::base_type is not xag_network" );
+  static_assert( is_xag_network_type_v<Ntk>, "Ntk is not an XAG" );
 
   using ViewedNtk = depth_view<fanout_view<Ntk>>;
   fanout_view<Ntk> fntk( ntk );
@@ -707,7 +707,7 @@ void window_xag_heuristic_resub( Ntk& ntk, window_resub_params const& ps = {}, w
 template<class Ntk>
 void window_aig_heuristic_resub( Ntk& ntk, window_resub_params const& ps = {}, window_resub_stats_xag* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, aig_network>, "Ntk::base_type is not aig_network" );
+  static_assert( is_aig_network_type_v<Ntk>, "Ntk is not an AIG" );
 
   using ViewedNtk = depth_view<fanout_view<Ntk>>;
   fanout_view<Ntk> fntk( ntk );
@@ -61,6 +61,7 @@
 #include "../io/verilog_reader.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/abc.hpp"
+#include "../utils/network_utils.hpp"
 
 #include <random>
 
@@ -151,15 +152,15 @@ public:
 
     RandEngine rnd( _ps.random_seed );
     auto init_cost = call_with_stopwatch( _st.time_evaluate, [&](){ return cost( ntk ); } );
-    Ntk best = ntk.clone();
+    Ntk best = snapshot_network( ntk );
     auto best_cost = init_cost;
     for ( auto i = 0u; i < _ps.num_restarts; ++i )
     {
-      Ntk current = ntk.clone();
+      Ntk current = snapshot_network( ntk );
       auto new_cost = run_one_iteration( current, rnd(), init_cost );
       if ( new_cost < best_cost )
       {
-        best = current.clone();
+        best = current;
         best_cost = new_cost;
       }
       if ( _ps.verbose )
@@ -178,13 +179,13 @@ private:
  
     stopwatch<>::duration elapsed_time{0};
     RandEngine rnd( seed );
-    Ntk best = ntk.clone();
+    Ntk best = snapshot_network( ntk );
     auto best_cost = init_cost;
     uint32_t last_update{0u};
     for ( auto i = 0u; i < _ps.max_steps; ++i )
     {
     #if explorer_debug
-      Ntk backup = ntk.clone();
+      Ntk backup = snapshot_network( ntk );
     #endif
 
       {
@@ -208,7 +209,7 @@ private:
 
       if ( new_cost < best_cost )
       {
-        best = ntk.clone();
+        best = snapshot_network( ntk );
         best_cost = new_cost;
         last_update = i;
         if ( _ps.verbose )
@@ -230,7 +231,7 @@ private:
       }
     }
     std::cout << std::flush;
-    ntk = best;
+    rollback_network( ntk, best );
     return best_cost;
   }
 
@@ -34,6 +34,7 @@
 #pragma once
 
 #include "../utils/progress_bar.hpp"
+#include "../utils/signature_index.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/fanout_view.hpp"
 
@@ -111,6 +112,9 @@ struct functional_reduction_stats
   /*! \brief Number of SAT solver timeout. */
   uint32_t num_timeout{ 0 };
 
+  /*! \brief Number of nodes skipped for having a unique simulation signature. */
+  uint32_t num_unique_signatures{ 0 };
+
   void report() const
   {
     // clang-format off
@@ -121,6 +125,7 @@ struct functional_reduction_stats
     std::cout << fmt::format( "[i] #SAT      = {:8d}\n", num_cex );
     std::cout << fmt::format( "[i] #UNSAT    = {:8d}\n", num_reduction );
     std::cout << fmt::format( "[i] #TIMEOUT  = {:8d}\n", num_timeout );
+    std::cout << fmt::format( "[i] #unique   = {:8d}\n", num_unique_signatures );
     std::cout <<              "[i] ======== Runtime ========\n";
     std::cout << fmt::format( "[i] total        : {:>5.2f} secs\n", to_seconds( time_total ) );
     std::cout << fmt::format( "[i]   simulation : {:>5.2f} secs\n", to_seconds( time_sim ) );
@@ -132,7 +137,7 @@ struct functional_reduction_stats
 
 namespace detail
 {
-template<typename Ntk, typename validator_t = circuit_validator<Ntk, bill::solvers::bsat2>>
+template<typename Ntk, typename validator_t = circuit_validator<Ntk, bill::solvers::bsat2>, class Simulator = partial_simulator>
 class functional_reduction_impl
 {
 public:
@@ -142,7 +147,7 @@ public:
 
   explicit functional_reduction_impl( Ntk& ntk, functional_reduction_params const& ps, validator_params const& vps, functional_reduction_stats& st )
       : ntk( ntk ), ps( ps ), st( st ), tts( ntk ),
-        sim( ps.pattern_filename ? partial_simulator( *ps.pattern_filename ) : partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() ) ), validator( ntk, vps )
+        sim( ps.pattern_filename ? Simulator( *ps.pattern_filename ) : Simulator( ntk.num_pis(), ps.num_patterns, std::rand() ) ), validator( ntk, vps ), index( ntk )
   {
     static_assert( !validator_t::use_odc_, "`circuit_validator::use_odc` flag should be turned off." );
   }
@@ -233,13 +238,23 @@ private:
 
   void substitute_equivalent_nodes()
   {
+    if ( index_size != ntk.size() )
+    {
+      build_index();
+    }
+
     progress_bar pbar{ ntk.size(), "FR-equ |{0}| node = {1:>4}   cand = {2:>4}", ps.progress };
     ntk.foreach_gate( [&]( auto const& root, auto i ) {
       pbar( i, i, candidates );
 
       check_tts( root );
-      auto tt = tts[root];
-      auto ntt = ~tts[root];
+      /* no other node has the same or the complemented simulation signature */
+      if ( index_size == ntk.size() && index.contains( root ) && index.is_singleton( root ) )
+      {
+        ++st.num_unique_signatures;
+        return true; /* next */
+      }
+
       std::vector<node> tfi;
       bool keep_trying = true;
       foreach_transitive_fanin( root, [&]( auto const& n ) {
@@ -249,7 +264,7 @@ private:
           return false;
         }
 
-        keep_trying = try_node( tt, ntt, root, n );
+        keep_trying = try_node( root, n );
         return keep_trying;
       } );
 
@@ -302,7 +317,7 @@ private:
             ntk.set_visited( p, ntk.trav_id() );
 
             check_tts( p );
-            keep_trying = try_node( tt, ntt, root, p );
+            keep_trying = try_node( root, p );
             return keep_trying;
           } );
         }
@@ -312,14 +327,20 @@ private:
     } );
   }
 
-  bool try_node( kitty::partial_truth_table& tt, kitty::partial_truth_table& ntt, node const& root, node const& n )
+  bool try_node( node const& root, node const& n )
   {
+    /* different buckets differ on the indexed patterns */
+    if ( index.contains( root ) && index.contains( n ) && !index.same_bucket( root, n ) )
+    {
+      return true; /* try next transitive fanin node */
+    }
+
     signal g;
-    if ( tt == tts[n] )
+    if ( tts[root] == tts[n] )
     {
       g = ntk.make_signal( n );
     }
-    else if ( ntt == tts[n] )
+    else if ( is_complement( tts[root], tts[n] ) )
     {
       g = !ntk.make_signal( n );
     }
@@ -343,8 +364,6 @@ private:
     {
       found_cex();
       check_tts( root );
-      tt = tts[root];
-      ntt = ~tts[root];
       return true; /* try next transitive fanin node */
     }
     else /* UNSAT, equivalent node verified */
@@ -353,6 +372,7 @@ private:
       ++st.num_equ_accepts;
       /* update network */
       ntk.substitute_node( root, g );
+      index.erase( root );
       return false; /* break `foreach_transitive_fanin` */
     }
   }
@@ -374,6 +394,11 @@ private:
       call_with_stopwatch( st.time_sim, [&]() {
         simulate_nodes<Ntk>( ntk, tts, sim, false );
       } );
+      /* only nodes sharing their bucket may be split by the new patterns */
+      index.refine( sim.num_bits(), [&]( node const& n ) -> kitty::partial_truth_table const& {
+        check_tts( n );
+        return tts[n];
+      } );
     }
   }
 
@@ -389,11 +414,41 @@ private:
 
   void reseed_patterns()
   {
-    sim = partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() );
+    sim = Simulator( ntk.num_pis(), ps.num_patterns, std::rand() );
     tts.reset();
     call_with_stopwatch( st.time_sim, [&]() {
       simulate_nodes<Ntk>( ntk, tts, sim, true );
     } );
+    build_index();
+  }
+
+  /* index of the simulation signatures, rebuilt when the patterns are
+   * discarded or when nodes were added since the last build */
+  void build_index()
+  {
+    index.build( sim.num_bits(), [&]( node const& n ) -> kitty::partial_truth_table const& {
+      check_tts( n );
+      return tts[n];
+    } );
+    index_size = ntk.size();
+  }
+
+  static bool is_complement( kitty::partial_truth_table const& tt1, kitty::partial_truth_table const& tt2 )
+  {
+    if ( tt1.num_bits() != tt2.num_bits() || tt1.num_bits() == 0 )
+    {
+      return tt1.num_bits() == tt2.num_bits();
+    }
+    auto const last = tt1.num_blocks() - 1u;
+    for ( auto i = 0u; i < last; ++i )
+    {
+      if ( tt1._bits[i] != ~tt2._bits[i] )
+      {
+        return false;
+      }
+    }
+    auto const mask = ( tt1.num_bits() & 63 ) ? ( UINT64_C( 1 ) << ( tt1.num_bits() & 63 ) ) - 1u : ~UINT64_C( 0 );
+    return ( ( tt1._bits[last] ^ ~tt2._bits[last] ) & mask ) == 0u;
   }
 
   template<typename Fn>
@@ -434,8 +489,10 @@ private:
   functional_reduction_stats& st;
 
   TT tts;
-  partial_simulator sim;
+  Simulator sim;
   validator_t validator;
+  signature_index<Ntk> index;
+  uint64_t index_size{ 0 };
 
   uint32_t candidates{ 0 };
 }; /* functional_reduction_impl */
@@ -445,8 +502,11 @@ private:
 /*! \brief Functional reduction.
  *
  * Removes constant nodes and substitute functionally equivalent nodes.
+ *
+ * \tparam Simulator Simulator of partial truth tables: `partial_simulator`
+ * or a derived simulator, such as `simd_simulator`
  */
-template<class Ntk>
+template<class Ntk, class Simulator = partial_simulator>
 void functional_reduction( Ntk& ntk, functional_reduction_params const& ps = {}, functional_reduction_stats* pst = nullptr )
 {
   static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -471,7 +531,7 @@ void functional_reduction( Ntk& ntk, functional_reduction_params const& ps = {},
   fanout_view_t fanout_view{ ntk };
 
   functional_reduction_stats st;
-  detail::functional_reduction_impl p( fanout_view, ps, vps, st );
+  detail::functional_reduction_impl<fanout_view_t, circuit_validator<fanout_view_t, bill::solvers::bsat2>, Simulator> p( fanout_view, ps, vps, st );
   p.run();
 
   if ( ps.verbose )
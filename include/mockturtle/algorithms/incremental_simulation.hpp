@@ -0,0 +1,326 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file incremental_simulation.hpp
+  \brief Event-driven incremental simulation of partial truth tables
+
+  \author Heinz Riener
+  \author Mathias Soeken
+  \author Siang-Yun (Sonia) Lee
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "simulation.hpp"
+
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Statistics for incremental_simulator. */
+struct incremental_simulation_stats
+{
+  /*! \brief Number of nodes simulated over all patterns. */
+  uint64_t num_full{ 0 };
+
+  /*! \brief Number of nodes simulated over the appended patterns only. */
+  uint64_t num_partial{ 0 };
+
+  /*! \brief Number of simulated 64-bit words. */
+  uint64_t num_words{ 0 };
+
+  /*! \brief Number of nodes marked as stale by network events. */
+  uint64_t num_marked{ 0 };
+};
+
+/*! \brief Keeps the simulation values of a network up to date lazily.
+ *
+ * The simulator listens to the events of the network.  Adding a node or
+ * changing the fanins of a node (e.g., by `substitute_node`) marks the node
+ * and its transitive fanout as stale, without simulating anything.  Querying
+ * the value of a node re-simulates the stale nodes in its transitive fanin
+ * cone, and nothing else.
+ *
+ * Patterns that are appended to the simulator with `add_pattern` are
+ * simulated on the next query, only for the words that changed, i.e., from
+ * the last partially filled word on.  When the patterns of the simulator are
+ * replaced, `reset` must be called.
+ *
+ * The network must implement `foreach_fanout`, e.g., by wrapping it into a
+ * `fanout_view`, which must be created before the simulator.
+ *
+ * **Example**
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      fanout_view<aig_network> fanout_aig{ aig };
+      partial_simulator sim( aig.num_pis(), 256 );
+      incremental_simulator isim( fanout_aig, sim );
+
+      auto const& tt = isim.value( n );          // simulates the fanin cone of n
+      fanout_aig.substitute_node( old_node, g ); // marks the fanout of old_node
+      sim.add_pattern( pattern );                // nothing is simulated yet
+      auto const& tt2 = isim.value( n );         // simulates what is stale
+   \endverbatim
+ */
+template<class Ntk, class Simulator = partial_simulator>
+class incremental_simulator
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  incremental_simulator( Ntk const& ntk, Simulator const& sim )
+      : _ntk( ntk ), _sim( sim )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_foreach_fanout_v<Ntk>, "Ntk does not implement the foreach_fanout method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+    static_assert( std::is_base_of_v<partial_simulator, Simulator>, "Simulator should be partial_simulator or derived from it" );
+
+    resize();
+    register_events();
+  }
+
+  ~incremental_simulator()
+  {
+    release_events();
+  }
+
+  incremental_simulator( incremental_simulator const& ) = delete;
+  incremental_simulator& operator=( incremental_simulator const& ) = delete;
+
+  /*! \brief Returns the simulation value of `n`, re-simulating its stale fanin cone. */
+  kitty::partial_truth_table const& value( node const& n )
+  {
+    update_cone( n );
+    return _values[_ntk.node_to_index( n )];
+  }
+
+  /*! \brief Re-simulates all stale nodes. */
+  void update()
+  {
+    _ntk.foreach_node( [&]( auto const& n ) {
+      update_cone( n );
+    } );
+  }
+
+  /*! \brief Whether `n` is re-simulated on the next query. */
+  bool is_stale( node const& n ) const
+  {
+    auto const index = _ntk.node_to_index( n );
+    return index >= _dirty.size() || _dirty[index] || _num_bits[index] != _sim.num_bits();
+  }
+
+  /*! \brief Marks `n` and its transitive fanout for re-simulation over all patterns. */
+  void mark_dirty( node const& n )
+  {
+    resize();
+    std::vector<node> stack{ n };
+    while ( !stack.empty() )
+    {
+      auto const m = stack.back();
+      stack.pop_back();
+
+      /* the transitive fanout of a dirty node is dirty */
+      auto const index = _ntk.node_to_index( m );
+      if ( _dirty[index] )
+      {
+        continue;
+      }
+      _dirty[index] = true;
+      ++_st.num_marked;
+
+      _ntk.foreach_fanout( m, [&]( auto const& f ) {
+        stack.push_back( f );
+      } );
+    }
+  }
+
+  /*! \brief Marks all nodes for re-simulation, e.g., after replacing the patterns. */
+  void reset()
+  {
+    std::fill( _dirty.begin(), _dirty.end(), true );
+  }
+
+  incremental_simulation_stats const& stats() const
+  {
+    return _st;
+  }
+
+private:
+  void resize()
+  {
+    auto const size = _ntk.size();
+    if ( _values.size() < size )
+    {
+      _values.resize( size );
+      _num_bits.resize( size, 0u );
+      _dirty.resize( size, true );
+    }
+  }
+
+  void update_cone( node const& n )
+  {
+    resize();
+    if ( !is_stale( n ) )
+    {
+      return;
+    }
+
+    /* post-order traversal of the stale part of the fanin cone */
+    std::vector<std::pair<node, bool>> stack{ { n, false } };
+    while ( !stack.empty() )
+    {
+      auto& [m, expanded] = stack.back();
+      if ( !is_stale( m ) )
+      {
+        stack.pop_back();
+        continue;
+      }
+      if ( expanded )
+      {
+        auto const current = m;
+        stack.pop_back();
+        simulate( current );
+        continue;
+      }
+
+      expanded = true;
+      auto const current = m;
+      _ntk.foreach_fanin( current, [&]( auto const& f ) {
+        if ( is_stale( _ntk.get_node( f ) ) )
+        {
+          stack.emplace_back( _ntk.get_node( f ), false );
+        }
+      } );
+    }
+  }
+
+  void simulate( node const& n )
+  {
+    auto const index = _ntk.node_to_index( n );
+    auto const num_bits = _sim.num_bits();
+    auto& value = _values[index];
+
+    if ( _ntk.is_constant( n ) )
+    {
+      value = _sim.compute_constant( _ntk.constant_value( n ) );
+    }
+    else if ( _ntk.is_pi( n ) )
+    {
+      value = _sim.compute_pi( _ntk.pi_index( n ) );
+    }
+    else if ( _dirty[index] || _num_bits[index] == 0u || _num_bits[index] > num_bits )
+    {
+      std::vector<kitty::partial_truth_table> fanin_values;
+      _ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fanin_values.push_back( _values[_ntk.node_to_index( _ntk.get_node( f ) )] );
+      } );
+      value = _ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+
+      ++_st.num_full;
+      _st.num_words += value.num_blocks();
+    }
+    else
+    {
+      /* only the words from the last partially filled one on change */
+      auto const first_word = _num_bits[index] >> 6;
+      auto const tail_bits = num_bits - ( first_word << 6 );
+
+      std::vector<kitty::partial_truth_table> fanin_values;
+      _ntk.foreach_fanin( n, [&]( auto const& f ) {
+        auto const& fanin_value = _values[_ntk.node_to_index( _ntk.get_node( f ) )];
+        kitty::partial_truth_table tail( tail_bits );
+        std::copy( fanin_value._bits.begin() + first_word, fanin_value._bits.end(), tail._bits.begin() );
+        fanin_values.push_back( tail );
+      } );
+      auto const tail = _ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+
+      value.resize( num_bits );
+      std::copy( tail._bits.begin(), tail._bits.end(), value._bits.begin() + first_word );
+
+      ++_st.num_partial;
+      _st.num_words += tail.num_blocks();
+    }
+
+    _num_bits[index] = num_bits;
+    _dirty[index] = false;
+  }
+
+  void register_events()
+  {
+    _add_event = _ntk.events().register_add_event( [this]( auto const& n ) {
+      resize();
+      _dirty[_ntk.node_to_index( n )] = true;
+    } );
+    _modified_event = _ntk.events().register_modified_event( [this]( auto const& n, auto const& previous ) {
+      (void)previous;
+      mark_dirty( n );
+    } );
+    _delete_event = _ntk.events().register_delete_event( [this]( auto const& n ) {
+      resize();
+      auto const index = _ntk.node_to_index( n );
+      _values[index] = kitty::partial_truth_table();
+      _num_bits[index] = 0u;
+      _dirty[index] = true;
+    } );
+  }
+
+  void release_events()
+  {
+    _ntk.events().release_add_event( _add_event );
+    _ntk.events().release_modified_event( _modified_event );
+    _ntk.events().release_delete_event( _delete_event );
+  }
+
+private:
+  Ntk const& _ntk;
+  Simulator const& _sim;
+
+  std::vector<kitty::partial_truth_table> _values;
+  std::vector<uint32_t> _num_bits;
+  std::vector<bool> _dirty;
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> _add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> _modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> _delete_event;
+
+  incremental_simulation_stats _st;
+};
+
+} // namespace mockturtle
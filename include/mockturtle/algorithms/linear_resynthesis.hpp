@@ -369,7 +369,7 @@ private:
 template<typename Ntk>
 Ntk linear_resynthesis_paar( Ntk const& xag )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk is not XAG-like" );
+  static_assert( is_xag_network_type_v<Ntk>, "Ntk is not XAG-like" );
 
   return detail::linear_resynthesis_paar_impl<Ntk>( xag ).run();
 }
@@ -954,7 +954,7 @@ private:
 template<class Ntk>
 std::vector<std::vector<bool>> get_linear_matrix( Ntk const& ntk )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk is not XAG-like" );
+  static_assert( is_xag_network_type_v<Ntk>, "Ntk is not XAG-like" );
 
   detail::linear_matrix_simulator sim( ntk.num_pis() );
   return simulate<std::vector<bool>>( detail::linear_xag{ ntk }, sim );
@@ -972,7 +972,7 @@ std::vector<std::vector<bool>> get_linear_matrix( Ntk const& ntk )
 template<class Ntk = xag_network, bill::solvers Solver = bill::solvers::glucose_41>
 std::optional<Ntk> exact_linear_synthesis( std::vector<std::vector<bool>> const& linear_matrix, exact_linear_synthesis_params const& ps = {}, exact_linear_synthesis_stats* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk is not XAG-like" );
+  static_assert( is_xag_network_type_v<Ntk>, "Ntk is not XAG-like" );
 
   exact_linear_synthesis_stats st;
   const auto xag = detail::exact_linear_synthesis_impl<Ntk, Solver>{ linear_matrix, ps, st }.run();
@@ -999,7 +999,7 @@ std::optional<Ntk> exact_linear_synthesis( std::vector<std::vector<bool>> const&
 template<class Ntk = xag_network, bill::solvers Solver = bill::solvers::glucose_41>
 std::optional<Ntk> exact_linear_resynthesis( Ntk const& ntk, exact_linear_synthesis_params const& ps = {}, exact_linear_synthesis_stats* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk is not XAG-like" );
+  static_assert( is_xag_network_type_v<Ntk>, "Ntk is not XAG-like" );
 
   const auto linear_matrix = get_linear_matrix( ntk );
   return exact_linear_synthesis<Ntk, Solver>( linear_matrix, ps, pst );
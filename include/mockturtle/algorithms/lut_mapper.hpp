@@ -477,7 +477,7 @@ public:
       ++begin;
 
     /* remove elements that are dominated by new cut */
-    _pcend = _pend = std::stable_partition( begin, _pend, [&cut]( auto const* other ) { return !cut.dominates( *other ); } );
+    _pcend = _pend = stable_front_partition( begin, _pend, [&cut]( auto const* other ) { return !cut.dominates( *other ); } );
 
     /* insert cut in a sorted way */
     simple_insert( cut, sort );
@@ -591,7 +591,7 @@ struct node_lut
   float est_refs;
 };
 
-template<class Ntk, bool StoreFunction, class LUTCostFn>
+template<class Ntk, bool StoreFunction, class LUTCostFn, uint32_t MaxCutSize = 16u>
 class lut_map_impl
 {
 private:
@@ -606,10 +606,10 @@ private:
 
 public:
   static constexpr uint32_t max_cut_num = 32;
-  static constexpr uint32_t max_cut_size = 16;
+  static constexpr uint32_t max_cut_size = MaxCutSize;
   static constexpr uint32_t max_cubes = 64;
   static constexpr uint32_t max_sop_decomp_size = max_cut_size * ( max_cubes + 1 );
-  using cut_t = cut<max_cut_size, cut_data<StoreFunction, cut_enumeration_lut_cut>>;
+  using cut_t = fixed_cut_t<max_cut_size, cut_data<StoreFunction, cut_enumeration_lut_cut>>;
   using cut_set_t = lut_cut_set<cut_t, max_cut_num>;
   using node = typename Ntk::node;
   using cut_merge_t = typename std::array<cut_set_t*, Ntk::max_fanin_size + 1>;
@@ -630,6 +630,7 @@ public:
         cuts( ntk.size() )
   {
     assert( ps.cut_enumeration_ps.cut_limit < max_cut_num && "cut_limit exceeds the compile-time limit for the maximum number of cuts" );
+    assert( ps.cut_enumeration_ps.cut_size <= max_cut_size && "cut_size exceeds the compile-time limit for the maximum cut size" );
 
     if constexpr ( StoreFunction )
     {
@@ -2910,8 +2911,17 @@ klut_network lut_map( Ntk& ntk, lut_map_params ps = {}, lut_map_stats* pst = nul
     tps.cut_expansion = false;
   }
 
-  detail::lut_map_impl<Ntk, ComputeTruth, LUTCostFn> p( ntk, tps, st );
-  klut = p.run();
+  /* cuts with up to 8 leaves are packed */
+  if ( tps.cut_enumeration_ps.cut_size <= 8u )
+  {
+    detail::lut_map_impl<Ntk, ComputeTruth, LUTCostFn, 8u> p( ntk, tps, st );
+    klut = p.run();
+  }
+  else
+  {
+    detail::lut_map_impl<Ntk, ComputeTruth, LUTCostFn> p( ntk, tps, st );
+    klut = p.run();
+  }
 
   if ( ps.verbose )
   {
@@ -2998,8 +3008,17 @@ void lut_map_inplace( Ntk& ntk, lut_map_params const& ps = {}, lut_map_stats* ps
     tps.cut_expansion = false;
   }
 
-  detail::lut_map_impl<Ntk, StoreFunction, LUTCostFn> p( ntk, tps, st );
-  p.run_inplace();
+  /* cuts with up to 8 leaves are packed */
+  if ( tps.cut_enumeration_ps.cut_size <= 8u )
+  {
+    detail::lut_map_impl<Ntk, StoreFunction, LUTCostFn, 8u> p( ntk, tps, st );
+    p.run_inplace();
+  }
+  else
+  {
+    detail::lut_map_impl<Ntk, StoreFunction, LUTCostFn> p( ntk, tps, st );
+    p.run_inplace();
+  }
 
   if ( ps.verbose )
   {
@@ -330,11 +330,17 @@ private:
     ntk._storage->nodes[b.index].data[0].h1++;
     ntk._storage->nodes[c.index].data[0].h1++;
 
-    for ( auto const& fn : ntk._events->on_add )
+    /* keep acquired fan-out lists up to date (see `acquire_fanouts`) */
+    if ( ntk._storage->fanout_users > 0u )
     {
-      ( *fn )( index );
+      for ( auto i = 0u; i < 3u; ++i )
+      {
+        ntk._storage->fanouts.link( index, i, nd.children[i].index );
+      }
     }
 
+    ntk._events->notify_add( index );
+
     return { index, 0 };
   }
 
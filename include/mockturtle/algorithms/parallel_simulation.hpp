@@ -0,0 +1,108 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file parallel_simulation.hpp
+  \brief Multi-threaded simulation of partial truth tables
+
+  \author Heinz Riener
+  \author Mathias Soeken
+  \author Siang-Yun (Sonia) Lee
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+#include "compiled_simulation.hpp"
+#include "simulation.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Simulates partial truth tables on several threads.
+ *
+ * This class has the same interfaces as `partial_simulator` and can be used
+ * in its place, for example in `functional_reduction`, `pattern_generation`,
+ * and `switching_activity`.  Simulating whole truth tables with
+ * `simulate_nodes( ntk, node_to_value, sim, true )` splits the patterns into
+ * `num_threads()` ranges of words, which are evaluated concurrently with the
+ * SIMD kernels of `simd_simulator`.  The values are bit-identical to the ones
+ * computed with `partial_simulator`, independent of the number of threads.
+ *
+ * **Example**
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      parallel_simulator sim( aig.num_pis(), 1u << 16 );
+      sim.set_num_threads( 8u );
+
+      unordered_node_map<kitty::partial_truth_table, aig_network> tts( aig );
+      simulate_nodes( aig, tts, sim, true );
+   \endverbatim
+ */
+class parallel_simulator : public simd_simulator
+{
+public:
+  using simd_simulator::simd_simulator;
+
+  parallel_simulator() = default;
+
+  /*! \brief Number of threads used to simulate whole truth tables. */
+  uint32_t num_threads() const
+  {
+    return _num_threads;
+  }
+
+  /*! \brief Sets the number of threads used to simulate whole truth tables.
+   *
+   * A value of 0 uses as many threads as there are hardware threads.
+   */
+  void set_num_threads( uint32_t num_threads )
+  {
+    _num_threads = num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : num_threads;
+  }
+
+private:
+  uint32_t _num_threads{ std::max( 1u, std::thread::hardware_concurrency() ) };
+};
+
+/*! \brief Simulates a network with `parallel_simulator`.
+ *
+ * This overload has the same semantics as `simulate_nodes` with a
+ * `partial_simulator`.  When `simulate_whole_tt` is true and no gate has a
+ * value in `node_to_value`, the patterns are simulated on
+ * `sim.num_threads()` threads.
+ */
+template<class Ntk, class Container>
+void simulate_nodes( Ntk const& ntk, Container& node_to_value, parallel_simulator const& sim, bool simulate_whole_tt )
+{
+  detail::simulate_nodes_compiled( ntk, node_to_value, sim, simulate_whole_tt, sim.num_threads() );
+}
+
+} // namespace mockturtle
@@ -42,7 +42,11 @@
 #include <bill/sat/interface/abc_bsat2.hpp>
 #include <bill/sat/interface/z3.hpp>
 #include <kitty/partial_truth_table.hpp>
+#include <memory>
+#include <optional>
 #include <random>
+#include <thread>
+#include <vector>
 
 namespace mockturtle
 {
@@ -74,6 +78,21 @@ struct pattern_generation_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{ 1000 };
+
+  /*! \brief Number of threads checking stuck-at values concurrently.
+   *
+   * With more than one thread, the constant-looking nodes are checked in
+   * batches, each thread with its own SAT solver, before the sequential
+   * checks.  This is only used without observability (`odc_levels == 0`).
+   */
+  uint32_t num_threads{ 1 };
+
+  /*! \brief Number of nodes checked concurrently before the found patterns are merged.
+   *
+   * Patterns found within a batch are not used to rule out other nodes of
+   * the same batch, so larger batches generate more patterns.
+   */
+  uint32_t batch_size{ 64 };
 };
 
 struct pattern_generation_stats
@@ -104,6 +123,9 @@ struct pattern_generation_stats
 
   /*! \brief Number of unobservable nodes (node for which an observable pattern can not be found). */
   uint32_t unobservable_node{ 0 };
+
+  /*! \brief Number of batches checked by several threads. */
+  uint32_t num_batches{ 0 };
 };
 
 namespace detail
@@ -138,6 +160,13 @@ public:
 
     if ( ps.num_stuck_at > 0 )
     {
+      if constexpr ( !use_odc )
+      {
+        if ( ps.num_threads > 1u )
+        {
+          parallel_stuck_at_check();
+        }
+      }
       stuck_at_check();
       if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
       {
@@ -192,6 +221,11 @@ private:
     ntk.foreach_gate( [&]( auto const& n, auto i ) {
       pbar( i, i, sim.num_bits() );
 
+      if ( checked.size() > ntk.node_to_index( n ) && checked[ntk.node_to_index( n )] )
+      {
+        return true; /* proven constant or timed out in parallel */
+      }
+
       if ( tts[n].num_bits() != sim.num_bits() )
       {
         call_with_stopwatch( st.time_sim, [&]() {
@@ -293,6 +327,102 @@ private:
     } );
   }
 
+  /* Checks the constant-looking nodes in batches of `ps.batch_size` nodes,
+   * which are distributed over `ps.num_threads` solvers.  The solvers only
+   * read the network, so they share it.  The found patterns are merged in
+   * the order of the nodes, such that the result only depends on the number
+   * of threads.  Nodes proven constant or timed out are not checked again. */
+  void parallel_stuck_at_check()
+  {
+    using validator_t = circuit_validator<Ntk, bill::solvers::bsat2, true, true, false>;
+
+    auto const num_threads = ps.num_threads;
+    std::vector<std::unique_ptr<validator_t>> validators;
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      validators.emplace_back( std::make_unique<validator_t>( ntk, vps ) );
+    }
+    checked.assign( ntk.size(), false );
+
+    std::vector<node> candidates;
+    std::vector<bool> values;
+    std::vector<std::optional<bool>> results;
+    std::vector<std::vector<bool>> cexs;
+    while ( true )
+    {
+      kitty::partial_truth_table const zero = sim.compute_constant( false );
+
+      candidates.clear();
+      values.clear();
+      ntk.foreach_gate( [&]( auto const& n ) {
+        if ( checked[ntk.node_to_index( n )] )
+        {
+          return true;
+        }
+        if ( tts[n].num_bits() != sim.num_bits() )
+        {
+          call_with_stopwatch( st.time_sim, [&]() {
+            simulate_node<Ntk>( ntk, n, tts, sim );
+          } );
+        }
+        if ( ( tts[n] == zero ) || ( tts[n] == ~zero ) )
+        {
+          candidates.emplace_back( n );
+          values.emplace_back( tts[n] == zero ); /* wanted value of n */
+        }
+        return candidates.size() < std::max( ps.batch_size, num_threads );
+      } );
+
+      if ( candidates.empty() )
+      {
+        break;
+      }
+      ++st.num_batches;
+
+      results.assign( candidates.size(), std::nullopt );
+      cexs.assign( candidates.size(), {} );
+      call_with_stopwatch( st.time_sat, [&]() {
+        std::vector<std::thread> threads;
+        for ( auto t = 0u; t < num_threads; ++t )
+        {
+          threads.emplace_back( [&, t]() {
+            for ( auto i = t; i < candidates.size(); i += num_threads )
+            {
+              results[i] = validators[t]->validate( candidates[i], !values[i] );
+              if ( results[i] && !( *results[i] ) )
+              {
+                cexs[i] = validators[t]->cex;
+              }
+            }
+          } );
+        }
+        for ( auto& thread : threads )
+        {
+          thread.join();
+        }
+      } );
+
+      for ( auto i = 0u; i < candidates.size(); ++i )
+      {
+        auto const& n = candidates[i];
+        if ( !results[i] ) /* timeout */
+        {
+          checked[ntk.node_to_index( n )] = true;
+        }
+        else if ( !( *results[i] ) ) /* SAT, pattern found */
+        {
+          new_pattern( cexs[i], n );
+        }
+        else /* UNSAT, constant node */
+        {
+          ++st.num_constant;
+          const_nodes.emplace_back( values[i] ? ntk.make_signal( n ) : !ntk.make_signal( n ) );
+          checked[ntk.node_to_index( n )] = true;
+        }
+      }
+    }
+  }
+
   void observability_check()
   {
     progress_bar pbar{ ntk.size(), "patgen-obs |{0}| node = {1:>4} #pat = {2:>4}", ps.progress };
@@ -541,6 +671,7 @@ private:
 
   TT tts;
   std::vector<signal> const_nodes;
+  std::vector<bool> checked;
 
   Simulator& sim;
 };
@@ -555,8 +686,8 @@ private:
  *
  * [1] Simulation-Guided Boolean Resubstitution. IWLS 2020 (arXiv:2007.02579).
  *
- * \param sim Reference of a `partial_simulator` or `bit_packed_simulator`
- * object where the generated patterns will be stored.
+ * \param sim Reference of a `partial_simulator` or derived simulator (such as
+ * `bit_packed_simulator`) object where the generated patterns will be stored.
  * It can be empty (`Simulator( ntk.num_pis(), 0 )`)
  * or already containing some patterns generated from previous runs
  * (`Simulator( filename )`) or randomly generated
@@ -572,7 +703,7 @@ void pattern_generation( Ntk& ntk, Simulator& sim, pattern_generation_params con
   static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
   static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
   static_assert( has_make_signal_v<Ntk>, "Ntk does not implement the make_signal method" );
-  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "Simulator should be either partial_simulator or bit_packed_simulator" );
+  static_assert( std::is_base_of_v<partial_simulator, Simulator>, "Simulator should be partial_simulator or derived from it" );
 
   pattern_generation_stats st;
   validator_params vps;
@@ -149,7 +149,7 @@ struct sim_resub_stats
  * \tparam ResynEngine A resynthesis solver to compute the resubstitution candidate.
  * \tparam MffcRes Typename of `potential_gain`.
  */
-template<class Ntk, typename validator_t = circuit_validator<Ntk, bill::solvers::bsat2, false, true, false>, class ResynEngine = xag_resyn_decompose<kitty::partial_truth_table, xag_resyn_static_params_for_sim_resub<Ntk>>, typename MffcRes = uint32_t>
+template<class Ntk, typename validator_t = circuit_validator<Ntk, bill::solvers::bsat2, false, true, false>, class ResynEngine = xag_resyn_decompose<kitty::partial_truth_table, xag_resyn_static_params_for_sim_resub<Ntk>>, typename MffcRes = uint32_t, class Simulator = partial_simulator>
 class simulation_based_resub_engine
 {
 public:
@@ -198,11 +198,11 @@ public:
     call_with_stopwatch( st.time_patgen, [&]() {
       if ( ps.pattern_filename )
       {
-        sim = partial_simulator( *ps.pattern_filename );
+        sim = Simulator( *ps.pattern_filename );
       }
       else
       {
-        sim = partial_simulator( ntk.num_pis(), 1024 );
+        sim = Simulator( ntk.num_pis(), 1024 );
         pattern_generation( ntk, sim );
       }
 
@@ -329,7 +329,7 @@ private:
   stats& st;
 
   incomplete_node_map<TT, Ntk> tts;
-  partial_simulator sim;
+  Simulator sim;
 
   validator_t validator;
   ResynEngine engine;
@@ -365,48 +365,53 @@ void sim_resubstitution_run( Ntk& ntk, resubstitution_params const& ps, resubsti
 
 } /* namespace detail */
 
-template<class Ntk>
+/*! \brief Simulation-guided resubstitution.
+ *
+ * \tparam Simulator Simulator of partial truth tables: `partial_simulator`
+ * or a derived simulator, such as `simd_simulator`
+ */
+template<class Ntk, class Simulator = partial_simulator>
 void sim_resubstitution( Ntk& ntk, resubstitution_params const& ps = {}, resubstitution_stats* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, aig_network> 
-                 || std::is_same_v<typename Ntk::base_type, xag_network>
+  static_assert( is_aig_network_type_v<Ntk> 
+                 || is_xag_network_type_v<Ntk>
                  || std::is_same_v<typename Ntk::base_type, mig_network>, "Currently only supports AIG, XAG, and MIG" );
 
   using resub_view_t = fanout_view<depth_view<Ntk>>;
   depth_view<Ntk> depth_view{ ntk };
   resub_view_t resub_view{ depth_view };
 
-  if constexpr ( std::is_same_v<typename Ntk::base_type, aig_network> )
+  if constexpr ( is_aig_network_type_v<Ntk> )
   {
     using resyn_engine_t = xag_resyn_decompose<kitty::partial_truth_table, aig_resyn_static_params_for_sim_resub<resub_view_t>>;
 
     if ( ps.odc_levels != 0 )
     {
       using validator_t = circuit_validator<resub_view_t, bill::solvers::bsat2, false, true, true>;
-      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t>>;
+      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t, uint32_t, Simulator>>;
       detail::sim_resubstitution_run<resub_view_t, resub_impl_t>( resub_view, ps, pst );
     }
     else
     {
       using validator_t = circuit_validator<resub_view_t, bill::solvers::bsat2, false, true, false>;
-      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t>>;
+      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t, uint32_t, Simulator>>;
       detail::sim_resubstitution_run<resub_view_t, resub_impl_t>( resub_view, ps, pst );
     }
   }
-  else if constexpr ( std::is_same_v<typename Ntk::base_type, xag_network> )
+  else if constexpr ( is_xag_network_type_v<Ntk> )
   {
     using resyn_engine_t = xag_resyn_decompose<kitty::partial_truth_table, xag_resyn_static_params_for_sim_resub<resub_view_t>>;
 
     if ( ps.odc_levels != 0 )
     {
       using validator_t = circuit_validator<resub_view_t, bill::solvers::bsat2, false, true, true>;
-      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t>>;
+      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t, uint32_t, Simulator>>;
       detail::sim_resubstitution_run<resub_view_t, resub_impl_t>( resub_view, ps, pst );
     }
     else
     {
       using validator_t = circuit_validator<resub_view_t, bill::solvers::bsat2, false, true, false>;
-      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t>>;
+      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t, uint32_t, Simulator>>;
       detail::sim_resubstitution_run<resub_view_t, resub_impl_t>( resub_view, ps, pst );
     }
   }
@@ -417,13 +422,13 @@ void sim_resubstitution( Ntk& ntk, resubstitution_params const& ps = {}, resubst
     if ( ps.odc_levels != 0 )
     {
       using validator_t = circuit_validator<resub_view_t, bill::solvers::bsat2, false, true, true>;
-      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t>>;
+      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t, uint32_t, Simulator>>;
       detail::sim_resubstitution_run<resub_view_t, resub_impl_t>( resub_view, ps, pst );
     }
     else
     {
       using validator_t = circuit_validator<resub_view_t, bill::solvers::bsat2, false, true, false>;
-      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t>>;
+      using resub_impl_t = typename detail::resubstitution_impl<resub_view_t, typename detail::simulation_based_resub_engine<resub_view_t, validator_t, resyn_engine_t, uint32_t, Simulator>>;
       detail::sim_resubstitution_run<resub_view_t, resub_impl_t>( resub_view, ps, pst );
     }
   }
@@ -35,13 +35,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
+#include <limits>
 #include <random>
 #include <vector>
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/pattern_file.hpp"
 
 #include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
@@ -210,6 +213,11 @@ public:
    *
    * The simulation pattern file should contain `num_pis` lines of the same length.
    * Each line is the simulation signature of a primary input, represented in hexadecimal.
+   * Binary pattern files (see `write_patterns_binary`) are detected and mapped
+   * into memory instead, such that the words are copied without parsing.
+   * If a binary pattern file is truncated or its header is corrupt, no
+   * patterns are read and the simulator has no primary inputs (`num_pis()`
+   * returns 0).
    *
    * \param filename Name of the simulation pattern file.
    * \param length Number of simulation patterns to keep. Should not be greater than 4 times
@@ -217,6 +225,28 @@ public:
    */
   partial_simulator( const std::string& filename, uint32_t length = 0u )
   {
+    if ( pattern_file::is_pattern_file( filename ) )
+    {
+      pattern_file file( filename );
+      if ( !file.is_open() || file.num_patterns() > std::numeric_limits<uint32_t>::max() )
+      {
+        num_patterns = 0u;
+        return;
+      }
+
+      num_patterns = length == 0u ? static_cast<uint32_t>( file.num_patterns() ) : length;
+      patterns.reserve( file.num_pis() );
+      for ( auto i = 0u; i < file.num_pis(); ++i )
+      {
+        patterns.emplace_back( num_patterns );
+        auto const num_words = std::min<uint64_t>( file.num_words(), patterns.back().num_blocks() );
+        std::copy( file.words( i ), file.words( i ) + num_words, patterns.back().begin() );
+        patterns.back().resize( static_cast<int>( std::min<uint64_t>( num_patterns, file.num_patterns() ) ) );
+        patterns.back().resize( num_patterns );
+      }
+      return;
+    }
+
     std::ifstream in( filename, std::ifstream::in );
     std::string line;
 
@@ -258,6 +288,12 @@ public:
     return num_patterns;
   }
 
+  /*! \brief Get the number of primary inputs. */
+  uint32_t num_pis() const
+  {
+    return static_cast<uint32_t>( patterns.size() );
+  }
+
   /*! \brief Add a pattern (primary input assignment) into the pattern set.
    *
    * \param pattern The pattern. Length should be the same as number of PIs.
@@ -282,6 +318,15 @@ public:
     return patterns;
   }
 
+  /*! \brief Get the simulation pattern of a primary input without copying it.
+   *
+   * \param index Index of the primary input.
+   */
+  kitty::partial_truth_table const& get_pattern( uint32_t index ) const
+  {
+    return patterns.at( index );
+  }
+
   template<class Ntk, bool enabled = has_EXCDC_interface_v<Ntk>, typename = std::enable_if_t<enabled>>
   void remove_CDC_patterns( Ntk const& ntk )
   {
@@ -326,7 +371,9 @@ public:
   using partial_simulator::compute_not;
   using partial_simulator::compute_pi;
   using partial_simulator::get_patterns;
+  using partial_simulator::get_pattern;
   using partial_simulator::num_bits;
+  using partial_simulator::num_pis;
 
   bit_packed_simulator() {}
 
@@ -799,7 +846,7 @@ void simulate_node( Ntk const& ntk, typename Ntk::node const& n, Container& node
   static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
   static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute specialization for kitty::partial_truth_table" );
   static_assert( has_compute_inplace_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the in-place compute specialization for kitty::partial_truth_table" );
-  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+  static_assert( std::is_base_of_v<partial_simulator, Simulator>, "This function is specialized for partial_simulator and derived simulators" );
 
   if ( node_to_value[ntk.get_node( ntk.get_constant( false ) )].num_bits() != sim.num_bits() )
   {
@@ -816,7 +863,7 @@ void simulate_node( Ntk const& ntk, typename Ntk::node const& n, Container& node
   }
 }
 
-/*! \brief Simulates a network with `partial_simulator` (or `bit_packed_simulator`).
+/*! \brief Simulates a network with `partial_simulator` (or a derived simulator such as `bit_packed_simulator`).
  *
  * This is the specialization for `partial_truth_table`.
  * This function simulates every node in the circuit.
@@ -837,7 +884,7 @@ void simulate_nodes( Ntk const& ntk, Container& node_to_value, Simulator const&
   static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
   static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute specialization for kitty::partial_truth_table" );
   static_assert( has_compute_inplace_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the in-place compute specialization for kitty::partial_truth_table" );
-  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+  static_assert( std::is_base_of_v<partial_simulator, Simulator>, "This function is specialized for partial_simulator and derived simulators" );
 
   detail::update_const_pi( ntk, node_to_value, sim );
 
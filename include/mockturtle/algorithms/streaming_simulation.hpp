@@ -0,0 +1,228 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file streaming_simulation.hpp
+  \brief Simulate networks with memory bounded by their cut width
+
+  \author Heinz Riener
+  \author Mathias Soeken
+  \author Siang-Yun (Sonia) Lee
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../views/topo_view.hpp"
+#include "simulation.hpp"
+
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for simulate_streaming. */
+struct streaming_simulation_params
+{
+  /*! \brief Number of 64-bit words of patterns simulated at once (0 for all). */
+  uint32_t chunk_words{ 0u };
+};
+
+/*! \brief Statistics for simulate_streaming. */
+struct streaming_simulation_stats
+{
+  /*! \brief Maximum number of node values alive at the same time. */
+  uint32_t max_live_values{ 0u };
+
+  /*! \brief Number of pattern chunks. */
+  uint32_t num_chunks{ 0u };
+};
+
+/*! \brief Simulates a network, freeing the value of a node after its last use.
+ *
+ * This function computes the same values as `simulate`, but visits the gates
+ * in topological order and counts the references of each node from gates and
+ * primary outputs.  The value of a node is computed when it is first needed
+ * and freed when its last fanout has been simulated, such that the number of
+ * values alive at the same time is bounded by the cut width of the
+ * topological order rather than by the size of the network.
+ *
+ * **Required network functions:**
+ * - `foreach_po`
+ * - `foreach_fanin`
+ * - `is_complemented`
+ * - `compute<SimulationType>`
+ *
+ * \param ntk Network
+ * \param sim Simulator, which implements the simulator interface
+ * \param pst Statistics
+ */
+template<class SimulationType, class Ntk, class Simulator = default_simulator<SimulationType>>
+std::vector<SimulationType> simulate_streaming( Ntk const& ntk, Simulator const& sim = Simulator(), streaming_simulation_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po function" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin function" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented function" );
+  static_assert( has_compute_v<Ntk, SimulationType>, "Ntk does not implement the compute function for SimulationType" );
+
+  topo_view<Ntk> topo{ ntk };
+
+  /* references from gates and primary outputs */
+  std::vector<uint32_t> refs( ntk.size(), 0u );
+  topo.foreach_gate( [&]( auto const& n ) {
+    topo.foreach_fanin( n, [&]( auto const& f ) {
+      ++refs[ntk.node_to_index( ntk.get_node( f ) )];
+    } );
+  } );
+  ntk.foreach_po( [&]( auto const& f ) {
+    ++refs[ntk.node_to_index( ntk.get_node( f ) )];
+  } );
+
+  std::vector<uint32_t> pi_index( ntk.size(), 0u );
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    pi_index[ntk.node_to_index( n )] = i;
+  } );
+
+  std::vector<SimulationType> values( ntk.size() );
+  std::vector<bool> computed( ntk.size(), false );
+  uint32_t num_live{ 0u }, max_live{ 0u };
+
+  /* constants and primary inputs are computed on their first use */
+  auto const value_of = [&]( auto const& n ) -> SimulationType {
+    auto const index = ntk.node_to_index( n );
+    if ( !computed[index] )
+    {
+      if ( ntk.is_constant( n ) )
+      {
+        values[index] = sim.compute_constant( ntk.constant_value( n ) );
+      }
+      else
+      {
+        values[index] = sim.compute_pi( pi_index[index] );
+      }
+      computed[index] = true;
+      max_live = std::max( max_live, ++num_live );
+    }
+    return values[index];
+  };
+  auto const release = [&]( auto const& n ) {
+    auto const index = ntk.node_to_index( n );
+    if ( --refs[index] == 0u )
+    {
+      values[index] = SimulationType();
+      --num_live;
+    }
+  };
+
+  std::vector<SimulationType> fanin_values;
+  topo.foreach_gate( [&]( auto const& n ) {
+    auto const index = ntk.node_to_index( n );
+    if ( refs[index] == 0u )
+    {
+      return;
+    }
+
+    fanin_values.clear();
+    topo.foreach_fanin( n, [&]( auto const& f ) {
+      fanin_values.push_back( value_of( ntk.get_node( f ) ) );
+    } );
+    values[index] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+    computed[index] = true;
+    max_live = std::max( max_live, ++num_live );
+
+    topo.foreach_fanin( n, [&]( auto const& f ) {
+      release( ntk.get_node( f ) );
+    } );
+  } );
+
+  std::vector<SimulationType> po_values( ntk.num_pos() );
+  ntk.foreach_po( [&]( auto const& f, auto i ) {
+    auto const value = value_of( ntk.get_node( f ) );
+    po_values[i] = ntk.is_complemented( f ) ? sim.compute_not( value ) : value;
+    release( ntk.get_node( f ) );
+  } );
+
+  if ( pst )
+  {
+    pst->max_live_values = std::max( pst->max_live_values, max_live );
+    ++pst->num_chunks;
+  }
+  return po_values;
+}
+
+/*! \brief Simulates a network on chunks of the patterns of a `partial_simulator`.
+ *
+ * The patterns are split into chunks of `ps.chunk_words` 64-bit words, which
+ * are simulated one after another with `simulate_streaming`.  Only the values
+ * of one chunk are alive at a time, hence the peak memory is proportional to
+ * the cut width of the network times the chunk size.  The returned values of
+ * the primary outputs are the same as with `simulate`.
+ *
+ * \param ntk Network
+ * \param sim Simulator providing the patterns
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk>
+std::vector<kitty::partial_truth_table> simulate_streaming( Ntk const& ntk, partial_simulator const& sim, streaming_simulation_params const& ps, streaming_simulation_stats* pst = nullptr )
+{
+  auto const num_bits = sim.num_bits();
+  auto const num_words = ( num_bits + 63u ) >> 6;
+  auto const chunk_words = ps.chunk_words == 0u ? std::max( num_words, 1u ) : ps.chunk_words;
+  if ( chunk_words >= num_words )
+  {
+    return simulate_streaming<kitty::partial_truth_table>( ntk, sim, pst );
+  }
+
+  std::vector<kitty::partial_truth_table> po_values( ntk.num_pos(), kitty::partial_truth_table( num_bits ) );
+  for ( auto begin = 0u; begin < num_words; begin += chunk_words )
+  {
+    auto const end = std::min( begin + chunk_words, num_words );
+    auto const chunk_bits = std::min( num_bits, end << 6 ) - ( begin << 6 );
+
+    std::vector<kitty::partial_truth_table> patterns;
+    patterns.reserve( ntk.num_pis() );
+    for ( auto i = 0u; i < ntk.num_pis(); ++i )
+    {
+      auto const& pattern = sim.get_pattern( i );
+      kitty::partial_truth_table chunk( chunk_bits );
+      std::copy( pattern._bits.begin() + begin, pattern._bits.begin() + end, chunk._bits.begin() );
+      patterns.push_back( chunk );
+    }
+
+    auto const chunk_values = simulate_streaming<kitty::partial_truth_table>( ntk, partial_simulator( patterns ), pst );
+    for ( auto i = 0u; i < po_values.size(); ++i )
+    {
+      std::copy( chunk_values[i]._bits.begin(), chunk_values[i]._bits.end(), po_values[i]._bits.begin() + begin );
+    }
+  }
+  return po_values;
+}
+
+} // namespace mockturtle
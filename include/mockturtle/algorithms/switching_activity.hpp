@@ -0,0 +1,532 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file switching_activity.hpp
+  \brief Cached and incremental switching activity estimation
+
+  \author Alessandro Tempia Calvino
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "parallel_simulation.hpp"
+#include "simulation.hpp"
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for switching_activity_engine.
+ *
+ * Without input statistics, every primary input is 1 with probability 0.5
+ * and the patterns are the same as the ones of `partial_simulator` with the
+ * given seed, such that the activities equal the ones computed by
+ * `detail::switching_activity`.
+ */
+struct switching_activity_params
+{
+  /*! \brief Number of simulated input vectors. */
+  uint32_t num_patterns{ 2048u };
+
+  /*! \brief Probability of each primary input to be 1 (empty: 0.5). */
+  std::vector<double> input_probabilities{};
+
+  /*! \brief Probability of each primary input to toggle between two
+   * consecutive input vectors (empty: temporally independent inputs).
+   *
+   * The toggle rate of an input with probability `p` cannot exceed
+   * `2 * min( p, 1 - p )`.
+   */
+  std::vector<double> toggle_rates{};
+
+  /*! \brief Number of threads used for simulation and counting. */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Seed of the random patterns. */
+  std::default_random_engine::result_type seed{ 1u };
+};
+
+/*! \brief Statistics for switching_activity_engine. */
+struct switching_activity_stats
+{
+  /*! \brief Time for simulation. */
+  stopwatch<>::duration time_simulation{ 0 };
+
+  /*! \brief Time for counting toggles. */
+  stopwatch<>::duration time_count{ 0 };
+
+  /*! \brief Number of simulations of the whole network. */
+  uint32_t num_full_updates{ 0 };
+
+  /*! \brief Number of incremental updates. */
+  uint32_t num_incremental_updates{ 0 };
+
+  /*! \brief Number of gates re-simulated by incremental updates. */
+  uint64_t num_resimulated{ 0 };
+
+  /*! \brief Number of gates whose values changed in incremental updates. */
+  uint64_t num_changed{ 0 };
+};
+
+/*! \brief Estimates and caches the switching activity of all nodes.
+ *
+ * The switching activity of a node is the probability that its value
+ * changes between two consecutive input vectors.  The engine simulates
+ * `num_patterns` random input vectors once and keeps the values and the
+ * activities of all nodes.  If toggle rates are given, each primary input
+ * is simulated on two consecutive frames whose correlation matches the
+ * toggle rate, and the activity of a node is the fraction of vectors on
+ * which its value toggles between the frames.  Otherwise, the inputs are
+ * temporally independent and the activity of a node with signal
+ * probability `p` is `2 p (1 - p)`.
+ *
+ * The engine listens to the events of the network.  After nodes are added
+ * or substituted, e.g., while mapping, the next query only re-simulates the
+ * modified nodes and the nodes whose fanin values changed.
+ *
+ * **Required network functions:**
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `compute`
+ * - `events`
+ *
+ * **Example**
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      switching_activity_params ps;
+      ps.toggle_rates.assign( aig.num_pis(), 0.1 );
+      switching_activity_engine engine( aig, ps );
+
+      float const a = engine.activity( n );
+      aig.substitute_node( old_node, g ); // nothing is simulated yet
+      double const p = engine.power();    // re-simulates what changed
+   \endverbatim
+ */
+template<class Ntk>
+class switching_activity_engine
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit switching_activity_engine( Ntk const& ntk, switching_activity_params const& ps = {} )
+      : _ntk( ntk ), _ps( ps )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+
+    assert( _ps.num_patterns > 0u );
+    register_events();
+  }
+
+  switching_activity_engine( switching_activity_engine const& ) = delete;
+  switching_activity_engine& operator=( switching_activity_engine const& ) = delete;
+
+  ~switching_activity_engine()
+  {
+    release_events();
+  }
+
+  /*! \brief Returns the switching activity of a node. */
+  float activity( node const& n )
+  {
+    update();
+    return _activities[_ntk.node_to_index( n )];
+  }
+
+  /*! \brief Returns the switching activities of all nodes, indexed by `node_to_index`. */
+  std::vector<float> const& activities()
+  {
+    update();
+    return _activities;
+  }
+
+  /*! \brief Returns the sum of activity times load over all gates. */
+  template<class Fn>
+  double power( Fn&& load )
+  {
+    update();
+
+    double power{ 0.0 };
+    _ntk.foreach_gate( [&]( auto const& n ) {
+      power += _activities[_ntk.node_to_index( n )] * load( n );
+    } );
+    return power;
+  }
+
+  /*! \brief Returns the sum of activity times fanout size over all gates. */
+  double power()
+  {
+    static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+    return power( [&]( auto const& n ) { return static_cast<double>( _ntk.fanout_size( n ) ); } );
+  }
+
+  /*! \brief Brings the activities up to date with the network. */
+  void update()
+  {
+    if ( _values.empty() || _ntk.num_pis() != _num_pis )
+    {
+      full_update();
+    }
+    else if ( _stale )
+    {
+      incremental_update();
+    }
+  }
+
+  /*! \brief Discards all cached values, the next query simulates the whole network. */
+  void reset()
+  {
+    _values.clear();
+    _activities.clear();
+  }
+
+  /*! \brief Whether a query would simulate anything. */
+  bool is_up_to_date() const
+  {
+    return !_values.empty() && !_stale && _ntk.num_pis() == _num_pis;
+  }
+
+  switching_activity_params const& params() const
+  {
+    return _ps;
+  }
+
+  switching_activity_stats const& stats() const
+  {
+    return _st;
+  }
+
+private:
+  std::vector<kitty::partial_truth_table> generate_patterns() const
+  {
+    auto const num_pis = _ntk.num_pis();
+    auto const num_patterns = _ps.num_patterns;
+    assert( _ps.input_probabilities.empty() || _ps.input_probabilities.size() == num_pis );
+    assert( _ps.toggle_rates.empty() || _ps.toggle_rates.size() == num_pis );
+
+    if ( _ps.input_probabilities.empty() && _ps.toggle_rates.empty() )
+    {
+      return partial_simulator( num_pis, num_patterns, _ps.seed ).get_patterns();
+    }
+
+    /* with toggle rates, the second frame starts at word `frame_words` */
+    uint32_t const frame_words = ( num_patterns + 63u ) >> 6;
+    uint32_t const num_bits = _ps.toggle_rates.empty() ? num_patterns : frame_words * 128u;
+
+    std::mt19937 rng( _ps.seed );
+    std::uniform_real_distribution<double> dist( 0.0, 1.0 );
+    std::vector<kitty::partial_truth_table> patterns( num_pis, kitty::partial_truth_table( num_bits ) );
+    for ( auto i = 0u; i < num_pis; ++i )
+    {
+      double const p = _ps.input_probabilities.empty() ? 0.5 : _ps.input_probabilities[i];
+      for ( auto j = 0u; j < num_patterns; ++j )
+      {
+        if ( dist( rng ) < p )
+        {
+          kitty::set_bit( patterns[i], j );
+        }
+      }
+      if ( _ps.toggle_rates.empty() )
+      {
+        continue;
+      }
+
+      /* flip ones and zeros with rates that keep the signal probability */
+      double const t = _ps.toggle_rates[i];
+      assert( t >= 0.0 && t <= 2.0 * std::min( p, 1.0 - p ) + 1e-9 );
+      double const rise = p < 1.0 ? t / ( 2.0 * ( 1.0 - p ) ) : 0.0;
+      double const fall = p > 0.0 ? t / ( 2.0 * p ) : 0.0;
+      for ( auto j = 0u; j < num_patterns; ++j )
+      {
+        bool const value = kitty::get_bit( patterns[i], j );
+        if ( value != ( dist( rng ) < ( value ? fall : rise ) ) )
+        {
+          kitty::set_bit( patterns[i], frame_words * 64u + j );
+        }
+      }
+    }
+    return patterns;
+  }
+
+  void full_update()
+  {
+    _num_pis = _ntk.num_pis();
+    _values.clear();
+    _values.resize( _ntk.size() );
+    _dirty.assign( _ntk.size(), false );
+    _stale = false;
+
+    call_with_stopwatch( _st.time_simulation, [&]() {
+      parallel_simulator sim( generate_patterns() );
+      sim.set_num_threads( _ps.num_threads );
+
+      unordered_node_map<kitty::partial_truth_table, Ntk> tts( _ntk );
+      simulate_nodes( _ntk, tts, sim, true );
+      _ntk.foreach_node( [&]( auto const& n ) {
+        if ( tts.has( n ) )
+        {
+          _values[_ntk.node_to_index( n )] = std::move( tts[n] );
+        }
+      } );
+    } );
+
+    _activities.assign( _ntk.size(), 0.0f );
+    std::vector<uint32_t> indices;
+    _ntk.foreach_node( [&]( auto const& n ) {
+      indices.push_back( _ntk.node_to_index( n ) );
+    } );
+    count_toggles( indices );
+
+    ++_st.num_full_updates;
+  }
+
+  void incremental_update()
+  {
+    auto const size = _ntk.size();
+    _values.resize( size );
+    _activities.resize( size, 0.0f );
+    _dirty.resize( size, true );
+
+    std::vector<uint32_t> changed_indices;
+    call_with_stopwatch( _st.time_simulation, [&]() {
+      std::vector<bool> changed( size, false );
+      for ( auto const& n : topological_gates() )
+      {
+        auto const index = _ntk.node_to_index( n );
+        bool resimulate = _dirty[index];
+        _ntk.foreach_fanin( n, [&]( auto const& f ) {
+          resimulate = resimulate || changed[_ntk.node_to_index( _ntk.get_node( f ) )];
+        } );
+        if ( !resimulate )
+        {
+          continue;
+        }
+
+        std::vector<kitty::partial_truth_table> fanin_values( _ntk.fanin_size( n ) );
+        _ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+          fanin_values[i] = _values[_ntk.node_to_index( _ntk.get_node( f ) )];
+        } );
+        auto value = _ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+        ++_st.num_resimulated;
+
+        if ( value != _values[index] )
+        {
+          _values[index] = std::move( value );
+          changed[index] = true;
+          changed_indices.push_back( index );
+        }
+      }
+    } );
+
+    count_toggles( changed_indices );
+    _st.num_changed += changed_indices.size();
+    ++_st.num_incremental_updates;
+
+    std::fill( _dirty.begin(), _dirty.end(), false );
+    _stale = false;
+  }
+
+  /* all gates in topological order, since substitutions may break the order of the indexes */
+  std::vector<node> topological_gates() const
+  {
+    std::vector<node> order;
+    std::vector<uint8_t> color( _ntk.size(), 0u );
+    std::vector<node> stack;
+
+    _ntk.foreach_gate( [&]( auto const& root ) {
+      stack.push_back( root );
+      while ( !stack.empty() )
+      {
+        auto const n = stack.back();
+        auto& c = color[_ntk.node_to_index( n )];
+        if ( c == 2u )
+        {
+          stack.pop_back();
+        }
+        else if ( c == 1u )
+        {
+          c = 2u;
+          order.push_back( n );
+          stack.pop_back();
+        }
+        else
+        {
+          c = 1u;
+          _ntk.foreach_fanin( n, [&]( auto const& f ) {
+            auto const child = _ntk.get_node( f );
+            if ( !_ntk.is_constant( child ) && !_ntk.is_ci( child ) && color[_ntk.node_to_index( child )] == 0u )
+            {
+              stack.push_back( child );
+            }
+          } );
+        }
+      }
+    } );
+
+    return order;
+  }
+
+  void count_toggles( std::vector<uint32_t> const& indices )
+  {
+    call_with_stopwatch( _st.time_count, [&]() {
+      auto const count = [&]( uint64_t begin, uint64_t end ) {
+        for ( auto i = begin; i < end; ++i )
+        {
+          _activities[indices[i]] = activity_of( _values[indices[i]] );
+        }
+      };
+
+      /* values are counted independently, a few thousands per thread pay off */
+      uint64_t const num_threads = std::min<uint64_t>( std::max( 1u, _ps.num_threads ), indices.size() / 4096u + 1u );
+      if ( num_threads == 1u )
+      {
+        count( 0u, indices.size() );
+        return;
+      }
+
+      std::vector<std::thread> threads;
+      for ( auto t = 0u; t < num_threads; ++t )
+      {
+        threads.emplace_back( count, indices.size() * t / num_threads, indices.size() * ( t + 1u ) / num_threads );
+      }
+      for ( auto& thread : threads )
+      {
+        thread.join();
+      }
+    } );
+  }
+
+  float activity_of( kitty::partial_truth_table const& tt ) const
+  {
+    auto const simulation_size = _ps.num_patterns;
+    if ( tt.num_bits() == 0u )
+    {
+      return 0.0f;
+    }
+
+    if ( _ps.toggle_rates.empty() )
+    {
+      float ones = static_cast<float>( kitty::count_ones( tt ) );
+      float activity = 2.0 * ones / simulation_size * ( simulation_size - ones ) / simulation_size;
+      return activity;
+    }
+
+    /* toggles between the two frames */
+    auto const frame_words = tt.num_blocks() / 2u;
+    uint64_t toggles{ 0u };
+    for ( auto i = 0u; i < frame_words; ++i )
+    {
+      auto word = tt._bits[i] ^ tt._bits[i + frame_words];
+      if ( i + 1u == frame_words && ( simulation_size & 63u ) != 0u )
+      {
+        word &= ( uint64_t( 1u ) << ( simulation_size & 63u ) ) - 1u;
+      }
+      toggles += __builtin_popcount( static_cast<uint32_t>( word & 0xffffffff ) ) + __builtin_popcount( static_cast<uint32_t>( word >> 32 ) );
+    }
+    return static_cast<float>( static_cast<double>( toggles ) / simulation_size );
+  }
+
+  void mark( node const& n )
+  {
+    auto const index = _ntk.node_to_index( n );
+    if ( index >= _dirty.size() )
+    {
+      _dirty.resize( index + 1u, true );
+    }
+    _dirty[index] = true;
+    _stale = true;
+  }
+
+  void register_events()
+  {
+    _add_event = _ntk.events().register_add_event( [this]( auto const& n ) {
+      mark( n );
+    } );
+
+    _modified_event = _ntk.events().register_modified_event( [this]( auto const& n, auto const& previous ) {
+      (void)previous;
+      mark( n );
+    } );
+
+    _delete_event = _ntk.events().register_delete_event( [this]( auto const& n ) {
+      auto const index = _ntk.node_to_index( n );
+      if ( index < _values.size() )
+      {
+        _values[index] = kitty::partial_truth_table();
+        _activities[index] = 0.0f;
+      }
+      _stale = true;
+    } );
+  }
+
+  void release_events()
+  {
+    _ntk.events().release_add_event( _add_event );
+    _ntk.events().release_modified_event( _modified_event );
+    _ntk.events().release_delete_event( _delete_event );
+  }
+
+private:
+  Ntk const& _ntk;
+  switching_activity_params _ps;
+  switching_activity_stats _st;
+
+  uint32_t _num_pis{ 0u };
+  std::vector<kitty::partial_truth_table> _values;
+  std::vector<float> _activities;
+  std::vector<bool> _dirty;
+  bool _stale{ false };
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> _add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> _modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> _delete_event;
+};
+
+} // namespace mockturtle
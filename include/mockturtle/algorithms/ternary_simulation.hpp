@@ -0,0 +1,393 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*!
+  \file ternary_simulation.hpp
+  \brief Bit-parallel three-valued simulation with unknown values
+
+  \author Heinz Riener
+  \author Mathias Soeken
+  \author Siang-Yun (Sonia) Lee
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "compiled_simulation.hpp"
+#include "simulation.hpp"
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Three-valued (0, 1, X) simulation values in dual-rail encoding.
+ *
+ * Bit `i` of `zeros` is set if the `i`-th pattern may evaluate to 0, and bit
+ * `i` of `ones` is set if it may evaluate to 1.  Hence, 0 is encoded as
+ * (1, 0), 1 as (0, 1), and the unknown value X as (1, 1).
+ */
+struct ternary_truth_table
+{
+  ternary_truth_table() = default;
+
+  /*! \brief Creates `num_bits` patterns with value 0. */
+  explicit ternary_truth_table( uint32_t num_bits )
+      : zeros( ~kitty::partial_truth_table( num_bits ) ), ones( num_bits )
+  {
+  }
+
+  /*! \brief Creates patterns from values and a mask of known bits. */
+  ternary_truth_table( kitty::partial_truth_table const& values, kitty::partial_truth_table const& known )
+      : zeros( ~values | ~known ), ones( values | ~known )
+  {
+  }
+
+  uint32_t num_bits() const
+  {
+    return zeros.num_bits();
+  }
+
+  /*! \brief Patterns with a known value. */
+  kitty::partial_truth_table known() const
+  {
+    return zeros ^ ones;
+  }
+
+  /*! \brief Whether the value of the `index`-th pattern is X. */
+  bool is_unknown( uint32_t index ) const
+  {
+    return kitty::get_bit( zeros, index ) && kitty::get_bit( ones, index );
+  }
+
+  /*! \brief Whether the `index`-th pattern is 1 (false if it is 0 or X). */
+  bool is_one( uint32_t index ) const
+  {
+    return !kitty::get_bit( zeros, index ) && kitty::get_bit( ones, index );
+  }
+
+  ternary_truth_table operator~() const
+  {
+    ternary_truth_table result;
+    result.zeros = ones;
+    result.ones = zeros;
+    return result;
+  }
+
+  bool operator==( ternary_truth_table const& other ) const
+  {
+    return zeros == other.zeros && ones == other.ones;
+  }
+
+  bool operator!=( ternary_truth_table const& other ) const
+  {
+    return !( *this == other );
+  }
+
+  kitty::partial_truth_table zeros;
+  kitty::partial_truth_table ones;
+};
+
+/*! \brief Simulates patterns in which some primary inputs are unknown.
+ *
+ * The simulator computes `ternary_truth_table`s with
+ * `simulate_nodes<ternary_truth_table>( ntk, sim )` or
+ * `simulate_nodes( ntk, node_to_value, sim )`.  A node evaluates to X in a
+ * pattern if its value may depend on the unknown inputs.  The propagation of
+ * X values is conservative: reconvergent paths may result in X even if the
+ * value does not depend on the unknown inputs.
+ */
+class ternary_simulator
+{
+public:
+  ternary_simulator() = default;
+
+  /*! \brief Creates a simulator with `num_patterns` unknown patterns. */
+  ternary_simulator( uint32_t num_pis, uint32_t num_patterns )
+      : patterns( num_pis, ternary_truth_table( kitty::partial_truth_table( num_patterns ), kitty::partial_truth_table( num_patterns ) ) ), num_patterns( num_patterns )
+  {
+  }
+
+  /*! \brief Creates a simulator with the (known) patterns of a `partial_simulator`. */
+  explicit ternary_simulator( partial_simulator const& sim )
+      : num_patterns( sim.num_bits() )
+  {
+    auto const& values = sim.get_patterns();
+    for ( auto const& value : values )
+    {
+      patterns.emplace_back( value, ~kitty::partial_truth_table( sim.num_bits() ) );
+    }
+  }
+
+  /*! \brief Creates a simulator from values and masks of known bits, one for each primary input. */
+  ternary_simulator( std::vector<kitty::partial_truth_table> const& values, std::vector<kitty::partial_truth_table> const& known )
+      : num_patterns( values.at( 0 ).num_bits() )
+  {
+    assert( values.size() == known.size() );
+    for ( auto i = 0u; i < values.size(); ++i )
+    {
+      patterns.emplace_back( values[i], known[i] );
+    }
+  }
+
+  ternary_truth_table compute_constant( bool value ) const
+  {
+    ternary_truth_table zero( num_patterns );
+    return value ? ~zero : zero;
+  }
+
+  ternary_truth_table compute_pi( uint32_t index ) const
+  {
+    return patterns.at( index );
+  }
+
+  ternary_truth_table compute_not( ternary_truth_table const& value ) const
+  {
+    return ~value;
+  }
+
+  uint32_t num_bits() const
+  {
+    return num_patterns;
+  }
+
+  /*! \brief Adds a pattern, in which the `i`-th input is X if `known[i]` is false. */
+  void add_pattern( std::vector<bool> const& pattern, std::vector<bool> const& known )
+  {
+    assert( pattern.size() == patterns.size() && known.size() == patterns.size() );
+
+    for ( auto i = 0u; i < pattern.size(); ++i )
+    {
+      patterns[i].zeros.add_bit( !known[i] || !pattern[i] );
+      patterns[i].ones.add_bit( !known[i] || pattern[i] );
+    }
+    ++num_patterns;
+  }
+
+  /*! \brief Sets the value of the `index`-th input in the `bit`-th pattern to X. */
+  void set_unknown( uint32_t index, uint32_t bit )
+  {
+    kitty::set_bit( patterns.at( index ).zeros, bit );
+    kitty::set_bit( patterns.at( index ).ones, bit );
+  }
+
+private:
+  std::vector<ternary_truth_table> patterns;
+  uint32_t num_patterns{ 0u };
+};
+
+namespace detail
+{
+
+inline ternary_truth_table ternary_and( ternary_truth_table const& a, ternary_truth_table const& b )
+{
+  ternary_truth_table result;
+  result.zeros = a.zeros | b.zeros;
+  result.ones = a.ones & b.ones;
+  return result;
+}
+
+inline ternary_truth_table ternary_xor( ternary_truth_table const& a, ternary_truth_table const& b )
+{
+  ternary_truth_table result;
+  result.zeros = ( a.zeros & b.zeros ) | ( a.ones & b.ones );
+  result.ones = ( a.zeros & b.ones ) | ( a.ones & b.zeros );
+  return result;
+}
+
+inline ternary_truth_table ternary_maj( ternary_truth_table const& a, ternary_truth_table const& b, ternary_truth_table const& c )
+{
+  ternary_truth_table result;
+  result.zeros = ( a.zeros & b.zeros ) | ( a.zeros & c.zeros ) | ( b.zeros & c.zeros );
+  result.ones = ( a.ones & b.ones ) | ( a.ones & c.ones ) | ( b.ones & c.ones );
+  return result;
+}
+
+inline ternary_truth_table ternary_mux( ternary_truth_table const& s, ternary_truth_table const& t, ternary_truth_table const& e )
+{
+  ternary_truth_table result;
+  result.zeros = ( s.ones & t.zeros ) | ( s.zeros & e.zeros );
+  result.ones = ( s.ones & t.ones ) | ( s.zeros & e.ones );
+  return result;
+}
+
+/* a pattern may evaluate to 0 (1) if it may match a minterm of the offset (onset) */
+inline ternary_truth_table ternary_lut( kitty::dynamic_truth_table const& function, std::vector<ternary_truth_table> const& fanins, uint32_t num_bits )
+{
+  ternary_truth_table result;
+  result.zeros = kitty::partial_truth_table( num_bits );
+  result.ones = kitty::partial_truth_table( num_bits );
+  for ( auto m = 0u; m < function.num_bits(); ++m )
+  {
+    auto cube = ~kitty::partial_truth_table( num_bits );
+    for ( auto i = 0u; i < fanins.size(); ++i )
+    {
+      cube &= ( ( m >> i ) & 1u ) ? fanins[i].ones : fanins[i].zeros;
+    }
+    if ( kitty::get_bit( function, m ) )
+    {
+      result.ones |= cube;
+    }
+    else
+    {
+      result.zeros |= cube;
+    }
+  }
+  return result;
+}
+
+template<class Ntk>
+ternary_truth_table compute_ternary( Ntk const& ntk, node<Ntk> const& n, std::vector<ternary_truth_table> fanin_values, uint32_t num_bits )
+{
+  ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+    if ( ntk.is_complemented( f ) )
+    {
+      fanin_values[i] = ~fanin_values[i];
+    }
+  } );
+
+  switch ( compiled_opcode_of( ntk, n, static_cast<uint32_t>( fanin_values.size() ) ) )
+  {
+  case compiled_opcode::and2:
+    return ternary_and( fanin_values[0], fanin_values[1] );
+  case compiled_opcode::xor2:
+    return ternary_xor( fanin_values[0], fanin_values[1] );
+  case compiled_opcode::maj3:
+    return ternary_maj( fanin_values[0], fanin_values[1], fanin_values[2] );
+  case compiled_opcode::xor3:
+    return ternary_xor( ternary_xor( fanin_values[0], fanin_values[1] ), fanin_values[2] );
+  case compiled_opcode::mux:
+    return ternary_mux( fanin_values[0], fanin_values[1], fanin_values[2] );
+  default:
+    return ternary_lut( ntk.node_function( n ), fanin_values, num_bits );
+  }
+}
+
+template<class Ntk, class Container, class HasFn>
+void simulate_nodes_ternary( Ntk const& ntk, Container& node_to_value, ternary_simulator const& sim, HasFn&& has )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
+
+  /* constants */
+  if ( !has( ntk.get_node( ntk.get_constant( false ) ) ) )
+  {
+    node_to_value[ntk.get_node( ntk.get_constant( false ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( false ) ) ) );
+  }
+  if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+  {
+    if ( !has( ntk.get_node( ntk.get_constant( true ) ) ) )
+    {
+      node_to_value[ntk.get_node( ntk.get_constant( true ) )] = sim.compute_constant( ntk.constant_value( ntk.get_node( ntk.get_constant( true ) ) ) );
+    }
+  }
+
+  /* pis */
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    if ( !has( n ) )
+    {
+      node_to_value[n] = sim.compute_pi( i );
+    }
+  } );
+
+  /* gates */
+  ntk.foreach_gate( [&]( auto const& n ) {
+    if ( !has( n ) )
+    {
+      std::vector<ternary_truth_table> fanin_values( ntk.fanin_size( n ) );
+      ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanin_values[i] = node_to_value[ntk.get_node( f )];
+      } );
+      node_to_value[n] = compute_ternary( ntk, n, std::move( fanin_values ), sim.num_bits() );
+    }
+  } );
+}
+
+} // namespace detail
+
+/*! \brief Simulates a network with `ternary_simulator`.
+ *
+ * Returns a map with the three-valued simulation values of all nodes.  The
+ * gates are evaluated in the order of `foreach_gate`, and AND, XOR,
+ * majority, XOR3, and if-then-else gates are recognized by the corresponding
+ * `is_*` methods; all other gates are evaluated from their `node_function`.
+ *
+ * **Required network functions:**
+ * - `get_constant`
+ * - `constant_value`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `node_function`
+ *
+ * \param ntk Network
+ * \param sim Ternary simulator
+ */
+template<class SimulationType, class Ntk>
+node_map<SimulationType, Ntk> simulate_nodes( Ntk const& ntk, ternary_simulator const& sim )
+{
+  static_assert( std::is_same_v<SimulationType, ternary_truth_table>, "ternary_simulator computes ternary_truth_table" );
+
+  node_map<SimulationType, Ntk> node_to_value( ntk );
+  detail::simulate_nodes_ternary( ntk, node_to_value, sim, []( auto const& ) { return false; } );
+  return node_to_value;
+}
+
+/*! \brief Simulates a network with `ternary_simulator`.
+ *
+ * Only nodes without a value in `node_to_value` are simulated.  In
+ * particular, a node can be set to X before the simulation to compute which
+ * patterns observe it.
+ */
+template<class Ntk>
+void simulate_nodes( Ntk const& ntk, unordered_node_map<ternary_truth_table, Ntk>& node_to_value, ternary_simulator const& sim )
+{
+  detail::simulate_nodes_ternary( ntk, node_to_value, sim, [&]( auto const& n ) { return node_to_value.has( n ); } );
+}
+
+/*! \brief Simulates a network with `ternary_simulator`.
+ *
+ * Only nodes without a value in `node_to_value` are simulated.
+ */
+template<class Ntk>
+void simulate_nodes( Ntk const& ntk, incomplete_node_map<ternary_truth_table, Ntk>& node_to_value, ternary_simulator const& sim )
+{
+  detail::simulate_nodes_ternary( ntk, node_to_value, sim, [&]( auto const& n ) { return node_to_value.has( n ); } );
+}
+
+} // namespace mockturtle
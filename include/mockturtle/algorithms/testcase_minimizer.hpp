@@ -36,6 +36,7 @@
 #include "../io/write_verilog.hpp"
 #include "../networks/aig.hpp"
 #include "../utils/debugging_utils.hpp"
+#include "../utils/network_utils.hpp"
 #include "../views/color_view.hpp"
 #include "cleanup.hpp"
 
@@ -166,7 +167,7 @@ public:
     uint32_t counter{ 0 };
     while ( !ps.num_iterations || counter++ < ps.num_iterations )
     {
-      ntk_backup2 = cleanup_dangling( ntk );
+      ntk_backup2 = snapshot_network( ntk );
       if ( !reduce() )
       {
         write_testcase( ps.minimized_case );
@@ -175,7 +176,7 @@ public:
       if ( ntk.num_gates() == 0 )
       {
         ++stage_counter;
-        ntk = ntk_backup2;
+        rollback_network( ntk, ntk_backup2 );
         continue;
       }
 
@@ -189,7 +190,7 @@ public:
       else
       {
         ++stage_counter;
-        ntk = ntk_backup2;
+        rollback_network( ntk, ntk_backup2 );
       }
     }
 
@@ -217,7 +218,7 @@ public:
     uint32_t counter{ 0 };
     while ( !ps.num_iterations || counter++ < ps.num_iterations )
     {
-      ntk_backup2 = cleanup_dangling( ntk );
+      ntk_backup2 = snapshot_network( ntk );
       if ( !reduce() )
       {
         break;
@@ -225,7 +226,7 @@ public:
       if ( ntk.num_gates() == 0 )
       {
         ++stage_counter;
-        ntk = ntk_backup2;
+        rollback_network( ntk, ntk_backup2 );
         continue;
       }
 
@@ -233,6 +234,7 @@ public:
 
       if ( test( make_command, "tmp" ) )
       {
+        ntk = cleanup_dangling( ntk );
         fmt::print( "[i] Testcase with I/O = {}/{} gates = {} triggers the buggy behavior\n", ntk.num_pis(), ntk.num_pos(), ntk.num_gates() );
         write_testcase( ps.minimized_case );
         stage_counter = 0;
@@ -241,7 +243,7 @@ public:
       else
       {
         ++stage_counter;
-        ntk = ntk_backup2;
+        rollback_network( ntk, ntk_backup2 );
       }
     }
 
@@ -299,9 +301,10 @@ private:
 
   bool test( std::function<bool( Ntk )> const& fn )
   {
-    ntk_backup = cleanup_dangling( ntk );
+    ntk = cleanup_dangling( ntk );
+    ntk_backup = snapshot_network( ntk );
     bool res = fn( ntk );
-    ntk = ntk_backup;
+    rollback_network( ntk, ntk_backup );
     was_FIT = !res;
     return was_FIT;
   }
@@ -479,7 +479,7 @@ private:
       mark_tfo( fanout_win, root );
 
       /* exclude constant node */
-      if constexpr ( std::is_same_v<typename NtkWin::base_type, aig_network> || std::is_same_v<typename NtkWin::base_type, xag_network> )
+      if constexpr ( is_aig_network_type_v<NtkWin> || is_xag_network_type_v<NtkWin> )
       {
         win.set_visited( win.get_node( win.get_constant( false ) ), win.trav_id() );
       }
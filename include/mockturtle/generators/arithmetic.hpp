@@ -82,7 +82,7 @@ inline std::pair<signal<Ntk>, signal<Ntk>> full_adder( Ntk& ntk, const signal<Nt
     return { sum, carry };
   }
   /* use MAJ and XOR3 if available by network, unless network is AIG */
-  else if constexpr ( !std::is_same_v<typename Ntk::base_type, aig_network> && has_create_maj_v<Ntk> && has_create_xor3_v<Ntk> )
+  else if constexpr ( !is_aig_network_type_v<Ntk> && has_create_maj_v<Ntk> && has_create_xor3_v<Ntk> )
   {
     const auto carry = ntk.create_maj( a, b, c );
     const auto sum = ntk.create_xor3( a, b, c );
@@ -37,6 +37,7 @@
 #include "../networks/aig.hpp"
 #include "../networks/sequential.hpp"
 #include "../traits.hpp"
+#include "../utils/network_builder.hpp"
 #include <lorina/aiger.hpp>
 
 namespace mockturtle
@@ -72,7 +73,7 @@ template<typename Ntk>
 class aiger_reader : public lorina::aiger_reader
 {
 public:
-  explicit aiger_reader( Ntk& ntk ) : _ntk( ntk )
+  explicit aiger_reader( Ntk& ntk ) : _ntk( ntk ), _builder( ntk )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi function" );
@@ -84,11 +85,14 @@ public:
 
   ~aiger_reader()
   {
+    /* merge structurally equivalent gates */
+    _builder.finalize();
+
     uint32_t output_id{ 0 };
     for ( auto out : outputs )
     {
       auto const lit = std::get<0>( out );
-      auto signal = signals[lit >> 1];
+      auto signal = _builder.resolve( signals[lit >> 1] );
       if ( lit & 1 )
       {
         signal = _ntk.create_not( signal );
@@ -111,7 +115,7 @@ public:
         auto const lit = std::get<0>( latch );
         auto const reset = std::get<1>( latch );
 
-        auto signal = signals[lit >> 1];
+        auto signal = _builder.resolve( signals[lit >> 1] );
         if ( lit & 1 )
         {
           signal = _ntk.create_not( signal );
@@ -130,7 +134,7 @@ public:
     }
   }
 
-  void on_header( uint64_t, uint64_t num_inputs, uint64_t num_latches, uint64_t, uint64_t ) const override
+  void on_header( uint64_t, uint64_t num_inputs, uint64_t num_latches, uint64_t, uint64_t num_ands ) const override
   {
     (void)num_latches;
     if constexpr ( !has_create_ri_v<Ntk> || !has_create_ro_v<Ntk> )
@@ -139,6 +143,7 @@ public:
     }
 
     _num_inputs = static_cast<uint32_t>( num_inputs );
+    _builder.reserve( 1u + num_inputs + num_latches + num_ands );
 
     /* constant */
     signals.push_back( _ntk.get_constant( false ) );
@@ -201,7 +206,7 @@ public:
       right = _ntk.create_not( right );
     }
 
-    signals.push_back( _ntk.create_and( left, right ) );
+    signals.push_back( _builder.create_and( left, right ) );
   }
 
   void on_latch( unsigned index, unsigned next, latch_init_value reset ) const override
@@ -223,6 +228,7 @@ public:
 
 private:
   Ntk& _ntk;
+  mutable network_builder<Ntk> _builder;
 
   mutable uint32_t _num_inputs{ 0 };
   mutable std::vector<std::tuple<unsigned, std::string>> outputs;
@@ -40,6 +40,7 @@
 #include <lorina/bristol.hpp>
 
 #include "../traits.hpp"
+#include "../utils/network_builder.hpp"
 
 namespace mockturtle
 {
@@ -66,7 +67,7 @@ class bristol_reader : public lorina::bristol_reader
 {
 public:
   explicit bristol_reader( Ntk& ntk )
-      : ntk_( ntk )
+      : ntk_( ntk ), builder_( ntk )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi function" );
@@ -91,6 +92,7 @@ public:
     num_gates_ = num_gates;
     gate_ctr_ = 0u;
     signal_.resize( num_wires );
+    builder_.reserve( 1u + num_pis + num_gates );
 
     for ( auto i = 0u; i < num_pis; ++i )
     {
@@ -102,11 +104,11 @@ public:
   {
     if ( gate == "XOR" )
     {
-      signal_[out] = ntk_.create_xor( signal_[in[0]], signal_[in[1]] );
+      signal_[out] = builder_.create_xor( signal_[in[0]], signal_[in[1]] );
     }
     else if ( gate == "AND" )
     {
-      signal_[out] = ntk_.create_and( signal_[in[0]], signal_[in[1]] );
+      signal_[out] = builder_.create_and( signal_[in[0]], signal_[in[1]] );
     }
     else if ( gate == "INV" )
     {
@@ -126,6 +128,13 @@ public:
 
     if ( gate_ctr_ == num_gates_ )
     {
+      /* merge structurally equivalent gates */
+      builder_.finalize();
+      for ( auto& f : signal_ )
+      {
+        f = builder_.resolve( f );
+      }
+
       for ( auto i = signal_.size() - num_pos_; i < signal_.size(); ++i )
       {
         ntk_.create_po( signal_[i] );
@@ -139,6 +148,7 @@ public:
 
 private:
   Ntk& ntk_;
+  mutable network_builder<Ntk> builder_;
 
   mutable uint32_t num_pos_;
   mutable uint32_t num_gates_;
@@ -33,15 +33,21 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
+#include <kitty/partial_truth_table.hpp>
 #include <kitty/print.hpp>
 
 #include "../algorithms/simulation.hpp"
+#include "../utils/pattern_file.hpp"
 
 namespace mockturtle
 {
@@ -51,13 +57,13 @@ namespace mockturtle
  * The output contains `num_pis()` lines, each line contains a stream of
  * simulation values of a primary input, represented in hexadecimal.
  *
- * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param sim The `partial_simulator` (or derived simulator) object containing simulation patterns
  * \param out Output stream
  */
 template<class Simulator>
 void write_patterns( Simulator const& sim, std::ostream& out = std::cout )
 {
-  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+  static_assert( std::is_base_of_v<partial_simulator, Simulator>, "This function is specialized for partial_simulator and derived simulators" );
 
   auto const& patterns = sim.get_patterns();
   for ( auto i = 0u; i < patterns.size(); ++i )
@@ -71,17 +77,260 @@ void write_patterns( Simulator const& sim, std::ostream& out = std::cout )
  * The output contains `num_pis()` lines, each line contains a stream of
  * simulation values of a primary input, represented in hexadecimal.
  *
- * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param sim The `partial_simulator` (or derived simulator) object containing simulation patterns
  * \param filename Filename
  */
 template<class Simulator>
 void write_patterns( Simulator const& sim, std::string const& filename )
 {
-  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+  static_assert( std::is_base_of_v<partial_simulator, Simulator>, "This function is specialized for partial_simulator and derived simulators" );
 
   std::ofstream os( filename.c_str(), std::ofstream::out );
   write_patterns( sim, os );
   os.close();
 }
 
+namespace detail
+{
+
+/* 64 bits of `tt` starting at bit `bit`, bits past the last block are 0 */
+inline uint64_t pattern_word_at( kitty::partial_truth_table const& tt, uint64_t bit )
+{
+  auto const block = bit >> 6;
+  auto const shift = bit & 63u;
+  uint64_t word = block < tt.num_blocks() ? tt._bits[block] >> shift : 0u;
+  if ( shift != 0u && block + 1u < tt.num_blocks() )
+  {
+    word |= tt._bits[block + 1u] << ( 64u - shift );
+  }
+  return word;
+}
+
+inline uint64_t pattern_file_stride( uint64_t num_patterns )
+{
+  auto const alignment = pattern_file_header::words_alignment;
+  auto const num_words = std::max<uint64_t>( 1u, ( num_patterns + 63u ) >> 6 );
+  return ( num_words + alignment - 1u ) / alignment * alignment;
+}
+
+inline pattern_file_header make_pattern_file_header( uint32_t num_pis, uint64_t num_patterns, uint64_t stride )
+{
+  pattern_file_header header{};
+  std::memcpy( header.magic, pattern_file_header::magic_value, 8 );
+  header.version = pattern_file_header::current_version;
+  header.num_pis = num_pis;
+  header.num_patterns = num_patterns;
+  header.stride = stride;
+  return header;
+}
+
+/* rewrites the file with a larger stride, such that `num_patterns` fit in each row */
+inline bool grow_pattern_file( std::string const& filename, pattern_file_header const& header, uint64_t num_patterns )
+{
+  /* doubling the stride amortizes the rewrites over many appends */
+  auto const stride = std::max( 2u * header.stride, pattern_file_stride( num_patterns ) );
+  std::string const tmp_filename = filename + ".tmp";
+  {
+    pattern_file file( filename );
+    std::ofstream os( tmp_filename, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc );
+    if ( !file.is_open() || !os )
+    {
+      return false;
+    }
+
+    auto const new_header = make_pattern_file_header( header.num_pis, header.num_patterns, stride );
+    os.write( reinterpret_cast<char const*>( &new_header ), sizeof( new_header ) );
+    std::vector<uint64_t> row( stride, 0u );
+    for ( auto i = 0u; i < header.num_pis; ++i )
+    {
+      std::copy( file.words( i ), file.words( i ) + header.stride, row.begin() );
+      os.write( reinterpret_cast<char const*>( row.data() ), stride * sizeof( uint64_t ) );
+    }
+    if ( !os )
+    {
+      return false;
+    }
+  }
+  return std::rename( tmp_filename.c_str(), filename.c_str() ) == 0;
+}
+
+} // namespace detail
+
+/*! \brief Writes simulation patterns into a binary pattern file
+ *
+ * The file contains a `pattern_file_header` followed by one row of 64-bit
+ * words per primary input (see `pattern_file`).  Binary pattern files are
+ * read by the constructor of `partial_simulator` taking a filename and can
+ * be extended with `append_patterns_binary`.
+ *
+ * \param sim The `partial_simulator` (or derived simulator) object containing simulation patterns
+ * \param filename Filename
+ * \return Whether the file was written
+ */
+template<class Simulator>
+bool write_patterns_binary( Simulator const& sim, std::string const& filename )
+{
+  static_assert( std::is_base_of_v<partial_simulator, Simulator>, "This function is specialized for partial_simulator and derived simulators" );
+
+  std::ofstream os( filename.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc );
+  if ( !os )
+  {
+    return false;
+  }
+
+  auto const num_pis = sim.num_pis();
+  auto const stride = detail::pattern_file_stride( sim.num_bits() );
+  auto const header = detail::make_pattern_file_header( num_pis, sim.num_bits(), stride );
+  os.write( reinterpret_cast<char const*>( &header ), sizeof( header ) );
+
+  std::vector<uint64_t> row( stride );
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    std::fill( row.begin(), row.end(), 0u );
+    for ( auto j = 0u; j < ( sim.num_bits() + 63u ) >> 6; ++j )
+    {
+      row[j] = detail::pattern_word_at( sim.get_pattern( i ), j * 64u );
+    }
+    if ( ( sim.num_bits() & 63u ) != 0u )
+    {
+      row[( sim.num_bits() - 1u ) >> 6] &= ( uint64_t( 1u ) << ( sim.num_bits() & 63u ) ) - 1u;
+    }
+    os.write( reinterpret_cast<char const*>( row.data() ), stride * sizeof( uint64_t ) );
+  }
+
+  return static_cast<bool>( os );
+}
+
+/*! \brief Appends simulation patterns to a binary pattern file
+ *
+ * Appends the patterns `first_pattern`, ..., `sim.num_bits() - 1` of the
+ * simulator to the file, which is created if it does not exist.  The
+ * patterns are written in place into the padding of the rows; when the rows
+ * are full, the file is rewritten once with rows of twice the size.  This
+ * allows pattern sets, e.g., the counter-examples found by
+ * `pattern_generation`, to accumulate over several runs.
+ *
+ * \param sim The `partial_simulator` (or derived simulator) object containing simulation patterns
+ * \param filename Filename
+ * \param first_pattern Index of the first pattern to append
+ * \return Whether the patterns were appended; false if the file is not a
+ * pattern file or has a different number of primary inputs
+ */
+template<class Simulator>
+bool append_patterns_binary( Simulator const& sim, std::string const& filename, uint32_t first_pattern )
+{
+  static_assert( std::is_base_of_v<partial_simulator, Simulator>, "This function is specialized for partial_simulator and derived simulators" );
+  assert( first_pattern <= sim.num_bits() );
+
+  auto const num_pis = sim.num_pis();
+  if ( !std::ifstream( filename ).good() )
+  {
+    if ( first_pattern == 0u )
+    {
+      return write_patterns_binary( sim, filename );
+    }
+    partial_simulator const empty( std::vector<kitty::partial_truth_table>( num_pis, kitty::partial_truth_table( 0u ) ) );
+    if ( !write_patterns_binary( empty, filename ) )
+    {
+      return false;
+    }
+  }
+
+  pattern_file_header header;
+  {
+    std::ifstream in( filename, std::ifstream::in | std::ifstream::binary );
+    if ( !in.read( reinterpret_cast<char*>( &header ), sizeof( header ) ) ||
+         std::memcmp( header.magic, pattern_file_header::magic_value, 8 ) != 0 ||
+         header.version != pattern_file_header::current_version || header.num_pis != num_pis )
+    {
+      return false;
+    }
+  }
+
+  uint64_t const offset = header.num_patterns;
+  uint64_t const num_patterns = offset + sim.num_bits() - first_pattern;
+  if ( ( ( num_patterns + 63u ) >> 6 ) > header.stride )
+  {
+    if ( !detail::grow_pattern_file( filename, header, num_patterns ) )
+    {
+      return false;
+    }
+    header.stride = std::max( 2u * header.stride, detail::pattern_file_stride( num_patterns ) );
+  }
+
+  std::fstream f( filename, std::fstream::in | std::fstream::out | std::fstream::binary );
+  if ( !f )
+  {
+    return false;
+  }
+
+  auto const first_word = offset >> 6;
+  auto const last_word = ( num_patterns + 63u ) >> 6;
+  std::vector<uint64_t> words( last_word - first_word );
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    auto const& tt = sim.get_pattern( i );
+    std::streamoff const position = sizeof( pattern_file_header ) + ( uint64_t( i ) * header.stride + first_word ) * sizeof( uint64_t );
+
+    /* keep the patterns already stored in the first word */
+    uint64_t existing{ 0u };
+    if ( ( offset & 63u ) != 0u )
+    {
+      f.seekg( position );
+      f.read( reinterpret_cast<char*>( &existing ), sizeof( existing ) );
+    }
+
+    for ( auto k = first_word; k < last_word; ++k )
+    {
+      uint64_t word;
+      if ( k * 64u >= offset )
+      {
+        word = detail::pattern_word_at( tt, first_pattern + k * 64u - offset );
+      }
+      else
+      {
+        auto const mask = ( uint64_t( 1u ) << ( offset & 63u ) ) - 1u;
+        word = ( existing & mask ) | ( detail::pattern_word_at( tt, first_pattern ) << ( offset & 63u ) );
+      }
+      if ( k + 1u == last_word && ( num_patterns & 63u ) != 0u )
+      {
+        word &= ( uint64_t( 1u ) << ( num_patterns & 63u ) ) - 1u;
+      }
+      words[k - first_word] = word;
+    }
+
+    f.seekp( position );
+    f.write( reinterpret_cast<char const*>( words.data() ), words.size() * sizeof( uint64_t ) );
+  }
+
+  header.num_patterns = num_patterns;
+  f.seekp( 0 );
+  f.write( reinterpret_cast<char const*>( &header ), sizeof( header ) );
+
+  return static_cast<bool>( f );
+}
+
+/*! \brief Appends the new simulation patterns to a binary pattern file
+ *
+ * Appends the patterns of the simulator that are not in the file yet,
+ * assuming that the simulator starts with the patterns of the file, e.g.,
+ * because it was constructed from it.
+ *
+ * \param sim The `partial_simulator` (or derived simulator) object containing simulation patterns
+ * \param filename Filename
+ */
+template<class Simulator>
+bool append_patterns_binary( Simulator const& sim, std::string const& filename )
+{
+  uint32_t first_pattern{ 0u };
+  {
+    pattern_file file( filename );
+    if ( file.is_open() )
+    {
+      first_pattern = static_cast<uint32_t>( std::min<uint64_t>( file.num_patterns(), sim.num_bits() ) );
+    }
+  }
+  return append_patterns_binary( sim, filename, first_pattern );
+}
+
 } /* namespace mockturtle */
\ No newline at end of file
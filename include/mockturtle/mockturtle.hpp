@@ -189,6 +189,7 @@
 #include "mockturtle/utils/json_utils.hpp"
 #include "mockturtle/utils/mixed_radix.hpp"
 #include "mockturtle/utils/name_utils.hpp"
+#include "mockturtle/utils/network_builder.hpp"
 #include "mockturtle/utils/network_cache.hpp"
 #include "mockturtle/utils/network_utils.hpp"
 #include "mockturtle/utils/node_map.hpp"
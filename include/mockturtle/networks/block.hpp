@@ -61,14 +61,10 @@ struct block_storage_data
  * `data[2+i].h1`: Function literal in truth table cache for the fanout
  * `data[2+i].h2`: Fan-out size
  *
+ * Children and data words are allocated in the arenas of the storage.
  */
-struct block_storage_node : block_fanin_node<2>
+struct block_storage_node : arena_block_node<2>
 {
-  block_storage_node()
-  {
-    data = decltype( data )( 3 );
-  }
-
   bool operator==( block_storage_node const& other ) const
   {
     if ( data.size() != other.data.size() )
@@ -86,7 +82,7 @@ struct block_storage_node : block_fanin_node<2>
 
   ...
 */
-using block_storage = storage_no_hash<block_storage_node, block_storage_data>;
+using block_storage = arena_storage_no_hash<block_storage_node, block_storage_data>;
 
 class block_network
 {
@@ -217,8 +213,13 @@ public:
 protected:
   inline void _init()
   {
+    if ( _storage->nodes[0].data.empty() )
+    {
+      _storage->nodes[0].data = _storage->node_data.allocate( 3 );
+    }
+
     /* reserve the second node for constant 1 */
-    _storage->nodes.emplace_back();
+    _storage->nodes.emplace_back().data = _storage->node_data.allocate( 3 );
 
     /* reserve some truth tables for nodes */
     kitty::dynamic_truth_table tt_zero( 0 );
@@ -285,7 +286,7 @@ public:
   signal create_pi()
   {
     const auto index = _storage->nodes.size();
-    _storage->nodes.emplace_back();
+    _storage->nodes.emplace_back().data = _storage->node_data.allocate( 3 );
     _storage->inputs.emplace_back( index );
     _storage->nodes[index].data[2].h1 = 2;
     return { index, 0 };
@@ -438,7 +439,8 @@ public:
   signal _create_node( std::vector<signal> const& children, uint32_t literal )
   {
     storage::element_type::node_type node;
-    std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
+    node.children = _storage->fanins.allocate( children.begin(), children.end() );
+    node.data = _storage->node_data.allocate( 3 );
     node.data[2].h1 = literal;
 
     const auto index = _storage->nodes.size();
@@ -453,10 +455,7 @@ public:
 
     set_value( index, 0 );
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( index );
 
     return { index, 0 };
   }
@@ -464,9 +463,8 @@ public:
   signal _create_node( std::vector<signal> const& children, std::vector<uint32_t> const& literals )
   {
     storage::element_type::node_type node;
-    std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
-
-    node.data = decltype( node.data )( 2 + literals.size() );
+    node.children = _storage->fanins.allocate( children.begin(), children.end() );
+    node.data = _storage->node_data.allocate( static_cast<uint32_t>( 2 + literals.size() ) );
 
     for ( auto i = 0; i < literals.size(); ++i )
       node.data[2 + i].h1 = literals[i];
@@ -483,10 +481,7 @@ public:
 
     set_value( index, 0 );
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( index );
 
     return { index, 0 };
   }
@@ -568,10 +563,7 @@ public:
       }
     }
 
-    for ( auto const& fn : _events->on_modified )
-    {
-      ( *fn )( n, old_children );
-    }
+    _events->notify_modified( n, old_children );
   }
 
   void replace_in_node_no_restrash( node const& n, node const& old_node, signal new_signal )
@@ -616,10 +608,7 @@ public:
       nobj.data[i].h2 = 0;
     }
 
-    for ( auto const& fn : _events->on_delete )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_delete( n );
 
     /* if the node has been deleted, then deref fanout_size of
        fanins and try to take them out if their fanout_size become 0 */
@@ -948,7 +937,7 @@ public:
     if ( n == 0 || is_ci( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
+    using IteratorType = decltype( _storage->nodes[n].children.begin() );
     detail::foreach_element_transform<IteratorType, signal>(
         _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return signal( f ); }, fn );
   }
@@ -64,10 +64,7 @@ public:
     /* increase ref-count to children */
     _storage->nodes[a.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( index );
 
     return { index, 0 };
   }
@@ -314,10 +311,7 @@ public:
     /* increase ref-count to children */
     _storage->nodes[a.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( index );
 
     return { index, 0 };
   }
@@ -422,10 +416,7 @@ public:
     auto& nobj = _storage->nodes[n];
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
 
-    for ( auto const& fn : _events->on_delete )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_delete( n );
 
     if ( decr_fanout_size( nobj.children[0].index ) == 0 )
     {
@@ -681,10 +672,7 @@ public:
     /* increase ref-count to children */
     _storage->nodes[a.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( index );
 
     return { index, 0 };
   }
@@ -76,14 +76,14 @@ struct cover_storage_data
 
 /*! \brief cover node
  *
- * The cover node is a mixed fanin node with the following attributes:
- * `children`  : vector of pointers to children
+ * The cover node is an arena fanin node with the following attributes:
+ * `children`  : view on the pointers to children in the fan-in arena
  * `data[0].h1`: Fan-out size
  * `data[0].h2`: Application-specific value
  * `data[1].h1`: Index of the cover of the node in the covers container
  * `data[1].h2`: Visited flags
  */
-struct cover_storage_node : mixed_fanin_node<2>
+struct cover_storage_node : arena_fanin_node<2>
 {
   bool operator==( cover_storage_node const& other ) const
   {
@@ -96,12 +96,13 @@ struct cover_storage_node : mixed_fanin_node<2>
  * The network as a storage entity is defined by combining the node structure with the cover_storage structure.
  * The attributes of this storage unit are listed in the following:
  * `nodes`            : Vector of cover storage nodes
+ * `fanins`           : Arena holding the children of all nodes
  * `inputs`           : Vector of indices to inputs nodes
  * `outputs`          : Vector of pointers to node types
  * `hash`             : maps a node to its index in the nodes vector
  * `data`             : cover storage data
  */
-using cover_storage = storage<cover_storage_node, cover_storage_data>;
+using cover_storage = arena_storage<cover_storage_node, cover_storage_data>;
 
 /*! \brief cover_network
  *
@@ -371,12 +372,13 @@ public:
 
     uint64_t literal = _storage->data.insert( new_cover );
     storage::element_type::node_type node;
-    std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
+    node.children = _storage->fanins.allocate( children.begin(), children.end() );
     node.data[1].h1 = literal;
 
     const auto it = _storage->hash.find( node );
     if ( it != _storage->hash.end() )
     {
+      _storage->fanins.release( node.children );
       return it->second;
     }
 
@@ -392,10 +394,7 @@ public:
 
     set_value( index, 0 );
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( index );
 
     return index;
   }
@@ -459,6 +458,17 @@ public:
     for ( auto i = 0u; i < _storage->nodes.size(); ++i )
     {
       auto& n = _storage->nodes[i];
+      if ( std::none_of( n.children.begin(), n.children.end(), [&]( auto const& c ) { return c == old_node; } ) )
+      {
+        continue;
+      }
+
+      /* the hash key shares the fan-ins with the node */
+      if ( const auto it = _storage->hash.find( n ); it != _storage->hash.end() && it->second == i )
+      {
+        _storage->hash.erase( it );
+      }
+
       for ( auto& child : n.children )
       {
         if ( child == old_node )
@@ -470,12 +480,11 @@ public:
           // increment fan-out of new node
           _storage->nodes[new_signal].data[0].h1++;
 
-          for ( auto const& fn : _events->on_modified )
-          {
-            ( *fn )( i, old_children );
-          }
+          _events->notify_modified( i, old_children );
         }
       }
+
+      _storage->hash.try_emplace( n, i );
     }
 
     /* check outputs */
@@ -660,7 +669,7 @@ public:
     if ( n == 0 || is_ci( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
+    using IteratorType = decltype( _storage->nodes[n].children.begin() );
     detail::foreach_element_transform<IteratorType, uint32_t>(
         _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return f.index; },
         fn );
@@ -36,10 +36,17 @@
 
 #include "../traits.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <functional>
-#include <vector>
+#include <initializer_list>
 #include <iostream>
 #include <memory>
+#include <utility>
+#include <vector>
+
+#include <parallel_hashmap/phmap.h>
 
 namespace mockturtle
 {
@@ -49,6 +56,20 @@ namespace mockturtle
  * This data structure can be returned by a network.  Clients can add functions
  * to network events to call code whenever an event occurs.  Events are adding
  * a node, modifying a node, and deleting a node.
+ *
+ * Networks trigger events through `notify_add`, `notify_modified`, and
+ * `notify_delete`, which return after a single branch if no function is
+ * registered for the event.  Modification events can be batched with
+ * `begin_batch` and `end_batch`: inside a batch, each modified node is
+ * reported once when the outermost batch ends (or at the next call to
+ * `flush_batch`), together with its children before the first
+ * modification.  If a node with a pending modification is deleted, its
+ * modification event is delivered before the delete event.
+ *
+ * Listeners of a batch may therefore observe a node that was modified again
+ * after the event was deferred.  The `substitute_node` methods flush their
+ * batch after each replaced node, so that the modifications are delivered
+ * before the parents that became redundant are substituted in turn.
  */
 template<class Ntk>
 class network_events
@@ -116,6 +137,143 @@ public:
                      std::end( on_delete ) );
   }
 
+  /*! \brief Calls the functions registered for adding node `n`. */
+  void notify_add( node<Ntk> const& n )
+  {
+    if ( on_add.empty() )
+    {
+      return;
+    }
+
+    for ( auto const& fn : on_add )
+    {
+      ( *fn )( n );
+    }
+  }
+
+  /*! \brief Calls the functions registered for modifying node `n`.
+   *
+   * The vector of previous children is only created if a function is
+   * registered, and it is shared among all of them.
+   */
+  void notify_modified( node<Ntk> const& n, std::initializer_list<signal<Ntk>> previous_children )
+  {
+    if ( on_modified.empty() )
+    {
+      return;
+    }
+
+    if ( batch_depth > 0u )
+    {
+      defer_modified( n, previous_children );
+      return;
+    }
+
+    std::vector<signal<Ntk>> const children( previous_children );
+    for ( auto const& fn : on_modified )
+    {
+      ( *fn )( n, children );
+    }
+  }
+
+  /*! \brief Calls the functions registered for modifying node `n`. */
+  void notify_modified( node<Ntk> const& n, std::vector<signal<Ntk>> const& previous_children )
+  {
+    if ( on_modified.empty() )
+    {
+      return;
+    }
+
+    if ( batch_depth > 0u )
+    {
+      defer_modified( n, previous_children );
+      return;
+    }
+
+    for ( auto const& fn : on_modified )
+    {
+      ( *fn )( n, previous_children );
+    }
+  }
+
+  /*! \brief Calls the functions registered for deleting node `n`. */
+  void notify_delete( node<Ntk> const& n )
+  {
+    if ( batch_depth > 0u && !deferred.empty() )
+    {
+      /* deliver a pending modification of `n` first */
+      if ( auto it = deferred_index.find( n ); it != deferred_index.end() )
+      {
+        auto const previous_children = std::move( deferred[it->second].second );
+        deferred_index.erase( it );
+        for ( auto const& fn : on_modified )
+        {
+          ( *fn )( n, previous_children );
+        }
+      }
+    }
+
+    if ( on_delete.empty() )
+    {
+      return;
+    }
+
+    for ( auto const& fn : on_delete )
+    {
+      ( *fn )( n );
+    }
+  }
+
+  /*! \brief Starts deferring modification events.
+   *
+   * Batches can be nested; events are delivered when the outermost batch
+   * ends.
+   */
+  void begin_batch()
+  {
+    ++batch_depth;
+  }
+
+  /*! \brief Ends a batch started with `begin_batch`. */
+  void end_batch()
+  {
+    assert( batch_depth > 0u );
+    if ( --batch_depth > 0u )
+    {
+      return;
+    }
+
+    flush_batch();
+  }
+
+  /*! \brief Delivers the pending modification events without ending the batch. */
+  void flush_batch()
+  {
+    if ( deferred.empty() )
+    {
+      return;
+    }
+
+    /* listeners may trigger new events, hence the pending ones are moved out first */
+    auto pending = std::move( deferred );
+    auto index = std::move( deferred_index );
+    deferred.clear();
+    deferred_index.clear();
+
+    for ( auto i = 0u; i < pending.size(); ++i )
+    {
+      auto const& [n, previous_children] = pending[i];
+      if ( auto it = index.find( n ); it == index.end() || it->second != i )
+      {
+        continue; /* already delivered before the node was deleted */
+      }
+      for ( auto const& fn : on_modified )
+      {
+        ( *fn )( n, previous_children );
+      }
+    }
+  }
+
 public:
   /*! \brief Event when node `n` is added. */
   std::vector<std::shared_ptr<add_event_type>> on_add;
@@ -129,6 +287,22 @@ public:
 
   /*! \brief Event when `n` is deleted. */
   std::vector<std::shared_ptr<delete_event_type>> on_delete;
+
+private:
+  template<class Children>
+  void defer_modified( node<Ntk> const& n, Children const& previous_children )
+  {
+    /* only the children before the first modification are kept */
+    if ( deferred_index.try_emplace( n, static_cast<uint32_t>( deferred.size() ) ).second )
+    {
+      deferred.emplace_back( n, std::vector<signal<Ntk>>( previous_children.begin(), previous_children.end() ) );
+    }
+  }
+
+private:
+  uint32_t batch_depth{ 0u };
+  std::vector<std::pair<node<Ntk>, std::vector<signal<Ntk>>>> deferred;
+  phmap::flat_hash_map<node<Ntk>, uint32_t> deferred_index;
 };
 
 } // namespace mockturtle
\ No newline at end of file
@@ -66,7 +66,7 @@ struct klut_storage_data
  * `data[1].h1`: Function literal in truth table cache
  * `data[1].h2`: Visited flags
  */
-struct klut_storage_node : mixed_fanin_node<2>
+struct klut_storage_node : arena_fanin_node<2>
 {
   bool operator==( klut_storage_node const& other ) const
   {
@@ -78,7 +78,7 @@ struct klut_storage_node : mixed_fanin_node<2>
 
   ...
 */
-using klut_storage = storage<klut_storage_node, klut_storage_data>;
+using klut_storage = arena_storage<klut_storage_node, klut_storage_data>;
 
 class klut_network
 {
@@ -323,12 +323,13 @@ public:
   signal _create_node( std::vector<signal> const& children, uint32_t literal )
   {
     storage::element_type::node_type node;
-    std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
+    node.children = _storage->fanins.allocate( children.begin(), children.end() );
     node.data[1].h1 = literal;
 
     const auto it = _storage->hash.find( node );
     if ( it != _storage->hash.end() )
     {
+      _storage->fanins.release( node.children );
       return it->second;
     }
 
@@ -344,10 +345,7 @@ public:
 
     set_value( index, 0 );
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( index );
 
     return index;
   }
@@ -377,6 +375,17 @@ public:
     for ( auto i = 0u; i < _storage->nodes.size(); ++i )
     {
       auto& n = _storage->nodes[i];
+      if ( std::none_of( n.children.begin(), n.children.end(), [&]( auto const& c ) { return c == old_node; } ) )
+      {
+        continue;
+      }
+
+      /* the hash key shares the fan-ins with the node */
+      if ( const auto it = _storage->hash.find( n ); it != _storage->hash.end() && it->second == i )
+      {
+        _storage->hash.erase( it );
+      }
+
       for ( auto& child : n.children )
       {
         if ( child == old_node )
@@ -388,12 +397,11 @@ public:
           // increment fan-out of new node
           _storage->nodes[new_signal].data[0].h1++;
 
-          for ( auto const& fn : _events->on_modified )
-          {
-            ( *fn )( i, old_children );
-          }
+          _events->notify_modified( i, old_children );
         }
       }
+
+      _storage->hash.try_emplace( n, i );
     }
 
     /* check outputs */
@@ -586,7 +594,7 @@ public:
     if ( n == 0 || is_ci( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
+    using IteratorType = decltype( _storage->nodes[n].children.begin() );
     detail::foreach_element_transform<IteratorType, uint32_t>(
         _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return f.index; }, fn );
   }
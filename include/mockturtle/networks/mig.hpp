@@ -41,10 +41,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <stack>
 #include <string>
+#include <vector>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operators.hpp>
@@ -173,7 +175,13 @@ public:
 
   mig_network clone() const
   {
-    return { std::make_shared<mig_storage>( *_storage ) };
+    auto storage = std::make_shared<mig_storage>( *_storage );
+
+    /* the fan-out lists belong to the users of this network (see `acquire_fanouts`) */
+    storage->fanout_users = 0u;
+    storage->fanouts.reset( 3u );
+
+    return { storage };
   }
 #pragma endregion
 
@@ -312,10 +320,9 @@ public:
     _storage->nodes[b.index].data[0].h1++;
     _storage->nodes[c.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _link_fanins( index );
+
+    _events->notify_add( index );
 
     return { index, node_complement };
   }
@@ -412,7 +419,12 @@ public:
 #pragma endregion
 
 #pragma region Has node
-  std::optional<signal> has_maj( signal a, signal b, signal c )
+  /*! \brief Looks up a majority gate in the structural hash table.
+   *
+   * Does not modify the network; it is safe to call this function from
+   * several threads as long as no thread modifies the network.
+   */
+  std::optional<signal> has_maj( signal a, signal b, signal c ) const
   {
     /* order inputs */
     if ( a.index > b.index )
@@ -541,6 +553,7 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _unlink_fanins( n );
 
     // insert updated node into hash table
     node.children[0] = child0;
@@ -553,10 +566,9 @@ public:
     // update the reference counter of the old signal
     _storage->nodes[old_node].data[0].h1--;
 
-    for ( auto const& fn : _events->on_modified )
-    {
-      ( *fn )( n, { old_child0, old_child1, old_child2 } );
-    }
+    _link_fanins( n );
+
+    _events->notify_modified( n, { old_child0, old_child1, old_child2 } );
 
     return std::nullopt;
   }
@@ -611,6 +623,7 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _unlink_fanins( n );
 
     // insert updated node into hash table
     node.children[0] = child0;
@@ -626,10 +639,9 @@ public:
     // update the reference counter of the old signal
     _storage->nodes[old_node].data[0].h1--;
 
-    for ( auto const& fn : _events->on_modified )
-    {
-      ( *fn )( n, { old_child0, old_child1, old_child2 } );
-    }
+    _link_fanins( n );
+
+    _events->notify_modified( n, { old_child0, old_child1, old_child2 } );
   }
 
   void replace_in_outputs( node const& old_node, signal const& new_signal )
@@ -664,11 +676,9 @@ public:
     auto& nobj = _storage->nodes[n];
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
+    _unlink_fanins( n );
 
-    for ( auto const& fn : _events->on_delete )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_delete( n );
 
     for ( auto i = 0u; i < 3u; ++i )
     {
@@ -692,11 +702,9 @@ public:
     auto& nobj = _storage->nodes[n];
     nobj.data[0].h1 = UINT32_C( 0 ); /* fanout size 0, but not dead (like just created) */
     _storage->hash[nobj] = n;
+    _link_fanins( n );
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_add( n );
 
     /* revive its children if dead, and increment their fanout_size */
     for ( auto i = 0u; i < 3u; ++i )
@@ -716,6 +724,9 @@ public:
 
   void substitute_node( node const& old_node, signal const& new_signal )
   {
+    /* report each modified parent once per replaced node */
+    _events->begin_batch();
+
     std::unordered_map<node, signal> old_to_new;
     std::stack<std::pair<node, signal>> to_substitute;
     to_substitute.push( { old_node, new_signal } );
@@ -742,16 +753,15 @@ public:
         revive_node( get_node( _new ) );
       }
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
-        if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
-
+      _foreach_parent( _old, [&]( node const& idx ) {
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
+
+      /* deliver the modifications before the redundant parents are substituted */
+      _events->flush_batch();
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -763,6 +773,8 @@ public:
         take_out_node( _old );
       }
     }
+
+    _events->end_batch();
   }
 
   void substitute_node_no_restrash( node const& old_node, signal const& new_signal )
@@ -772,13 +784,9 @@ public:
       revive_node( get_node( new_signal ) );
     }
 
-    for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-    {
-      if ( is_ci( idx ) || is_dead( idx ) )
-        continue; /* ignore CIs and dead nodes */
-
+    _foreach_parent( old_node, [&]( node const& idx ) {
       replace_in_node_no_restrash( idx, old_node, new_signal );
-    }
+    } );
 
     /* check outputs */
     replace_in_outputs( old_node, new_signal );
@@ -791,6 +799,56 @@ public:
   }
 #pragma endregion
 
+#pragma region Fan-out lists
+  /*! \brief Acquires the fan-out lists in the storage.
+   *
+   * While the lists are acquired, the storage keeps, for each node, the list
+   * of gates that have the node as fanin, and `substitute_node` only visits
+   * the fan-outs of the substituted node.  Each call must be paired with a
+   * call to `release_fanouts`.  `fanout_view` acquires the lists for its
+   * lifetime and forwards to them.
+   */
+  void acquire_fanouts()
+  {
+    if ( _storage->fanout_users++ == 0u )
+    {
+      _rebuild_fanouts();
+    }
+  }
+
+  /*! \brief Releases the fan-out lists; they are dropped with the last user. */
+  void release_fanouts()
+  {
+    assert( _storage->fanout_users > 0u );
+    if ( --_storage->fanout_users == 0u )
+    {
+      _rebuild_fanouts();
+    }
+  }
+
+  bool is_tracking_fanouts() const
+  {
+    return _storage->fanout_users > 0u;
+  }
+
+  /*! \brief Recomputes the fan-out lists in index order. */
+  void rebuild_fanouts()
+  {
+    _rebuild_fanouts();
+  }
+
+  /*! \brief Calls `fn` on the gates that have `n` as fanin.
+   *
+   * Requires acquired fan-out lists (see `acquire_fanouts`).
+   */
+  template<typename Fn>
+  void foreach_tracked_fanout( node const& n, Fn&& fn ) const
+  {
+    assert( _storage->fanout_users > 0u );
+    detail::foreach_element( _storage->fanouts.begin( n ), _storage->fanouts.end(), fn );
+  }
+#pragma endregion
+
 #pragma region Structural properties
   auto size() const
   {
@@ -1221,6 +1279,76 @@ public:
   }
 #pragma endregion
 
+protected:
+  /* appends node `n` to the fan-out lists of its fanins (see `acquire_fanouts`) */
+  void _link_fanins( node const& n )
+  {
+    if ( _storage->fanout_users > 0u )
+    {
+      auto const& nobj = _storage->nodes[n];
+      for ( auto i = 0u; i < 3u; ++i )
+      {
+        _storage->fanouts.link( n, i, nobj.children[i].index );
+      }
+    }
+  }
+
+  /* removes node `n` from the fan-out lists of its fanins */
+  void _unlink_fanins( node const& n )
+  {
+    if ( _storage->fanout_users > 0u )
+    {
+      auto const& nobj = _storage->nodes[n];
+      for ( auto i = 0u; i < 3u; ++i )
+      {
+        _storage->fanouts.unlink( n, i, nobj.children[i].index );
+      }
+    }
+  }
+
+  /* recomputes the fan-out lists of all gates in index order */
+  void _rebuild_fanouts()
+  {
+    _storage->fanouts.reset( 3u );
+    if ( _storage->fanout_users == 0u )
+    {
+      return;
+    }
+
+    for ( node n = 1u; n < _storage->nodes.size(); ++n )
+    {
+      if ( !is_ci( n ) && !is_dead( n ) )
+      {
+        _link_fanins( n );
+      }
+    }
+  }
+
+  /* calls `fn` in index order on the gates that may have `n` as fanin: its
+     fan-outs if fan-out lists are tracked, and all gates otherwise */
+  template<typename Fn>
+  void _foreach_parent( node const& n, Fn&& fn )
+  {
+    if ( _storage->fanout_users > 0u )
+    {
+      std::vector<node> parents( _storage->fanouts.begin( n ), _storage->fanouts.end() );
+      std::sort( parents.begin(), parents.end() );
+      for ( auto const& p : parents )
+      {
+        fn( p );
+      }
+      return;
+    }
+
+    for ( node idx = 1u; idx < _storage->nodes.size(); ++idx )
+    {
+      if ( is_ci( idx ) || is_dead( idx ) )
+        continue; /* ignore CIs and dead nodes */
+
+      fn( idx );
+    }
+  }
+
 public:
   std::shared_ptr<mig_storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
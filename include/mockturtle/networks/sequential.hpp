@@ -49,18 +49,10 @@ namespace detail
 {
 
 template<class Ntk>
-struct is_aig_like : std::false_type
+struct is_aig_like : std::bool_constant<is_aig_network_type_v<Ntk> || is_xag_network_type_v<Ntk>>
 {
 };
 
-template<>
-struct is_aig_like<aig_network> : std::true_type
-{
-};
-template<>
-struct is_aig_like<xag_network> : std::true_type
-{
-};
 template<>
 struct is_aig_like<mig_network> : std::true_type
 {
@@ -358,18 +350,14 @@ public:
   sequential()
       : _sequential_storage( std::make_shared<sequential_information>() )
   {
-    static_assert( std::is_same_v<base_type, aig_network> || std::is_same_v<base_type, xag_network> ||
-                       std::is_same_v<base_type, mig_network> || std::is_same_v<base_type, xmg_network> ||
-                       std::is_same_v<base_type, aqfp_network>,
+    static_assert( detail::is_aig_like_v<base_type>,
                    "Sequential interfaces extended for unknown network type. Please check the compatibility of implementations." );
   }
 
   sequential( storage base_storage )
       : Ntk( base_storage ), _sequential_storage( std::make_shared<sequential_information>() )
   {
-    static_assert( std::is_same_v<base_type, aig_network> || std::is_same_v<base_type, xag_network> ||
-                       std::is_same_v<base_type, mig_network> || std::is_same_v<base_type, xmg_network> ||
-                       std::is_same_v<base_type, aqfp_network>,
+    static_assert( detail::is_aig_like_v<base_type>,
                    "Sequential interfaces extended for unknown network type. Please check the compatibility of implementations." );
   }
 
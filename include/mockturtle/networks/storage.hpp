@@ -39,9 +39,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <parallel_hashmap/phmap.h>
@@ -49,13 +59,15 @@
 namespace mockturtle
 {
 
-template<int PointerFieldSize = 0>
+template<int PointerFieldSize = 0, typename Word = uint64_t>
 struct node_pointer
 {
 private:
-  static constexpr auto _len = sizeof( uint64_t ) * 8;
+  static constexpr auto _len = sizeof( Word ) * 8;
 
 public:
+  using word_type = Word;
+
   node_pointer() = default;
   node_pointer( uint64_t index, uint64_t weight ) : weight( weight ), index( index ) {}
   node_pointer( uint64_t data ) : data( data ) {}
@@ -64,37 +76,39 @@ public:
   {
     struct
     {
-      uint64_t weight : PointerFieldSize;
-      uint64_t index : _len - PointerFieldSize;
+      Word weight : PointerFieldSize;
+      Word index : _len - PointerFieldSize;
     };
-    uint64_t data;
+    Word data;
   };
 
-  bool operator==( node_pointer<PointerFieldSize> const& other ) const
+  bool operator==( node_pointer<PointerFieldSize, Word> const& other ) const
   {
     return data == other.data;
   }
 
-  bool operator!=( node_pointer<PointerFieldSize> const& other ) const
+  bool operator!=( node_pointer<PointerFieldSize, Word> const& other ) const
   {
     return data != other.data;
   }
 };
 
-template<>
-struct node_pointer<0>
+template<typename Word>
+struct node_pointer<0, Word>
 {
 public:
+  using word_type = Word;
+
   node_pointer() = default;
   node_pointer( uint64_t index ) : index( index ) {}
 
   union
   {
-    uint64_t index;
-    uint64_t data; 
+    Word index;
+    Word data; 
   };
 
-  bool operator==( node_pointer<0> const& other ) const
+  bool operator==( node_pointer<0, Word> const& other ) const
   {
     return data == other.data;
   }
@@ -117,15 +131,28 @@ union cauint64_t
   };
 };
 
-template<int Fanin, int Size = 0, int PointerFieldSize = 0>
+template<int Fanin, int Size = 0, int PointerFieldSize = 0, typename Word = uint64_t>
 struct regular_node
 {
-  using pointer_type = node_pointer<PointerFieldSize>;
+  using pointer_type = node_pointer<PointerFieldSize, Word>;
 
   std::array<pointer_type, Fanin> children;
   std::array<cauint64_t, Size> data;
 
-  bool operator==( regular_node<Fanin, Size, PointerFieldSize> const& other ) const
+  bool operator==( regular_node<Fanin, Size, PointerFieldSize, Word> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
+template<int Fanin, int PointerFieldSize = 0, typename Word = uint64_t>
+struct fanin_node
+{
+  using pointer_type = node_pointer<PointerFieldSize, Word>;
+
+  std::array<pointer_type, Fanin> children;
+
+  bool operator==( fanin_node<Fanin, PointerFieldSize, Word> const& other ) const
   {
     return children == other.children;
   }
@@ -159,6 +186,185 @@ struct block_fanin_node
   }
 };
 
+/*! \brief Non-owning view on a contiguous range of arena elements
+ *
+ * Used for the variable-size fields of arena nodes.  The view is a plain
+ * pointer and a size, and does not own the elements.  Two views compare equal
+ * if they have the same contents.
+ */
+template<typename T>
+struct arena_span
+{
+  arena_span() = default;
+  arena_span( T* data, uint32_t size ) : _data( data ), _size( size ) {}
+
+  T* begin() const
+  {
+    return _data;
+  }
+
+  T* end() const
+  {
+    return _data + _size;
+  }
+
+  T* data() const
+  {
+    return _data;
+  }
+
+  uint32_t size() const
+  {
+    return _size;
+  }
+
+  bool empty() const
+  {
+    return _size == 0u;
+  }
+
+  T& operator[]( uint32_t i ) const
+  {
+    return _data[i];
+  }
+
+  bool operator==( arena_span<T> const& other ) const
+  {
+    return _size == other._size && std::equal( begin(), end(), other.begin() );
+  }
+
+  bool operator!=( arena_span<T> const& other ) const
+  {
+    return !( *this == other );
+  }
+
+private:
+  T* _data{ nullptr };
+  uint32_t _size{ 0u };
+};
+
+/*! \brief Append-only arena
+ *
+ * Hands out contiguous ranges of value-initialized elements as `arena_span`s.
+ * Memory is organized in chunks that are never reallocated, hence views stay
+ * valid while the arena grows.  Ranges that do not fit into the default chunk
+ * size get a chunk on their own.  Only the most recent allocation can be
+ * returned to the arena (see `release`), all other memory is freed when the
+ * arena is cleared or destroyed.
+ */
+template<typename T>
+class chunked_arena
+{
+public:
+  explicit chunked_arena( uint32_t chunk_size = 1u << 16 ) : _chunk_size( chunk_size ) {}
+
+  chunked_arena( chunked_arena<T> const& ) = delete;
+  chunked_arena( chunked_arena<T>&& ) = default;
+  chunked_arena<T>& operator=( chunked_arena<T> const& ) = delete;
+  chunked_arena<T>& operator=( chunked_arena<T>&& ) = default;
+
+  /*! \brief Allocates `n` value-initialized elements. */
+  arena_span<T> allocate( uint32_t n )
+  {
+    if ( n == 0u )
+    {
+      return {};
+    }
+
+    if ( _chunks.empty() || _chunks.back().used + n > _chunks.back().capacity )
+    {
+      auto const capacity = std::max( n, _chunk_size );
+      _chunks.push_back( chunk{ std::make_unique<T[]>( capacity ), capacity, 0u } );
+    }
+
+    auto& c = _chunks.back();
+    T* data = c.memory.get() + c.used;
+    std::fill( data, data + n, T{} );
+    c.used += n;
+    _size += n;
+    return { data, n };
+  }
+
+  /*! \brief Allocates a copy of the range `[begin, end)`. */
+  template<typename Iterator>
+  arena_span<T> allocate( Iterator begin, Iterator end )
+  {
+    auto span = allocate( static_cast<uint32_t>( std::distance( begin, end ) ) );
+    std::transform( begin, end, span.begin(), []( auto const& e ) { return T( e ); } );
+    return span;
+  }
+
+  /*! \brief Returns the memory of `span` if it is the most recent allocation. */
+  void release( arena_span<T> const& span )
+  {
+    if ( span.empty() || _chunks.empty() )
+    {
+      return;
+    }
+
+    auto& c = _chunks.back();
+    if ( span.end() == c.memory.get() + c.used )
+    {
+      c.used -= span.size();
+      _size -= span.size();
+    }
+  }
+
+  /*! \brief Number of allocated elements. */
+  uint64_t size() const
+  {
+    return _size;
+  }
+
+  void clear()
+  {
+    _chunks.clear();
+    _size = 0u;
+  }
+
+private:
+  struct chunk
+  {
+    std::unique_ptr<T[]> memory;
+    uint32_t capacity;
+    uint32_t used;
+  };
+
+  uint32_t _chunk_size;
+  uint64_t _size{ 0u };
+  std::vector<chunk> _chunks;
+};
+
+/*! \brief Node with a variable number of fan-ins stored in an arena */
+template<int Size = 0, int PointerFieldSize = 0>
+struct arena_fanin_node
+{
+  using pointer_type = node_pointer<PointerFieldSize>;
+
+  arena_span<pointer_type> children;
+  std::array<cauint64_t, Size> data;
+
+  bool operator==( arena_fanin_node<Size, PointerFieldSize> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
+/*! \brief Node with variable numbers of fan-ins and data words stored in arenas */
+template<int PointerFieldSize = 0>
+struct arena_block_node
+{
+  using pointer_type = node_pointer<PointerFieldSize>;
+
+  arena_span<pointer_type> children;
+  arena_span<cauint64_t> data;
+
+  bool operator==( arena_block_node<PointerFieldSize> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
 /*! \brief Hash function for 64-bit word */
 inline uint64_t hash_block( uint64_t word )
 {
@@ -209,45 +415,1011 @@ struct empty_storage_data
 {
 };
 
-template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
-struct storage
+/*! \brief Paged vector with copy-on-write pages
+ *
+ * Elements are stored in pages of 2^`PageBits` elements that are shared
+ * between copies of the vector.  Copying the vector is linear in the number
+ * of pages; a page is copied when it is accessed through a non-const
+ * reference while it is shared.  Read-only accesses should hence use a const
+ * reference to the vector.  Copies of a vector must not be modified
+ * concurrently.
+ */
+template<typename T, uint32_t PageBits = 12u>
+class cow_vector
 {
-  storage()
+public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = T const&;
+  using size_type = uint64_t;
+
+  static constexpr uint64_t page_size = UINT64_C( 1 ) << PageBits;
+
+private:
+  using page_type = std::vector<T>;
+
+  template<bool IsConst>
+  class basic_iterator
   {
-    nodes.reserve( 10000u );
-    hash.reserve( 10000u );
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, T const*, T*>;
+    using reference = std::conditional_t<IsConst, T const&, T&>;
 
-    /* we generally reserve the first node for a constant */
-    nodes.emplace_back();
+    basic_iterator( std::conditional_t<IsConst, cow_vector const*, cow_vector*> vec, uint64_t index )
+        : _vec( vec ), _index( index )
+    {
+    }
+
+    reference operator*() const
+    {
+      return ( *_vec )[_index];
+    }
+
+    pointer operator->() const
+    {
+      return &( *_vec )[_index];
+    }
+
+    basic_iterator& operator++()
+    {
+      ++_index;
+      return *this;
+    }
+
+    basic_iterator operator++( int )
+    {
+      auto copy = *this;
+      ++_index;
+      return copy;
+    }
+
+    bool operator==( basic_iterator const& other ) const
+    {
+      return _index == other._index;
+    }
+
+    bool operator!=( basic_iterator const& other ) const
+    {
+      return _index != other._index;
+    }
+
+  private:
+    std::conditional_t<IsConst, cow_vector const*, cow_vector*> _vec;
+    uint64_t _index;
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  uint64_t size() const
+  {
+    return _size;
   }
 
-  using node_type = Node;
+  bool empty() const
+  {
+    return _size == 0u;
+  }
 
-  uint32_t trav_id = 0u;
+  uint64_t capacity() const
+  {
+    return std::max( _capacity, _pages.size() * page_size );
+  }
 
-  std::vector<node_type> nodes;
-  std::vector<uint64_t> inputs;
-  std::vector<typename node_type::pointer_type> outputs;
+  void reserve( uint64_t n )
+  {
+    _pages.reserve( ( n + page_size - 1u ) >> PageBits );
+    _capacity = std::max( _capacity, n );
+  }
 
-  phmap::flat_hash_map<node_type, uint64_t, NodeHasher> hash;
+  const_reference operator[]( uint64_t index ) const
+  {
+    return ( *_pages[index >> PageBits] )[index & ( page_size - 1u )];
+  }
 
-  T data;
+  reference operator[]( uint64_t index )
+  {
+    return _mutable_page( index >> PageBits )[index & ( page_size - 1u )];
+  }
+
+  const_reference back() const
+  {
+    return ( *this )[_size - 1u];
+  }
+
+  reference back()
+  {
+    return ( *this )[_size - 1u];
+  }
+
+  template<typename... Args>
+  reference emplace_back( Args&&... args )
+  {
+    if ( ( _size & ( page_size - 1u ) ) == 0u )
+    {
+      _pages.emplace_back( std::make_shared<page_type>() )->reserve( page_size );
+    }
+    auto& page = _mutable_page( _size >> PageBits );
+    ++_size;
+    return page.emplace_back( std::forward<Args>( args )... );
+  }
+
+  void push_back( T const& value )
+  {
+    emplace_back( value );
+  }
+
+  void pop_back()
+  {
+    _mutable_page( ( _size - 1u ) >> PageBits ).pop_back();
+    if ( ( --_size & ( page_size - 1u ) ) == 0u )
+    {
+      _pages.pop_back();
+    }
+  }
+
+  void resize( uint64_t n )
+  {
+    while ( _size > n )
+    {
+      pop_back();
+    }
+    while ( _size < n )
+    {
+      emplace_back();
+    }
+  }
+
+  void clear()
+  {
+    _pages.clear();
+    _size = 0u;
+  }
+
+  iterator begin()
+  {
+    return { this, 0u };
+  }
+
+  iterator end()
+  {
+    return { this, _size };
+  }
+
+  const_iterator begin() const
+  {
+    return { this, 0u };
+  }
+
+  const_iterator end() const
+  {
+    return { this, _size };
+  }
+
+  /*! \brief Number of pages shared with other vectors. */
+  uint64_t num_shared_pages() const
+  {
+    return std::count_if( _pages.begin(), _pages.end(), []( auto const& page ) { return page.use_count() > 1; } );
+  }
+
+private:
+  page_type& _mutable_page( uint64_t p )
+  {
+    auto& page = _pages[p];
+    if ( page.use_count() > 1 )
+    {
+      auto copy = std::make_shared<page_type>();
+      copy->reserve( page_size );
+      copy->insert( copy->end(), page->begin(), page->end() );
+      page = std::move( copy );
+    }
+    return *page;
+  }
+
+private:
+  std::vector<std::shared_ptr<page_type>> _pages;
+  uint64_t _size{ 0u };
+  uint64_t _capacity{ 0u };
 };
 
-template<typename Node, typename T = empty_storage_data>
-struct storage_no_hash
+/*! \brief Hash map with copy-on-write shards
+ *
+ * The entries are distributed over 2^`ShardBits` hash maps that are shared
+ * between copies of the map.  Copying the map is linear in the number of
+ * shards; a shard is copied when it is modified while it is shared.  The
+ * interface covers what is used for structural hashing; iterators are
+ * read-only.
+ */
+template<typename Key, typename Value, typename Hasher, uint32_t ShardBits = 6u>
+class cow_hash_map
 {
-  storage_no_hash()
+  using shard_type = phmap::flat_hash_map<Key, Value, Hasher>;
+
+public:
+  class const_iterator
   {
-    nodes.reserve( 10000u );
+  public:
+    const_iterator() = default;
 
-    /* we generally reserve the first node for a constant */
-    nodes.emplace_back();
+    explicit const_iterator( typename shard_type::const_iterator it )
+        : _it( it ), _valid( true )
+    {
+    }
+
+    auto const& operator*() const
+    {
+      return *_it;
+    }
+
+    auto const* operator->() const
+    {
+      return &*_it;
+    }
+
+    bool operator==( const_iterator const& other ) const
+    {
+      return _valid == other._valid && ( !_valid || _it == other._it );
+    }
+
+    bool operator!=( const_iterator const& other ) const
+    {
+      return !( *this == other );
+    }
+
+  private:
+    typename shard_type::const_iterator _it{};
+    bool _valid{ false };
+  };
+
+  using iterator = const_iterator;
+
+  cow_hash_map()
+  {
+    for ( auto& shard : _shards )
+    {
+      shard = std::make_shared<shard_type>();
+    }
   }
 
-  using node_type = Node;
+  uint64_t size() const
+  {
+    return _size;
+  }
 
-  uint32_t trav_id = 0u;
+  const_iterator find( Key const& key ) const
+  {
+    auto const& shard = *_shards[_shard_index( key )];
+    const auto it = shard.find( key );
+    return it == shard.end() ? const_iterator{} : const_iterator{ it };
+  }
+
+  const_iterator end() const
+  {
+    return {};
+  }
+
+  Value& operator[]( Key const& key )
+  {
+    auto& shard = _mutable_shard( _shard_index( key ) );
+    const auto [it, inserted] = shard.try_emplace( key );
+    _size += inserted ? 1u : 0u;
+    return it->second;
+  }
+
+  std::pair<const_iterator, bool> try_emplace( Key const& key, Value const& value )
+  {
+    auto& shard = _mutable_shard( _shard_index( key ) );
+    const auto [it, inserted] = shard.try_emplace( key, value );
+    _size += inserted ? 1u : 0u;
+    return { const_iterator{ it }, inserted };
+  }
+
+  uint64_t erase( Key const& key )
+  {
+    const auto s = _shard_index( key );
+    if ( !_shards[s]->contains( key ) )
+    {
+      return 0u;
+    }
+    --_size;
+    return _mutable_shard( s ).erase( key );
+  }
+
+  void clear()
+  {
+    for ( auto& shard : _shards )
+    {
+      if ( shard.use_count() > 1 )
+      {
+        shard = std::make_shared<shard_type>();
+      }
+      else
+      {
+        shard->clear();
+      }
+    }
+    _size = 0u;
+  }
+
+  /*! \brief Reserves space in all shards that are not shared. */
+  void reserve( uint64_t n )
+  {
+    for ( auto& shard : _shards )
+    {
+      if ( shard.use_count() == 1 )
+      {
+        shard->reserve( n >> ShardBits );
+      }
+    }
+  }
+
+  /*! \brief Number of shards shared with other maps. */
+  uint64_t num_shared_shards() const
+  {
+    return std::count_if( _shards.begin(), _shards.end(), []( auto const& shard ) { return shard.use_count() > 1; } );
+  }
+
+private:
+  static uint64_t _shard_index( Key const& key )
+  {
+    /* Fibonacci hashing, since the node hashers do not mix their bits */
+    return ( static_cast<uint64_t>( Hasher{}( key ) ) * UINT64_C( 0x9e3779b97f4a7c15 ) ) >> ( 64u - ShardBits );
+  }
+
+  shard_type& _mutable_shard( uint64_t s )
+  {
+    auto& shard = _shards[s];
+    if ( shard.use_count() > 1 )
+    {
+      shard = std::make_shared<shard_type>( *shard );
+    }
+    return *shard;
+  }
+
+private:
+  std::array<std::shared_ptr<shard_type>, ( 1u << ShardBits )> _shards;
+  uint64_t _size{ 0u };
+};
+
+/*! \brief Structural hash table of `storage` (default)
+ *
+ * Uses a single `phmap::flat_hash_map`; nodes are stored in a `std::vector`.
+ *
+ * Besides the containers, a policy selects the layout of the storage:
+ * `separate_node_data` keeps the per-node data of AIGs and XAGs in separate
+ * arrays (see `soa_storage`) instead of in the nodes, and `index_type` is the
+ * word type of their node indices and node pointers.
+ */
+struct default_hash_policy
+{
+  template<typename Key, typename Value, typename Hasher>
+  using map_type = phmap::flat_hash_map<Key, Value, Hasher>;
+
+  template<typename Node>
+  using node_container = std::vector<Node>;
+
+  static constexpr bool separate_node_data = false;
+  using index_type = uint64_t;
+};
+
+/*! \brief Structure-of-arrays layout (see `soa_storage`)
+ *
+ * Same containers as `default_hash_policy`, but the nodes only contain their
+ * fan-ins and the per-node data is kept in separate arrays.
+ */
+struct soa_storage_policy : default_hash_policy
+{
+  static constexpr bool separate_node_data = true;
+};
+
+/*! \brief Structure-of-arrays layout with 32-bit node indices
+ *
+ * Same as `soa_storage_policy`, but node indices and node pointers are 32-bit
+ * words, such that a network can hold up to 2^31 nodes.  An AIG node then
+ * takes 8 bytes in the fan-in array (21 bytes including its data).
+ */
+struct compact_storage_policy : soa_storage_policy
+{
+  using index_type = uint32_t;
+};
+
+/*! \brief Copy-on-write nodes and structural hash table of `soa_storage`
+ *
+ * The fan-ins and terminal flags are stored in `cow_vector`s and the
+ * structural hash table is a `cow_hash_map`, such that copies of the storage
+ * (e.g., network clones or snapshots) share the pages and shards that are not
+ * modified afterwards.  The fan-out sizes, values, and visited flags are kept in
+ * separate arrays of each copy, such that creating nodes or traversing the
+ * network does not copy the pages of other nodes.
+ */
+struct cow_storage_policy
+{
+  template<typename Key, typename Value, typename Hasher>
+  using map_type = cow_hash_map<Key, Value, Hasher>;
+
+  template<typename Node>
+  using node_container = cow_vector<Node>;
+
+  static constexpr bool separate_node_data = true;
+  using index_type = uint64_t;
+};
+
+/*! \brief Sharded structural hash table of `storage`
+ *
+ * Uses a `phmap::parallel_flat_hash_map` with 2^4 submaps.  The submaps are
+ * not locked: as for the default policy, lookups can be performed
+ * concurrently as long as no thread modifies the table.  In addition, the
+ * table can be filled by several threads that each own a subset of the
+ * submaps (see `detail::parallel_fill_hash`).
+ */
+struct parallel_hash_policy
+{
+  template<typename Key, typename Value, typename Hasher>
+  using map_type = phmap::parallel_flat_hash_map<Key, Value, Hasher,
+                                                 phmap::priv::hash_default_eq<Key>,
+                                                 phmap::priv::Allocator<phmap::priv::Pair<const Key, Value>>,
+                                                 4, phmap::NullMutex>;
+
+  template<typename Node>
+  using node_container = std::vector<Node>;
+
+  static constexpr bool separate_node_data = false;
+  using index_type = uint64_t;
+};
+
+namespace detail
+{
+
+template<typename Map>
+struct is_parallel_hash_map : std::false_type
+{
+};
+
+template<typename K, typename V, typename Hash, typename Eq, typename Alloc, size_t N, typename Mutex>
+struct is_parallel_hash_map<phmap::parallel_flat_hash_map<K, V, Hash, Eq, Alloc, N, Mutex>> : std::true_type
+{
+};
+
+/* exposes the (protected) submap selection of a sharded hash table */
+template<typename Map>
+struct hash_submaps : Map
+{
+  using Map::subcnt;
+  using Map::subidx;
+};
+
+/*! \brief Fills a sharded hash table using several threads.
+ *
+ * Inserts `nodes[i]` with value `i` for every index for which `is_key( i )`
+ * holds.  Each thread first collects the keys in its range of indices, grouped
+ * by submap, and then inserts the keys of the submaps it owns, such that no
+ * locking is required.  Returns false if some key was already contained in
+ * the table; the entry of the smallest such index is kept.
+ */
+template<typename Map, typename Nodes, typename Fn>
+bool parallel_fill_hash( Map& hash, Nodes const& nodes, uint32_t num_threads, Fn&& is_key )
+{
+  static_assert( is_parallel_hash_map<Map>::value, "hash table is not sharded" );
+
+  using submaps = hash_submaps<Map>;
+  num_threads = std::max( 1u, std::min<uint32_t>( num_threads, static_cast<uint32_t>( submaps::subcnt() ) ) );
+
+  /* each thread sorts the keys in its index range by submap */
+  const auto num_submaps = submaps::subcnt();
+  std::vector<std::vector<std::vector<uint64_t>>> buckets( num_threads, std::vector<std::vector<uint64_t>>( num_submaps ) );
+  const auto chunk = ( nodes.size() + num_threads - 1u ) / num_threads;
+
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      const auto end = std::min<uint64_t>( nodes.size(), ( t + 1u ) * chunk );
+      for ( uint64_t i = t * chunk; i < end; ++i )
+      {
+        if ( is_key( i ) )
+        {
+          buckets[t][submaps::subidx( hash.hash( nodes[i] ) )].push_back( i );
+        }
+      }
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+  threads.clear();
+
+  /* each thread inserts the keys of its submaps, in index order */
+  std::atomic<bool> unique{ true };
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      for ( auto s = t; s < num_submaps; s += num_threads )
+      {
+        for ( auto const& bucket : buckets )
+        {
+          for ( auto const& i : bucket[s] )
+          {
+            if ( !hash.try_emplace( nodes[i], i ).second )
+            {
+              unique = false;
+            }
+          }
+        }
+      }
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  return unique;
+}
+
+/*! \brief Moves `elements[order[i]]` to index `first + i` and drops the elements after them.
+ *
+ * The indices in `order` must be distinct and not smaller than `first`.  If
+ * they are sorted, the elements are moved in place.
+ */
+template<typename Container, typename Index>
+void move_elements( Container& elements, uint64_t first, std::vector<Index> const& order )
+{
+  if ( std::is_sorted( order.begin(), order.end() ) )
+  {
+    for ( uint64_t i = 0u; i < order.size(); ++i )
+    {
+      if ( order[i] != first + i )
+      {
+        elements[first + i] = std::as_const( elements )[order[i]];
+      }
+    }
+  }
+  else
+  {
+    std::vector<std::decay_t<decltype( elements[0] )>> moved;
+    moved.reserve( order.size() );
+    for ( auto const& i : order )
+    {
+      moved.push_back( std::as_const( elements )[i] );
+    }
+    for ( uint64_t i = 0u; i < moved.size(); ++i )
+    {
+      elements[first + i] = moved[i];
+    }
+  }
+  elements.resize( first + order.size() );
+}
+
+} /* namespace detail */
+
+/*! \brief Fan-out lists as intrusive, doubly-linked lists of fan-in edges.
+ *
+ * The `i`-th fan-in of node `n` is edge `n * num_fanins + i`.  Each node
+ * stores the first and last edge that points to it, and each edge stores
+ * its neighbors in the list of its fan-in.  Edges are linked and unlinked in
+ * constant time; new edges are appended, such that a list that is built by
+ * linking the gates in index order lists the fan-outs in index order.  A
+ * node that has the same fan-in twice is listed once.
+ */
+class fanout_lists
+{
+public:
+  static constexpr uint64_t none = std::numeric_limits<uint64_t>::max();
+
+  class iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = uint64_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type const*;
+    using reference = value_type;
+
+    iterator() = default;
+    iterator( fanout_lists const* lists, uint64_t edge ) : lists( lists ), edge( edge ) {}
+
+    value_type operator*() const
+    {
+      return edge / lists->num_fanins;
+    }
+
+    iterator& operator++()
+    {
+      const auto n = edge / lists->num_fanins;
+      do
+      {
+        edge = lists->edges[edge].next;
+      } while ( edge != none && edge / lists->num_fanins == n );
+      return *this;
+    }
+
+    iterator operator++( int )
+    {
+      auto it = *this;
+      ++( *this );
+      return it;
+    }
+
+    bool operator==( iterator const& other ) const
+    {
+      return edge == other.edge;
+    }
+
+    bool operator!=( iterator const& other ) const
+    {
+      return edge != other.edge;
+    }
+
+  private:
+    fanout_lists const* lists{ nullptr };
+    uint64_t edge{ none };
+  };
+
+  /*! \brief Removes all lists and sets the number of fan-ins per node. */
+  void reset( uint32_t fanins )
+  {
+    num_fanins = fanins;
+    std::vector<ends_t>().swap( ends );
+    std::vector<links_t>().swap( edges );
+  }
+
+  /*! \brief Appends the `i`-th fan-in edge of `n` to the list of `fanin`. */
+  void link( uint64_t n, uint32_t i, uint64_t fanin )
+  {
+    resize( std::max( n, fanin ) + 1u );
+
+    const auto e = n * num_fanins + i;
+    auto& end = ends[fanin];
+    edges[e] = { end.last, none };
+    ( end.last == none ? end.first : edges[end.last].next ) = e;
+    end.last = e;
+  }
+
+  /*! \brief Removes the `i`-th fan-in edge of `n` from the list of `fanin`. */
+  void unlink( uint64_t n, uint32_t i, uint64_t fanin )
+  {
+    const auto e = n * num_fanins + i;
+    auto& edge = edges[e];
+    ( edge.prev == none ? ends[fanin].first : edges[edge.prev].next ) = edge.next;
+    ( edge.next == none ? ends[fanin].last : edges[edge.next].prev ) = edge.prev;
+    edge = { none, none };
+  }
+
+  iterator begin( uint64_t n ) const
+  {
+    return { this, n < ends.size() ? ends[n].first : none };
+  }
+
+  iterator end() const
+  {
+    return { this, none };
+  }
+
+private:
+  void resize( uint64_t num_nodes )
+  {
+    if ( ends.size() < num_nodes )
+    {
+      ends.resize( num_nodes );
+      edges.resize( num_nodes * num_fanins );
+    }
+  }
+
+  struct ends_t
+  {
+    uint64_t first{ none };
+    uint64_t last{ none };
+  };
+
+  struct links_t
+  {
+    uint64_t prev{ none };
+    uint64_t next{ none };
+  };
+
+  uint32_t num_fanins{ 2u };
+  std::vector<ends_t> ends;
+  std::vector<links_t> edges;
+};
+
+template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>, typename HashPolicy = default_hash_policy>
+struct storage
+{
+  storage()
+  {
+    nodes.reserve( 10000u );
+    hash.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+  }
+
+  using node_type = Node;
+
+  uint32_t trav_id = 0u;
+
+  typename HashPolicy::template node_container<node_type> nodes;
+  std::vector<uint64_t> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+
+  typename HashPolicy::template map_type<node_type, uint64_t, NodeHasher> hash;
+
+  /* gates created without structural hashing since the last rehash */
+  uint64_t num_unhashed_gates = 0u;
+
+  /* dead nodes whose indices can be reused (if `reuse_dead_nodes` is set) */
+  bool reuse_dead_nodes = false;
+  std::vector<uint64_t> free_nodes;
+
+  /* smallest index of a node that may precede one of its fanins */
+  uint64_t unsorted_from = std::numeric_limits<uint64_t>::max();
+
+  /* fan-out lists of all nodes (kept while `fanout_users` is nonzero) */
+  uint32_t fanout_users = 0u;
+  fanout_lists fanouts;
+
+  T data;
+};
+
+/*! \brief Structure-of-arrays storage container
+ *
+ * Stores the fan-ins of all nodes (of type `Node`, usually a `fanin_node`) in
+ * one contiguous array, and the per-node data in separate arrays: the fan-out
+ * size (`refs`, whose MSB marks dead nodes), an application-specific value
+ * (`values`), the visited flag (`visited`), and whether the node is a terminal
+ * (`terminal`).  Sweeps that only follow fan-ins therefore only touch the
+ * fan-in array.  The structural hash table is keyed on the fan-ins.  Node
+ * indices (inputs, hash table values) have the word type of the node
+ * pointers.
+ *
+ * `HashPolicy` selects the containers of the fan-ins, the terminal flags, and
+ * the structural hash table (see `default_hash_policy`).  The other fields are
+ * the same as in `storage`.
+ */
+template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>, typename HashPolicy = soa_storage_policy>
+struct soa_storage
+{
+  soa_storage()
+  {
+    reserve( 10000u );
+    hash.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    emplace_back();
+  }
+
+  using node_type = Node;
+  using index_type = typename node_type::pointer_type::word_type;
+
+  uint64_t size() const
+  {
+    return nodes.size();
+  }
+
+  uint64_t capacity() const
+  {
+    return nodes.capacity();
+  }
+
+  void reserve( uint64_t n )
+  {
+    nodes.reserve( n );
+    refs.reserve( n );
+    values.reserve( n );
+    visited.reserve( n );
+    terminal.reserve( n );
+  }
+
+  node_type& emplace_back( node_type const& node = {} )
+  {
+    refs.emplace_back( 0u );
+    values.emplace_back( 0u );
+    visited.emplace_back( 0u );
+    terminal.emplace_back( 0u );
+    return nodes.emplace_back( node );
+  }
+
+  /*! \brief Replaces the node at `index` by `node` with zero data. */
+  void assign( uint64_t index, node_type const& node )
+  {
+    nodes[index] = node;
+    refs[index] = values[index] = visited[index] = 0u;
+    terminal[index] = 0u;
+  }
+
+  /*! \brief Moves the nodes (with their data), see `detail::move_elements`. */
+  template<typename Index>
+  void move_nodes( uint64_t first, std::vector<Index> const& order )
+  {
+    detail::move_elements( nodes, first, order );
+    detail::move_elements( refs, first, order );
+    detail::move_elements( values, first, order );
+    detail::move_elements( visited, first, order );
+    detail::move_elements( terminal, first, order );
+  }
+
+  uint32_t trav_id = 0u;
+
+  typename HashPolicy::template node_container<node_type> nodes;
+  std::vector<uint32_t> refs;
+  std::vector<uint32_t> values;
+  std::vector<uint32_t> visited;
+  typename HashPolicy::template node_container<uint8_t> terminal;
+
+  std::vector<index_type> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+
+  typename HashPolicy::template map_type<node_type, index_type, NodeHasher> hash;
+
+  /* gates created without structural hashing since the last rehash */
+  uint64_t num_unhashed_gates = 0u;
+
+  /* dead nodes whose indices can be reused (if `reuse_dead_nodes` is set) */
+  bool reuse_dead_nodes = false;
+  std::vector<index_type> free_nodes;
+
+  /* smallest index of a node that may precede one of its fanins */
+  uint64_t unsorted_from = std::numeric_limits<uint64_t>::max();
+
+  /* fan-out lists of all nodes (kept while `fanout_users` is nonzero) */
+  uint32_t fanout_users = 0u;
+  fanout_lists fanouts;
+
+  T data;
+};
+
+template<typename Node, typename T = empty_storage_data>
+struct storage_no_hash
+{
+  storage_no_hash()
+  {
+    nodes.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+  }
+
+  using node_type = Node;
+
+  uint32_t trav_id = 0u;
+
+  std::vector<node_type> nodes;
+  std::vector<uint64_t> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+
+  T data;
+};
+
+namespace detail
+{
+
+/* copies the arena-allocated fields of `nodes` into fresh arenas */
+template<typename Node>
+void relocate_arena_nodes( std::vector<Node>& nodes, chunked_arena<typename Node::pointer_type>& fanins, chunked_arena<cauint64_t>& node_data )
+{
+  for ( auto& n : nodes )
+  {
+    n.children = fanins.allocate( n.children.begin(), n.children.end() );
+    if constexpr ( std::is_same_v<std::decay_t<decltype( n.data )>, arena_span<cauint64_t>> )
+    {
+      n.data = node_data.allocate( n.data.begin(), n.data.end() );
+    }
+  }
+}
+
+} /* namespace detail */
+
+/*! \brief Storage container for nodes with a variable number of fan-ins
+ *
+ * The fan-ins of all nodes (of type `Node`, usually an `arena_fanin_node`) are
+ * stored back to back in the arena `fanins`, and nodes only keep a view on
+ * their fan-ins.  Nodes with variable-size data (`arena_block_node`) allocate
+ * it from `node_data`.  Creating a node therefore does not call the memory
+ * allocator for each node, and fan-ins of consecutive nodes are adjacent in
+ * memory.  Fan-ins can be modified in place, but not resized.
+ *
+ * The keys of the structural hash table share the fan-in memory with the
+ * nodes, i.e., a node must be removed from `hash` before its fan-ins are
+ * modified and inserted again afterwards.
+ */
+template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
+struct arena_storage
+{
+  arena_storage()
+  {
+    nodes.reserve( 10000u );
+    hash.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+  }
+
+  arena_storage( arena_storage const& other )
+      : trav_id( other.trav_id ),
+        nodes( other.nodes ),
+        inputs( other.inputs ),
+        outputs( other.outputs ),
+        data( other.data )
+  {
+    detail::relocate_arena_nodes( nodes, fanins, node_data );
+
+    hash.reserve( other.hash.size() );
+    for ( auto const& [_, index] : other.hash )
+    {
+      hash.emplace( nodes[index], index );
+    }
+  }
+
+  arena_storage( arena_storage&& ) = default;
+
+  arena_storage& operator=( arena_storage const& other )
+  {
+    return *this = arena_storage( other );
+  }
+
+  arena_storage& operator=( arena_storage&& ) = default;
+
+  using node_type = Node;
+
+  uint32_t trav_id = 0u;
+
+  chunked_arena<typename node_type::pointer_type> fanins;
+  chunked_arena<cauint64_t> node_data;
+
+  std::vector<node_type> nodes;
+  std::vector<uint64_t> inputs;
+  std::vector<typename node_type::pointer_type> outputs;
+
+  phmap::flat_hash_map<node_type, uint64_t, NodeHasher> hash;
+
+  T data;
+};
+
+/*! \brief Arena storage container without structural hash table
+ *
+ * Same as `arena_storage`, but without `hash`.
+ */
+template<typename Node, typename T = empty_storage_data>
+struct arena_storage_no_hash
+{
+  arena_storage_no_hash()
+  {
+    nodes.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+  }
+
+  arena_storage_no_hash( arena_storage_no_hash const& other )
+      : trav_id( other.trav_id ),
+        nodes( other.nodes ),
+        inputs( other.inputs ),
+        outputs( other.outputs ),
+        data( other.data )
+  {
+    detail::relocate_arena_nodes( nodes, fanins, node_data );
+  }
+
+  arena_storage_no_hash( arena_storage_no_hash&& ) = default;
+
+  arena_storage_no_hash& operator=( arena_storage_no_hash const& other )
+  {
+    return *this = arena_storage_no_hash( other );
+  }
+
+  arena_storage_no_hash& operator=( arena_storage_no_hash&& ) = default;
+
+  using node_type = Node;
+
+  uint32_t trav_id = 0u;
+
+  chunked_arena<typename node_type::pointer_type> fanins;
+  chunked_arena<cauint64_t> node_data;
 
   std::vector<node_type> nodes;
   std::vector<uint64_t> inputs;
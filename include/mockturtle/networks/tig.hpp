@@ -308,10 +308,7 @@ public:
     _storage->nodes[b.index].data[0].h1++;
     _storage->nodes[c.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( index );
 
     return { index, norm_res.output_compl };
   }
@@ -472,10 +469,7 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_modified )
-    {
-      ( *fn )( n, { old_child0, old_child1, old_child2 } );
-    }
+    _events->notify_modified( n, { old_child0, old_child1, old_child2 } );
 
     return std::nullopt;
   }
@@ -511,10 +505,7 @@ public:
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
-    for ( auto const& fn : _events->on_delete )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_delete( n );
 
     for ( auto i = 0u; i < 3u; ++i )
     {
@@ -539,10 +530,7 @@ public:
     nobj.data[0].h1 = UINT32_C( 0 ); /* fanout size 0, but not dead (like just created) */
     _storage->hash[nobj] = n;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_add( n );
 
     /* revive its children if dead, and increment their fanout_size */
     for ( auto i = 0u; i < 3u; ++i )
@@ -287,10 +287,7 @@ public:
 		_storage->nodes[b.index].data[0].h1++;
 		_storage->nodes[c.index].data[0].h1++;
 
-		for ( auto const& fn: _events->on_add )
-		{
-			( *fn )(index);
-		}
+		_events->notify_add( index );
 
 		return { index, false };
 	}
@@ -349,10 +346,7 @@ public:
     _storage->nodes[b.index].data[0].h1++;
     _storage->nodes[c.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _events->notify_add( index );
 
     return { index, fcompl };
 	}
@@ -575,10 +569,7 @@ public:
 
 		_storage->nodes[new_signal.index].data[0].h1++;
 
-		for ( auto const& fn: _events->on_modified )
-		{
-			( *fn )( n, { old_child0, old_child1, old_child2 } );
-		}
+		_events->notify_modified( n, { old_child0, old_child1, old_child2 } );
 
 		return std::nullopt;
 	}
@@ -611,10 +602,7 @@ public:
     nobj.data[0].h1 = UINT32_C( 0x80000000 );
     _storage->hash.erase( nobj );
 
-    for ( auto const& fn : _events->on_delete )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_delete( n );
 
     for ( auto i = 0u; i < 3u; ++i )
     {
@@ -41,10 +41,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <stack>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operators.hpp>
@@ -73,124 +77,164 @@ struct xag_hash
   }
 };
 
-/*! \brief XAG storage container
-
-  XAGs have nodes with fan-in 2.  We split of one bit of the index pointer to
-  store a complemented attribute.  Every node has 64-bit of additional data
-  used for the following purposes:
-
-  `data[0].h1`: Fan-out size (we use MSB to indicate whether a node is dead)
-  `data[0].h2`: Application-specific value
-  `data[1].h1`: Visited flag
-  `data[1].h2`: Is terminal node (PI or CI)
-*/
-using xag_storage = storage<regular_node<2, 2, 1>,
-                            empty_storage_data,
-                            xag_hash<regular_node<2, 2, 1>>>;
-
-class xag_network
+/*! \brief Signal of an XAG: a node index and a complemented attribute
+ *
+ * `Word` is the word type of the node pointers in the storage.
+ */
+template<typename Word>
+struct xag_signal
 {
-public:
-#pragma region Types and constructors
-  static constexpr auto min_fanin_size = 2u;
-  static constexpr auto max_fanin_size = 2u;
+  using pointer_type = node_pointer<1, Word>;
 
-  using base_type = xag_network;
-  using storage = std::shared_ptr<xag_storage>;
-  using node = uint64_t;
+  xag_signal() = default;
 
-  struct signal
+  xag_signal( uint64_t index, uint64_t complement )
+      : complement( complement ), index( index )
   {
-    signal() = default;
-
-    signal( uint64_t index, uint64_t complement )
-        : complement( complement ), index( index )
-    {
-    }
+  }
 
-    explicit signal( uint64_t data )
-        : data( data )
-    {
-    }
+  explicit xag_signal( uint64_t data )
+      : data( data )
+  {
+  }
 
-    signal( xag_storage::node_type::pointer_type const& p )
-        : complement( p.weight ), index( p.index )
-    {
-    }
+  xag_signal( pointer_type const& p )
+      : complement( p.weight ), index( p.index )
+  {
+  }
 
-    union
+  union
+  {
+    struct
     {
-      struct
-      {
-        uint64_t complement : 1;
-        uint64_t index : 63;
-      };
-      uint64_t data;
+      Word complement : 1;
+      Word index : sizeof( Word ) * 8 - 1;
     };
+    Word data;
+  };
 
-    signal operator!() const
-    {
-      return signal( data ^ 1 );
-    }
+  xag_signal operator!() const
+  {
+    return xag_signal( data ^ 1 );
+  }
 
-    signal operator+() const
-    {
-      return { index, 0 };
-    }
+  xag_signal operator+() const
+  {
+    return { index, 0 };
+  }
 
-    signal operator-() const
-    {
-      return { index, 1 };
-    }
+  xag_signal operator-() const
+  {
+    return { index, 1 };
+  }
 
-    signal operator^( bool complement ) const
-    {
-      return signal( data ^ ( complement ? 1 : 0 ) );
-    }
+  xag_signal operator^( bool complement ) const
+  {
+    return xag_signal( data ^ ( complement ? 1 : 0 ) );
+  }
 
-    bool operator==( signal const& other ) const
-    {
-      return data == other.data;
-    }
+  bool operator==( xag_signal const& other ) const
+  {
+    return data == other.data;
+  }
 
-    bool operator!=( signal const& other ) const
-    {
-      return data != other.data;
-    }
+  bool operator!=( xag_signal const& other ) const
+  {
+    return data != other.data;
+  }
 
-    bool operator<( signal const& other ) const
-    {
-      return data < other.data;
-    }
+  bool operator<( xag_signal const& other ) const
+  {
+    return data < other.data;
+  }
 
-    operator xag_storage::node_type::pointer_type() const
-    {
-      return { index, complement };
-    }
+  operator pointer_type() const
+  {
+    return { index, complement };
+  }
 
 #if __cplusplus > 201703L
-    bool operator==( xag_storage::node_type::pointer_type const& other ) const
-    {
-      return data == other.data;
-    }
+  bool operator==( pointer_type const& other ) const
+  {
+    return data == other.data;
+  }
 #endif
-  };
+};
+
+/*! \brief XAG storage container
+
+  XAGs have nodes with fan-in 2.  We split of one bit of the index pointer to
+  store a complemented attribute.  Every node has 64-bit of additional data
+  used for the following purposes:
+
+  `data[0].h1`: Fan-out size (we use MSB to indicate whether a node is dead)
+  `data[0].h2`: Application-specific value
+  `data[1].h1`: Visited flag
+  `data[1].h2`: Is terminal node (PI or CI)
+
+  If `HashPolicy::separate_node_data` is set (see `soa_storage_policy`), the
+  nodes only contain their fan-ins and the data is kept in the separate
+  arrays `refs`, `values`, `visited`, and `terminal` of a `soa_storage`.
+  `HashPolicy::index_type` is the word type of the node pointers (see
+  `compact_storage_policy`).
+*/
+template<class HashPolicy = default_hash_policy>
+using basic_xag_storage = std::conditional_t<HashPolicy::separate_node_data,
+                                             soa_storage<fanin_node<2, 1, typename HashPolicy::index_type>,
+                                                         empty_storage_data,
+                                                         xag_hash<fanin_node<2, 1, typename HashPolicy::index_type>>,
+                                                         HashPolicy>,
+                                             storage<regular_node<2, 2, 1, typename HashPolicy::index_type>,
+                                                     empty_storage_data,
+                                                     xag_hash<regular_node<2, 2, 1, typename HashPolicy::index_type>>,
+                                                     HashPolicy>>;
+
+using xag_storage = basic_xag_storage<>;
+
+/*! \brief XOR-and graph
+ *
+ * `HashPolicy` selects the structural hash table and the layout of the
+ * storage (see `default_hash_policy`, `parallel_hash_policy`, and
+ * `soa_storage_policy`).  `Derived` is the
+ * network class that derives from this template (e.g., `xag_network`), which
+ * is then used as `base_type`.
+ */
+template<class HashPolicy = default_hash_policy, class Derived = void>
+class basic_xag_network
+{
+public:
+#pragma region Types and constructors
+  static constexpr bool is_xag_network_type = true;
+  static constexpr auto min_fanin_size = 2u;
+  static constexpr auto max_fanin_size = 2u;
 
-  xag_network()
-      : _storage( std::make_shared<xag_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  using base_type = std::conditional_t<std::is_void_v<Derived>, basic_xag_network, Derived>;
+  using storage = std::shared_ptr<basic_xag_storage<HashPolicy>>;
+  using node = typename HashPolicy::index_type;
+
+  using signal = xag_signal<node>;
+
+  basic_xag_network()
+      : _storage( std::make_shared<basic_xag_storage<HashPolicy>>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  xag_network( std::shared_ptr<xag_storage> storage )
+  basic_xag_network( std::shared_ptr<basic_xag_storage<HashPolicy>> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  xag_network clone() const
+  base_type clone() const
   {
-    return { std::make_shared<xag_storage>( *_storage ) };
+    auto storage = std::make_shared<basic_xag_storage<HashPolicy>>( *_storage );
+
+    /* the fan-out lists belong to the users of this network (see `acquire_fanouts`) */
+    storage->fanout_users = 0u;
+    storage->fanouts.reset( 2u );
+
+    return { storage };
   }
 #pragma endregion
 
@@ -203,9 +247,9 @@ public:
   signal create_pi()
   {
     const auto index = _storage->nodes.size();
-    auto& node = _storage->nodes.emplace_back();
+    auto& node = _emplace_node();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
-    node.data[1].h2 = 1; // mark as PI
+    _set_terminal( index ); // mark as PI
     _storage->inputs.emplace_back( index );
     return { index, 0 };
   }
@@ -213,7 +257,7 @@ public:
   uint32_t create_po( signal const& f )
   {
     /* increase ref-count to children */
-    _storage->nodes[f.index].data[0].h1++;
+    incr_fanout_size( f.index );
     auto const po_index = static_cast<uint32_t>( _storage->outputs.size() );
     _storage->outputs.emplace_back( f.index, f.complement );
     return po_index;
@@ -231,12 +275,12 @@ public:
 
   bool is_ci( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h2 == 1;
+    return _is_terminal( n );
   }
 
   bool is_pi( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h2 == 1 && !is_constant( n );
+    return _is_terminal( n ) && !is_constant( n );
   }
 
   bool constant_value( node const& n ) const
@@ -261,7 +305,7 @@ public:
 #pragma region Create binary functions
   signal _create_node( signal a, signal b )
   {
-    storage::element_type::node_type node;
+    typename storage::element_type::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -272,26 +316,17 @@ public:
       return { it->second, 0 };
     }
 
-    const auto index = _storage->nodes.size();
-
-    if ( index >= .9 * _storage->nodes.capacity() )
-    {
-      _storage->nodes.reserve( static_cast<uint64_t>( 3.1415f * index ) );
-      _storage->hash.reserve( static_cast<uint64_t>( 3.1415f * index ) );
-    }
-
-    _storage->nodes.push_back( node );
+    const auto index = _insert_node( node );
 
     _storage->hash[node] = index;
 
     /* increase ref-count to children */
-    _storage->nodes[a.index].data[0].h1++;
-    _storage->nodes[b.index].data[0].h1++;
+    incr_fanout_size( a.index );
+    incr_fanout_size( b.index );
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _link_fanins( index );
+
+    _events->notify_add( index );
 
     return { index, 0 };
   }
@@ -419,7 +454,7 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( xag_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_xag_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( children.size() == 2u );
     if ( other.is_and( source ) )
@@ -434,7 +469,12 @@ public:
 #pragma endregion
 
 #pragma region Has node
-  std::optional<signal> has_and( signal a, signal b )
+  /*! \brief Looks up an AND gate in the structural hash table.
+   *
+   * Does not modify the network; it is safe to call this function from
+   * several threads as long as no thread modifies the network.
+   */
+  std::optional<signal> has_and( signal a, signal b ) const
   {
     /* order inputs */
     if ( a.index > b.index )
@@ -452,7 +492,7 @@ public:
       return a.complement == false ? get_constant( false ) : b;
     }
 
-    storage::element_type::node_type node;
+    typename storage::element_type::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -467,7 +507,11 @@ public:
     return {};
   }
 
-  std::optional<signal> has_xor( signal a, signal b )
+  /*! \brief Looks up an XOR gate in the structural hash table.
+   *
+   * Thread-safe under the same conditions as `has_and`.
+   */
+  std::optional<signal> has_xor( signal a, signal b ) const
   {
     /* order inputs */
     if ( a.index < b.index )
@@ -488,7 +532,7 @@ public:
       return a ^ f_compl;
     }
 
-    storage::element_type::node_type node;
+    typename storage::element_type::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -504,6 +548,250 @@ public:
   }
 #pragma endregion
 
+#pragma region Bulk construction
+  /*! \brief Reserves memory for `num_nodes` nodes (including constants and PIs). */
+  void reserve( uint64_t num_nodes )
+  {
+    _reserve_nodes( num_nodes );
+    _storage->hash.reserve( num_nodes );
+  }
+
+  signal _create_node_no_strash( signal a, signal b )
+  {
+    const auto index = _storage->nodes.size();
+    auto& node = _emplace_node();
+    node.children[0] = a;
+    node.children[1] = b;
+
+    /* increase ref-count to children */
+    incr_fanout_size( a.index );
+    incr_fanout_size( b.index );
+
+    _link_fanins( index );
+    ++_storage->num_unhashed_gates;
+
+    _events->notify_add( index );
+
+    return { index, 0 };
+  }
+
+  /*! \brief Creates an AND gate without structural hashing.
+   *
+   * Trivial cases are simplified as in `create_and`, but the gate is neither
+   * looked up in nor inserted into the structural hash table.  The structural
+   * hash table (and hence `has_and` and `has_xor`) is invalid until `rehash`
+   * is called.
+   */
+  signal create_and_no_strash( signal a, signal b )
+  {
+    /* order inputs a < b it is a AND */
+    if ( a.index > b.index )
+    {
+      std::swap( a, b );
+    }
+    if ( a.index == b.index )
+    {
+      return a.complement == b.complement ? a : get_constant( false );
+    }
+    else if ( a.index == 0 )
+    {
+      return a.complement == false ? get_constant( false ) : b;
+    }
+    return _create_node_no_strash( a, b );
+  }
+
+  /*! \brief Creates an XOR gate without structural hashing.
+   *
+   * See `create_and_no_strash`.
+   */
+  signal create_xor_no_strash( signal a, signal b )
+  {
+    /* order inputs a > b it is a XOR */
+    if ( a.index < b.index )
+    {
+      std::swap( a, b );
+    }
+
+    bool f_compl = a.complement != b.complement;
+    a.complement = b.complement = false;
+
+    if ( a.index == b.index )
+    {
+      return get_constant( f_compl );
+    }
+    else if ( b.index == 0 )
+    {
+      return a ^ f_compl;
+    }
+
+    return _create_node_no_strash( a, b ) ^ f_compl;
+  }
+
+  /*! \brief Rebuilds the structural hash table.
+   *
+   * Processes all gates in index order, which must be a topological order
+   * (as for networks constructed by appending gates).  A gate that is
+   * structurally equivalent to a previous gate, or that becomes trivial after
+   * its fanins have been replaced, is replaced by its representative and
+   * taken out of the network; fanins and outputs are updated accordingly.
+   *
+   * Returns the representative signal of each node if some node has been
+   * replaced, and an empty vector otherwise.
+   *
+   * If the network uses `parallel_hash_policy`, the table is filled by
+   * `num_threads` threads.  Should the network contain structurally
+   * equivalent gates, the table is rebuilt sequentially to merge them.
+   */
+  std::vector<signal> rehash( uint32_t num_threads = 1u )
+  {
+    _storage->hash.clear();
+    _storage->num_unhashed_gates = 0u;
+    _storage->hash.reserve( _storage->nodes.size() );
+
+    if constexpr ( detail::is_parallel_hash_map<std::decay_t<decltype( _storage->hash )>>::value )
+    {
+      if ( num_threads > 1u )
+      {
+        const auto is_gate = [this]( uint64_t n ) { return n != 0u && !is_ci( n ) && !is_dead( n ); };
+        if ( detail::parallel_fill_hash( _storage->hash, _storage->nodes, num_threads, is_gate ) )
+        {
+          return {};
+        }
+        _storage->hash.clear();
+      }
+    }
+    else
+    {
+      (void)num_threads;
+    }
+
+    /* allocated on the first replacement */
+    std::vector<signal> repr;
+
+    const auto resolve = [&]( signal const& f ) {
+      return repr.empty() ? f : repr[f.index] ^ f.complement;
+    };
+
+    const auto replace = [&]( node const& n, signal const& f ) {
+      if ( repr.empty() )
+      {
+        repr.resize( _storage->nodes.size() );
+        for ( auto i = 0u; i < repr.size(); ++i )
+        {
+          repr[i] = signal( i, 0 );
+        }
+      }
+      repr[n] = f;
+
+      auto& nobj = _storage->nodes[n];
+      for ( auto const& c : nobj.children )
+      {
+        if ( !is_dead( c.index ) )
+        {
+          decr_fanout_size( c.index );
+        }
+      }
+      _set_refs( n, UINT32_C( 0x80000000 ) ); /* fanout size 0, but dead */
+
+      _events->notify_delete( n );
+    };
+
+    for ( node n = 1u; n < _storage->nodes.size(); ++n )
+    {
+      if ( is_ci( n ) || is_dead( n ) )
+      {
+        continue;
+      }
+
+      auto& nobj = _storage->nodes[n];
+      bool f_compl{ false };
+      if ( !repr.empty() )
+      {
+        auto a = resolve( nobj.children[0] );
+        auto b = resolve( nobj.children[1] );
+        if ( a != signal( nobj.children[0] ) || b != signal( nobj.children[1] ) )
+        {
+          assert( a.index < n && b.index < n );
+          const auto and_gate = nobj.children[0].index < nobj.children[1].index;
+          for ( auto const& c : nobj.children )
+          {
+            if ( !is_dead( c.index ) )
+            {
+              decr_fanout_size( c.index );
+            }
+          }
+
+          if ( and_gate ? a.index > b.index : a.index < b.index )
+          {
+            std::swap( a, b );
+          }
+          if ( !and_gate )
+          {
+            f_compl = a.complement != b.complement;
+            a.complement = b.complement = false;
+          }
+          nobj.children[0] = a;
+          nobj.children[1] = b;
+          incr_fanout_size( a.index );
+          incr_fanout_size( b.index );
+
+          /* trivial cases */
+          if ( and_gate && a.index == b.index )
+          {
+            replace( n, ( a.complement == b.complement ) ? a : get_constant( false ) );
+            continue;
+          }
+          else if ( and_gate && a.index == 0 )
+          {
+            replace( n, a.complement ? b : get_constant( false ) );
+            continue;
+          }
+          else if ( !and_gate && a.index == b.index )
+          {
+            replace( n, get_constant( f_compl ) );
+            continue;
+          }
+          else if ( !and_gate && b.index == 0 )
+          {
+            replace( n, a ^ f_compl );
+            continue;
+          }
+        }
+      }
+
+      if ( const auto [it, inserted] = _storage->hash.try_emplace( nobj, n ); !inserted )
+      {
+        replace( n, signal( it->second, f_compl ) );
+      }
+      else if ( f_compl )
+      {
+        repr[n] = signal( n, 1 );
+      }
+    }
+
+    if ( !repr.empty() )
+    {
+      for ( auto& output : _storage->outputs )
+      {
+        const auto f = resolve( output );
+        if ( f != signal( output ) )
+        {
+          if ( !is_dead( output.index ) )
+          {
+            decr_fanout_size( output.index );
+          }
+          incr_fanout_size( f.index );
+          output = f;
+        }
+      }
+
+      _rebuild_fanouts();
+    }
+
+    return repr;
+  }
+#pragma endregion
+
 #pragma region Restructuring
   std::optional<std::pair<node, signal>> replace_in_node( node const& n, node const& old_node, signal new_signal )
   {
@@ -560,7 +848,7 @@ public:
     }
 
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename storage::element_type::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
     if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() && it->second != old_node )
@@ -574,20 +862,24 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _unlink_fanins( n );
 
     // insert updated node into hash table
     node.children[0] = child0;
     node.children[1] = child1;
     _storage->hash[node] = n;
 
-    // update the reference counter of the new signal
-    _storage->nodes[new_signal.index].data[0].h1++;
-
-    for ( auto const& fn : _events->on_modified )
+    if ( new_signal.index > n )
     {
-      ( *fn )( n, { old_child0, old_child1 } );
+      _mark_unsorted( n );
     }
 
+    // update the reference counter of the new signal
+    incr_fanout_size( new_signal.index );
+    _link_fanins( n );
+
+    _events->notify_modified( n, { old_child0, old_child1 } );
+
     return std::nullopt;
   }
 
@@ -646,6 +938,7 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _unlink_fanins( n );
 
     // insert updated node into hash table
     node.children[0] = child0;
@@ -655,13 +948,16 @@ public:
       _storage->hash[node] = n;
     }
 
-    // update the reference counter of the new signal
-    _storage->nodes[new_signal.index].data[0].h1++;
-
-    for ( auto const& fn : _events->on_modified )
+    if ( new_signal.index > n )
     {
-      ( *fn )( n, { old_child0, old_child1 } );
+      _mark_unsorted( n );
     }
+
+    // update the reference counter of the new signal
+    incr_fanout_size( new_signal.index );
+    _link_fanins( n );
+
+    _events->notify_modified( n, { old_child0, old_child1 } );
   }
 
   void replace_in_outputs( node const& old_node, signal const& new_signal )
@@ -679,7 +975,7 @@ public:
         if ( old_node != new_signal.index )
         {
           /* increment fan-in of new node */
-          _storage->nodes[new_signal.index].data[0].h1++;
+          incr_fanout_size( new_signal.index );
         }
       }
     }
@@ -691,15 +987,18 @@ public:
     if ( n == 0 || is_ci( n ) || is_dead( n ) )
       return;
 
-    auto& nobj = _storage->nodes[n];
-    nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
+    _set_refs( n, UINT32_C( 0x80000000 ) ); /* fanout size 0, but dead */
+    auto const& nobj = _nodes()[n];
     _storage->hash.erase( nobj );
+    _unlink_fanins( n );
 
-    for ( auto const& fn : _events->on_delete )
+    if ( _storage->reuse_dead_nodes )
     {
-      ( *fn )( n );
+      _storage->free_nodes.push_back( n );
     }
 
+    _events->notify_delete( n );
+
     for ( auto i = 0u; i < 2u; ++i )
     {
       if ( fanout_size( nobj.children[i].index ) == 0 )
@@ -719,14 +1018,12 @@ public:
       return;
 
     assert( n < _storage->nodes.size() );
-    auto& nobj = _storage->nodes[n];
-    nobj.data[0].h1 = UINT32_C( 0 ); /* fanout size 0, but not dead (like just created) */
+    _set_refs( n, UINT32_C( 0 ) ); /* fanout size 0, but not dead (like just created) */
+    auto const& nobj = _nodes()[n];
     _storage->hash[nobj] = n;
+    _link_fanins( n );
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_add( n );
 
     /* revive its children if dead, and increment their fanout_size */
     for ( auto i = 0u; i < 2u; ++i )
@@ -741,11 +1038,14 @@ public:
 
   inline bool is_dead( node const& n ) const
   {
-    return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
+    return ( _refs( n ) >> 31 ) & 1;
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
   {
+    /* report each modified parent once per replaced node */
+    _events->begin_batch();
+
     std::unordered_map<node, signal> old_to_new;
     std::stack<std::pair<node, signal>> to_substitute;
     to_substitute.push( { old_node, new_signal } );
@@ -772,16 +1072,15 @@ public:
         revive_node( get_node( _new ) );
       }
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
-        if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
-
+      _foreach_parent( _old, [&]( node const& idx ) {
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
+
+      /* deliver the modifications before the redundant parents are substituted */
+      _events->flush_batch();
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -793,6 +1092,8 @@ public:
         take_out_node( _old );
       }
     }
+
+    _events->end_batch();
   }
 
   void substitute_node_no_restrash( node const& old_node, signal const& new_signal )
@@ -802,13 +1103,9 @@ public:
       revive_node( get_node( new_signal ) );
     }
 
-    for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-    {
-      if ( is_ci( idx ) || is_dead( idx ) )
-        continue; /* ignore CIs and dead nodes */
-
+    _foreach_parent( old_node, [&]( node const& idx ) {
       replace_in_node_no_restrash( idx, old_node, new_signal );
-    }
+    } );
 
     /* check outputs */
     replace_in_outputs( old_node, new_signal );
@@ -821,25 +1118,338 @@ public:
   }
 #pragma endregion
 
-#pragma region Structural properties
-  auto size() const
+#pragma region Compaction
+  /*! \brief Enables or disables the reuse of dead nodes.
+   *
+   * If enabled, the indices of dead nodes are reused when creating new
+   * gates, such that the network does not grow in long-running optimization
+   * loops.  As a consequence, node indices are no longer in topological
+   * order, and signals pointing to dead nodes must not be used anymore
+   * (e.g., to revive them).  Call `compact` to restore a topological order.
+   */
+  void set_node_reuse( bool enable )
   {
-    return static_cast<uint32_t>( _storage->nodes.size() );
-  }
+    _storage->reuse_dead_nodes = enable;
+    _storage->free_nodes.clear();
 
-  auto num_cis() const
-  {
-    return static_cast<uint32_t>( _storage->inputs.size() );
+    if ( enable )
+    {
+      for ( node n = 1u; n < _storage->nodes.size(); ++n )
+      {
+        if ( !is_ci( n ) && is_dead( n ) )
+        {
+          _storage->free_nodes.push_back( n );
+        }
+      }
+    }
   }
 
-  auto num_cos() const
+  /*! \brief Removes dead nodes and renumbers the network in place.
+   *
+   * The constant and the CIs (in their order) are followed by all live gates
+   * in topological order.  Fanins, CIs, COs, and the structural hash table
+   * are updated accordingly; fanout sizes and node values are kept.
+   *
+   * Returns a map from old to new node indices, in which dead nodes are
+   * mapped to a value not smaller than `size()`.  Node maps of the network
+   * can be updated using `node_map::compact`; views that store node maps
+   * must be reconstructed.
+   */
+  std::vector<node> compact()
   {
-    return static_cast<uint32_t>( _storage->outputs.size() );
-  }
+    auto& nodes = _storage->nodes;
+    const node removed = nodes.size();
+    std::vector<node> old_to_new( nodes.size(), removed );
 
-  auto num_pis() const
-  {
-    return static_cast<uint32_t>( _storage->inputs.size() );
+    std::vector<node> order;
+    order.reserve( nodes.size() );
+    old_to_new[0] = 0u;
+    order.push_back( 0u );
+    for ( auto const& n : _storage->inputs )
+    {
+      old_to_new[n] = order.size();
+      order.push_back( n );
+    }
+
+    /* live gates in topological order */
+    std::vector<node> stack;
+    for ( node n = 1u; n < nodes.size(); ++n )
+    {
+      if ( old_to_new[n] != removed || is_dead( n ) )
+      {
+        continue;
+      }
+
+      stack.push_back( n );
+      while ( !stack.empty() )
+      {
+        const auto m = stack.back();
+        if ( old_to_new[m] != removed )
+        {
+          stack.pop_back();
+          continue;
+        }
+
+        bool ready = true;
+        for ( auto const& c : nodes[m].children )
+        {
+          assert( !is_dead( c.index ) );
+          if ( old_to_new[c.index] == removed )
+          {
+            stack.push_back( c.index );
+            ready = false;
+          }
+        }
+
+        if ( ready )
+        {
+          stack.pop_back();
+          old_to_new[m] = order.size();
+          order.push_back( m );
+        }
+      }
+    }
+
+    /* move nodes (in place if the order is unchanged) */
+    _move_nodes( 0u, order );
+
+    _storage->hash.clear();
+    _storage->num_unhashed_gates = 0u;
+    for ( node n = 1u + _storage->inputs.size(); n < nodes.size(); ++n )
+    {
+      /* keep the gate type, which is given by the order of the fanins */
+      auto& nobj = nodes[n];
+      const auto is_and = nobj.children[0].index < nobj.children[1].index;
+      for ( auto& c : nobj.children )
+      {
+        c.index = old_to_new[c.index];
+      }
+      if ( is_and != ( nobj.children[0].index < nobj.children[1].index ) )
+      {
+        std::swap( nobj.children[0], nobj.children[1] );
+      }
+      _storage->hash.try_emplace( nobj, n );
+    }
+
+    for ( auto& n : _storage->inputs )
+    {
+      n = old_to_new[n];
+    }
+    for ( auto& output : _storage->outputs )
+    {
+      output.index = old_to_new[output.index];
+    }
+    _storage->free_nodes.clear();
+    _storage->unsorted_from = std::numeric_limits<uint64_t>::max();
+    _rebuild_fanouts();
+
+    return old_to_new;
+  }
+#pragma endregion
+
+#pragma region Fan-out lists
+  /*! \brief Acquires the fan-out lists in the storage.
+   *
+   * While the lists are acquired, the storage keeps, for each node, the list
+   * of gates that have the node as fanin.  The lists are computed in index
+   * order by the first user and then updated in constant time whenever a gate
+   * is created, modified, taken out, or revived; `substitute_node` only
+   * visits the fan-outs of the substituted node.  Each call must be paired
+   * with a call to `release_fanouts`.  `fanout_view` acquires the lists for
+   * its lifetime and forwards to them.
+   */
+  void acquire_fanouts()
+  {
+    if ( _storage->fanout_users++ == 0u )
+    {
+      _rebuild_fanouts();
+    }
+  }
+
+  /*! \brief Releases the fan-out lists; they are dropped with the last user. */
+  void release_fanouts()
+  {
+    assert( _storage->fanout_users > 0u );
+    if ( --_storage->fanout_users == 0u )
+    {
+      _rebuild_fanouts();
+    }
+  }
+
+  bool is_tracking_fanouts() const
+  {
+    return _storage->fanout_users > 0u;
+  }
+
+  /*! \brief Recomputes the fan-out lists in index order. */
+  void rebuild_fanouts()
+  {
+    _rebuild_fanouts();
+  }
+
+  /*! \brief Calls `fn` on the gates that have `n` as fanin.
+   *
+   * Requires acquired fan-out lists (see `acquire_fanouts`).
+   */
+  template<typename Fn>
+  void foreach_tracked_fanout( node const& n, Fn&& fn ) const
+  {
+    assert( _storage->fanout_users > 0u );
+    detail::foreach_element( _storage->fanouts.begin( n ), _storage->fanouts.end(), fn );
+  }
+#pragma endregion
+
+#pragma region Topological order
+  /*! \brief Returns whether node indices are in topological order.
+   *
+   * The property holds for networks that are constructed by appending nodes.
+   * It is invalidated when a fanin is replaced by a node with a larger index
+   * (e.g., in `substitute_node`) or when a dead node is reused, and restored by
+   * `compact` and `restore_topo_order`.  Changes to the storage that bypass
+   * the network interface are not tracked.
+   */
+  bool is_topo_sorted() const
+  {
+    return _storage->unsorted_from == std::numeric_limits<uint64_t>::max();
+  }
+
+  /*! \brief Restores a topological order of the node indices.
+   *
+   * Only the nodes starting from the first node that may violate the order
+   * are renumbered; dead nodes are kept.  Fanins, CIs, COs, and the
+   * structural hash table are updated accordingly.  Returns a map from old to
+   * new node indices (see `node_map::compact`), which is empty if the network
+   * has been topologically sorted.
+   */
+  std::vector<node> restore_topo_order()
+  {
+    auto& nodes = _storage->nodes;
+    const node first = std::min<uint64_t>( _storage->unsorted_from, nodes.size() );
+    _storage->unsorted_from = std::numeric_limits<uint64_t>::max();
+    if ( first == nodes.size() )
+    {
+      return {};
+    }
+
+    const node unplaced = nodes.size();
+    std::vector<node> old_to_new( nodes.size(), unplaced );
+    for ( node n = 0u; n < first; ++n )
+    {
+      old_to_new[n] = n;
+    }
+
+    /* order the remaining nodes, fanins first */
+    const auto is_gate = [&]( node const& n ) { return !is_ci( n ) && !is_dead( n ); };
+    std::vector<node> order;
+    std::vector<node> stack;
+    for ( node n = first; n < nodes.size(); ++n )
+    {
+      stack.push_back( n );
+      while ( !stack.empty() )
+      {
+        const auto m = stack.back();
+        if ( old_to_new[m] != unplaced )
+        {
+          stack.pop_back();
+          continue;
+        }
+
+        bool ready = true;
+        if ( is_gate( m ) )
+        {
+          for ( auto const& c : nodes[m].children )
+          {
+            if ( old_to_new[c.index] == unplaced )
+            {
+              stack.push_back( c.index );
+              ready = false;
+            }
+          }
+        }
+
+        if ( ready )
+        {
+          stack.pop_back();
+          old_to_new[m] = first + order.size();
+          order.push_back( m );
+        }
+      }
+    }
+
+    /* move the nodes and update their fanins */
+    std::vector<bool> hashed;
+    hashed.reserve( order.size() );
+    for ( auto const& n : order )
+    {
+      const auto it = _storage->hash.find( nodes[n] );
+      hashed.push_back( is_gate( n ) && it != _storage->hash.end() && it->second == n );
+      if ( hashed.back() )
+      {
+        _storage->hash.erase( nodes[n] );
+      }
+    }
+    _move_nodes( first, order );
+    for ( node i = 0u; i < order.size(); ++i )
+    {
+      const node n = first + i;
+      if ( is_ci( n ) )
+      {
+        continue;
+      }
+      auto& nobj = nodes[n];
+      const auto is_and = nobj.children[0].index < nobj.children[1].index;
+      for ( auto& c : nobj.children )
+      {
+        c.index = old_to_new[c.index];
+      }
+      if ( is_and != ( nobj.children[0].index < nobj.children[1].index ) )
+      {
+        std::swap( nobj.children[0], nobj.children[1] );
+      }
+      if ( hashed[i] )
+      {
+        _storage->hash[nobj] = n;
+      }
+    }
+
+    for ( auto& n : _storage->inputs )
+    {
+      n = old_to_new[n];
+    }
+    for ( auto& output : _storage->outputs )
+    {
+      output.index = old_to_new[output.index];
+    }
+    for ( auto& n : _storage->free_nodes )
+    {
+      n = old_to_new[n];
+    }
+
+    _rebuild_fanouts();
+
+    return old_to_new;
+  }
+#pragma endregion
+
+#pragma region Structural properties
+  auto size() const
+  {
+    return static_cast<uint32_t>( _storage->nodes.size() );
+  }
+
+  auto num_cis() const
+  {
+    return static_cast<uint32_t>( _storage->inputs.size() );
+  }
+
+  auto num_cos() const
+  {
+    return static_cast<uint32_t>( _storage->outputs.size() );
+  }
+
+  auto num_pis() const
+  {
+    return static_cast<uint32_t>( _storage->inputs.size() );
   }
 
   auto num_pos() const
@@ -849,7 +1459,7 @@ public:
 
   auto num_gates() const
   {
-    return static_cast<uint32_t>( _storage->hash.size() );
+    return static_cast<uint32_t>( _storage->hash.size() + _storage->num_unhashed_gates );
   }
 
   uint32_t fanin_size( node const& n ) const
@@ -861,17 +1471,31 @@ public:
 
   uint32_t fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    return _refs( n ) & UINT32_C( 0x7FFFFFFF );
   }
 
   uint32_t incr_fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      return _storage->refs[n]++ & UINT32_C( 0x7FFFFFFF );
+    }
+    else
+    {
+      return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
+    }
   }
 
   uint32_t decr_fanout_size( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      return --_storage->refs[n] & UINT32_C( 0x7FFFFFFF );
+    }
+    else
+    {
+      return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    }
   }
 
   bool is_and( node const& n ) const
@@ -1039,7 +1663,7 @@ public:
   template<typename Fn>
   void foreach_node( Fn&& fn ) const
   {
-    auto r = range<uint64_t>( _storage->nodes.size() );
+    auto r = range<node>( _storage->nodes.size() );
     detail::foreach_element_if(
         r.begin(), r.end(),
         [this]( auto n ) { return !is_dead( n ); },
@@ -1073,7 +1697,7 @@ public:
   template<typename Fn>
   void foreach_gate( Fn&& fn ) const
   {
-    auto r = range<uint64_t>( 1u, _storage->nodes.size() ); /* start from 1 to avoid constant */
+    auto r = range<node>( 1u, _storage->nodes.size() ); /* start from 1 to avoid constant */
     detail::foreach_element_if(
         r.begin(), r.end(),
         [this]( auto n ) { return !is_ci( n ) && !is_dead( n ); },
@@ -1202,44 +1826,100 @@ public:
 #pragma region Custom node values
   void clear_values() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      std::fill( _storage->values.begin(), _storage->values.end(), 0u );
+    }
+    else
+    {
+      std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+    }
   }
 
   auto value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2;
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      return _storage->values[n];
+    }
+    else
+    {
+      return _nodes()[n].data[0].h2;
+    }
   }
 
   void set_value( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[0].h2 = v;
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      _storage->values[n] = v;
+    }
+    else
+    {
+      _storage->nodes[n].data[0].h2 = v;
+    }
   }
 
   auto incr_value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2++;
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      return _storage->values[n]++;
+    }
+    else
+    {
+      return _storage->nodes[n].data[0].h2++;
+    }
   }
 
   auto decr_value( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h2;
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      return --_storage->values[n];
+    }
+    else
+    {
+      return --_storage->nodes[n].data[0].h2;
+    }
   }
 #pragma endregion
 
 #pragma region Visited flags
   void clear_visited() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      std::fill( _storage->visited.begin(), _storage->visited.end(), 0u );
+    }
+    else
+    {
+      std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+    }
   }
 
   auto visited( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h1;
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      return _storage->visited[n];
+    }
+    else
+    {
+      return _nodes()[n].data[1].h1;
+    }
   }
 
   void set_visited( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[1].h1 = v;
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      _storage->visited[n] = v;
+    }
+    else
+    {
+      _storage->nodes[n].data[1].h1 = v;
+    }
   }
 
   uint32_t trav_id() const
@@ -1260,20 +1940,251 @@ public:
   }
 #pragma endregion
 
+protected:
+  /* appends node `n` to the fan-out lists of its fanins (see `acquire_fanouts`) */
+  void _link_fanins( node const& n )
+  {
+    if ( _storage->fanout_users > 0u )
+    {
+      auto const& nobj = _nodes()[n];
+      _storage->fanouts.link( n, 0u, nobj.children[0].index );
+      _storage->fanouts.link( n, 1u, nobj.children[1].index );
+    }
+  }
+
+  /* removes node `n` from the fan-out lists of its fanins */
+  void _unlink_fanins( node const& n )
+  {
+    if ( _storage->fanout_users > 0u )
+    {
+      auto const& nobj = _nodes()[n];
+      _storage->fanouts.unlink( n, 0u, nobj.children[0].index );
+      _storage->fanouts.unlink( n, 1u, nobj.children[1].index );
+    }
+  }
+
+  /* recomputes the fan-out lists of all gates in index order */
+  void _rebuild_fanouts()
+  {
+    _storage->fanouts.reset( 2u );
+    if ( _storage->fanout_users == 0u )
+    {
+      return;
+    }
+
+    for ( node n = 1u; n < _storage->nodes.size(); ++n )
+    {
+      if ( !is_ci( n ) && !is_dead( n ) )
+      {
+        _link_fanins( n );
+      }
+    }
+  }
+
+  /* calls `fn` in index order on the gates that may have `n` as fanin: its
+     fan-outs if fan-out lists are tracked, and all gates otherwise */
+  template<typename Fn>
+  void _foreach_parent( node const& n, Fn&& fn )
+  {
+    if ( _storage->fanout_users > 0u )
+    {
+      std::vector<node> parents( _storage->fanouts.begin( n ), _storage->fanouts.end() );
+      std::sort( parents.begin(), parents.end() );
+      for ( auto const& p : parents )
+      {
+        fn( p );
+      }
+      return;
+    }
+
+    for ( node idx = 1u; idx < _storage->nodes.size(); ++idx )
+    {
+      if ( is_ci( idx ) || is_dead( idx ) )
+        continue; /* ignore CIs and dead nodes */
+
+      fn( idx );
+    }
+  }
+
+  /* records that node `n` may precede one of its fanins (see `is_topo_sorted`) */
+  void _mark_unsorted( node const& n )
+  {
+    _storage->unsorted_from = std::min<uint64_t>( _storage->unsorted_from, n );
+  }
+
+  auto const& _nodes() const
+  {
+    return _storage->nodes;
+  }
+
+  /* the per-node data is kept in the nodes or in separate arrays (see `basic_xag_storage`) */
+  uint32_t _refs( node const& n ) const
+  {
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      return _storage->refs[n];
+    }
+    else
+    {
+      return _nodes()[n].data[0].h1;
+    }
+  }
+
+  void _set_refs( node const& n, uint32_t refs )
+  {
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      _storage->refs[n] = refs;
+    }
+    else
+    {
+      _storage->nodes[n].data[0].h1 = refs;
+    }
+  }
+
+  bool _is_terminal( node const& n ) const
+  {
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      return std::as_const( _storage->terminal )[n] == 1;
+    }
+    else
+    {
+      return _nodes()[n].data[1].h2 == 1;
+    }
+  }
+
+  void _set_terminal( node const& n )
+  {
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      _storage->terminal[n] = 1;
+    }
+    else
+    {
+      _storage->nodes[n].data[1].h2 = 1;
+    }
+  }
+
+  /* appends a node with zero data */
+  auto& _emplace_node( typename storage::element_type::node_type const& node = {} )
+  {
+    /* one bit of the node pointers is used for the complemented attribute */
+    assert( _storage->nodes.size() < ( uint64_t( 1 ) << ( sizeof( signal ) * 8 - 1 ) ) && "too many nodes for the index type" );
+
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      return _storage->emplace_back( node );
+    }
+    else
+    {
+      return _storage->nodes.emplace_back( node );
+    }
+  }
+
+  /* replaces the node at `index` by `node` with zero data */
+  void _assign_node( node const& index, typename storage::element_type::node_type const& node )
+  {
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      _storage->assign( index, node );
+    }
+    else
+    {
+      _storage->nodes[index] = node;
+    }
+  }
+
+  void _reserve_nodes( uint64_t num_nodes )
+  {
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      _storage->reserve( num_nodes );
+    }
+    else
+    {
+      _storage->nodes.reserve( num_nodes );
+    }
+  }
+
+  /* moves the nodes with their data (see `detail::move_elements`) */
+  void _move_nodes( node const& first, std::vector<node> const& order )
+  {
+    if constexpr ( HashPolicy::separate_node_data )
+    {
+      _storage->move_nodes( first, order );
+    }
+    else
+    {
+      detail::move_elements( _storage->nodes, first, order );
+    }
+  }
+
+  /* stores a new node at the index of a dead node (see `set_node_reuse`) or appends it */
+  node _insert_node( typename storage::element_type::node_type const& node )
+  {
+    auto& free_nodes = _storage->free_nodes;
+    while ( !free_nodes.empty() )
+    {
+      const auto index = free_nodes.back();
+      free_nodes.pop_back();
+
+      /* the node may have been revived in the meantime */
+      if ( is_dead( index ) )
+      {
+        _assign_node( index, node );
+        if ( node.children[0].index > index || node.children[1].index > index )
+        {
+          _mark_unsorted( index );
+        }
+        return index;
+      }
+    }
+
+    const auto index = _storage->nodes.size();
+
+    if ( index >= .9 * _storage->nodes.capacity() )
+    {
+      _reserve_nodes( static_cast<uint64_t>( 3.1415f * index ) );
+      _storage->hash.reserve( static_cast<uint64_t>( 3.1415f * index ) );
+    }
+
+    _emplace_node( node );
+    return index;
+  }
+
 public:
-  std::shared_ptr<xag_storage> _storage;
+  std::shared_ptr<basic_xag_storage<HashPolicy>> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+class xag_network : public basic_xag_network<default_hash_policy, xag_network>
+{
+public:
+  using basic_xag_network::basic_xag_network;
+};
+
+class parallel_xag_network : public basic_xag_network<parallel_hash_policy, parallel_xag_network>
+{
+public:
+  using basic_xag_network::basic_xag_network;
+};
+
+class soa_xag_network : public basic_xag_network<soa_storage_policy, soa_xag_network>
+{
+public:
+  using basic_xag_network::basic_xag_network;
+};
+
 } // namespace mockturtle
 
 namespace std
 {
 
-template<>
-struct hash<mockturtle::xag_network::signal>
+template<typename Word>
+struct hash<mockturtle::xag_signal<Word>>
 {
-  uint64_t operator()( mockturtle::xag_network::signal const& s ) const noexcept
+  uint64_t operator()( mockturtle::xag_signal<Word> const& s ) const noexcept
   {
     uint64_t k = s.data;
     k ^= k >> 33;
@@ -1285,4 +2196,4 @@ struct hash<mockturtle::xag_network::signal>
   }
 }; /* hash */
 
-} // namespace std
\ No newline at end of file
+} // namespace std
@@ -40,10 +40,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <stack>
 #include <string>
+#include <vector>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operators.hpp>
@@ -172,7 +174,13 @@ public:
 
   xmg_network clone() const
   {
-    return { std::make_shared<xmg_storage>( *_storage ) };
+    auto storage = std::make_shared<xmg_storage>( *_storage );
+
+    /* the fan-out lists belong to the users of this network (see `acquire_fanouts`) */
+    storage->fanout_users = 0u;
+    storage->fanouts.reset( 3u );
+
+    return { storage };
   }
 #pragma endregion
 
@@ -308,10 +316,9 @@ public:
     _storage->nodes[b.index].data[0].h1++;
     _storage->nodes[c.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _link_fanins( index );
+
+    _events->notify_add( index );
 
     return { index, node_complement };
   }
@@ -375,10 +382,9 @@ public:
     _storage->nodes[b.index].data[0].h1++;
     _storage->nodes[c.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( index );
-    }
+    _link_fanins( index );
+
+    _events->notify_add( index );
 
     return { index, fcompl };
   }
@@ -706,6 +712,7 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _unlink_fanins( n );
 
     // insert updated node into hash table
     node.children[0] = child0;
@@ -716,10 +723,9 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_modified )
-    {
-      ( *fn )( n, { old_child0, old_child1, old_child2 } );
-    }
+    _link_fanins( n );
+
+    _events->notify_modified( n, { old_child0, old_child1, old_child2 } );
 
     return std::nullopt;
   }
@@ -837,6 +843,7 @@ public:
 
     // erase old node in hash table
     _storage->hash.erase( node );
+    _unlink_fanins( n );
 
     // insert updated node into hash table
     node.children[0] = child0;
@@ -850,10 +857,9 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
-    for ( auto const& fn : _events->on_modified )
-    {
-      ( *fn )( n, { old_child0, old_child1, old_child2 } );
-    }
+    _link_fanins( n );
+
+    _events->notify_modified( n, { old_child0, old_child1, old_child2 } );
   }
 
   void replace_in_outputs( node const& old_node, signal const& new_signal )
@@ -886,11 +892,9 @@ public:
     auto& nobj = _storage->nodes[n];
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
+    _unlink_fanins( n );
 
-    for ( auto const& fn : _events->on_delete )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_delete( n );
 
     for ( auto i = 0u; i < 3u; ++i )
     {
@@ -914,11 +918,9 @@ public:
     auto& nobj = _storage->nodes[n];
     nobj.data[0].h1 = UINT32_C( 0 ); /* fanout size 0, but not dead (like just created) */
     _storage->hash[nobj] = n;
+    _link_fanins( n );
 
-    for ( auto const& fn : _events->on_add )
-    {
-      ( *fn )( n );
-    }
+    _events->notify_add( n );
 
     /* revive its children if dead, and increment their fanout_size */
     for ( auto i = 0u; i < 3u; ++i )
@@ -938,6 +940,9 @@ public:
 
   void substitute_node( node const& old_node, signal const& new_signal )
   {
+    /* report each modified parent once per replaced node */
+    _events->begin_batch();
+
     std::unordered_map<node, signal> old_to_new;
     std::stack<std::pair<node, signal>> to_substitute;
     to_substitute.push( { old_node, new_signal } );
@@ -964,16 +969,15 @@ public:
         revive_node( get_node( _new ) );
       }
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
-        if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
-
+      _foreach_parent( _old, [&]( node const& idx ) {
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
+
+      /* deliver the modifications before the redundant parents are substituted */
+      _events->flush_batch();
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -985,6 +989,8 @@ public:
         take_out_node( _old );
       }
     }
+
+    _events->end_batch();
   }
 
   void substitute_node_no_restrash( node const& old_node, signal const& new_signal )
@@ -994,13 +1000,9 @@ public:
       revive_node( get_node( new_signal ) );
     }
 
-    for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-    {
-      if ( is_ci( idx ) || is_dead( idx ) )
-        continue; /* ignore CIs and dead nodes */
-
+    _foreach_parent( old_node, [&]( node const& idx ) {
       replace_in_node_no_restrash( idx, old_node, new_signal );
-    }
+    } );
 
     /* check outputs */
     replace_in_outputs( old_node, new_signal );
@@ -1013,6 +1015,56 @@ public:
   }
 #pragma endregion
 
+#pragma region Fan-out lists
+  /*! \brief Acquires the fan-out lists in the storage.
+   *
+   * While the lists are acquired, the storage keeps, for each node, the list
+   * of gates that have the node as fanin, and `substitute_node` only visits
+   * the fan-outs of the substituted node.  Each call must be paired with a
+   * call to `release_fanouts`.  `fanout_view` acquires the lists for its
+   * lifetime and forwards to them.
+   */
+  void acquire_fanouts()
+  {
+    if ( _storage->fanout_users++ == 0u )
+    {
+      _rebuild_fanouts();
+    }
+  }
+
+  /*! \brief Releases the fan-out lists; they are dropped with the last user. */
+  void release_fanouts()
+  {
+    assert( _storage->fanout_users > 0u );
+    if ( --_storage->fanout_users == 0u )
+    {
+      _rebuild_fanouts();
+    }
+  }
+
+  bool is_tracking_fanouts() const
+  {
+    return _storage->fanout_users > 0u;
+  }
+
+  /*! \brief Recomputes the fan-out lists in index order. */
+  void rebuild_fanouts()
+  {
+    _rebuild_fanouts();
+  }
+
+  /*! \brief Calls `fn` on the gates that have `n` as fanin.
+   *
+   * Requires acquired fan-out lists (see `acquire_fanouts`).
+   */
+  template<typename Fn>
+  void foreach_tracked_fanout( node const& n, Fn&& fn ) const
+  {
+    assert( _storage->fanout_users > 0u );
+    detail::foreach_element( _storage->fanouts.begin( n ), _storage->fanouts.end(), fn );
+  }
+#pragma endregion
+
 #pragma region Structural properties
   uint32_t size() const
   {
@@ -1470,6 +1522,76 @@ public:
   }
 #pragma endregion
 
+protected:
+  /* appends node `n` to the fan-out lists of its fanins (see `acquire_fanouts`) */
+  void _link_fanins( node const& n )
+  {
+    if ( _storage->fanout_users > 0u )
+    {
+      auto const& nobj = _storage->nodes[n];
+      for ( auto i = 0u; i < 3u; ++i )
+      {
+        _storage->fanouts.link( n, i, nobj.children[i].index );
+      }
+    }
+  }
+
+  /* removes node `n` from the fan-out lists of its fanins */
+  void _unlink_fanins( node const& n )
+  {
+    if ( _storage->fanout_users > 0u )
+    {
+      auto const& nobj = _storage->nodes[n];
+      for ( auto i = 0u; i < 3u; ++i )
+      {
+        _storage->fanouts.unlink( n, i, nobj.children[i].index );
+      }
+    }
+  }
+
+  /* recomputes the fan-out lists of all gates in index order */
+  void _rebuild_fanouts()
+  {
+    _storage->fanouts.reset( 3u );
+    if ( _storage->fanout_users == 0u )
+    {
+      return;
+    }
+
+    for ( node n = 1u; n < _storage->nodes.size(); ++n )
+    {
+      if ( !is_ci( n ) && !is_dead( n ) )
+      {
+        _link_fanins( n );
+      }
+    }
+  }
+
+  /* calls `fn` in index order on the gates that may have `n` as fanin: its
+     fan-outs if fan-out lists are tracked, and all gates otherwise */
+  template<typename Fn>
+  void _foreach_parent( node const& n, Fn&& fn )
+  {
+    if ( _storage->fanout_users > 0u )
+    {
+      std::vector<node> parents( _storage->fanouts.begin( n ), _storage->fanouts.end() );
+      std::sort( parents.begin(), parents.end() );
+      for ( auto const& p : parents )
+      {
+        fn( p );
+      }
+      return;
+    }
+
+    for ( node idx = 1u; idx < _storage->nodes.size(); ++idx )
+    {
+      if ( is_ci( idx ) || is_dead( idx ) )
+        continue; /* ignore CIs and dead nodes */
+
+      fn( idx );
+    }
+  }
+
 public:
   std::shared_ptr<xmg_storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
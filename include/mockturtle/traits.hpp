@@ -93,6 +93,21 @@ template<class Ntk>
 inline constexpr bool is_aig_network_type_v = is_aig_network_type<Ntk>::value;
 #pragma endregion
 
+#pragma region is_xag_network_type
+template<class Ntk, class = void>
+struct is_xag_network_type : std::false_type
+{
+};
+
+template<class Ntk>
+struct is_xag_network_type<Ntk, std::enable_if_t<Ntk::is_xag_network_type, std::void_t<decltype( Ntk::is_xag_network_type )>>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool is_xag_network_type_v = is_xag_network_type<Ntk>::value;
+#pragma endregion
+
 #pragma region is_buffered_network_type
 template<class Ntk, class = void>
 struct is_buffered_network_type : std::false_type
@@ -138,6 +153,36 @@ template<class Ntk>
 inline constexpr bool has_clone_v = has_clone<Ntk>::value;
 #pragma endregion
 
+#pragma region has_snapshot
+template<class Ntk, class = void>
+struct has_snapshot : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_snapshot<Ntk, std::void_t<decltype( std::declval<Ntk>().snapshot() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_snapshot_v = has_snapshot<Ntk>::value;
+#pragma endregion
+
+#pragma region has_rollback
+template<class Ntk, class = void>
+struct has_rollback : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_rollback<Ntk, std::void_t<decltype( std::declval<Ntk>().rollback( std::declval<Ntk const&>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_rollback_v = has_rollback<Ntk>::value;
+#pragma endregion
+
 #pragma region is_topologically_sorted
 template<class Ntk, class = void>
 struct is_topologically_sorted : std::false_type
@@ -693,6 +738,96 @@ template<class Ntk>
 inline constexpr bool has_merge_into_crossing_v = has_merge_into_crossing<Ntk>::value;
 #pragma endregion
 
+#pragma region has_create_and_no_strash
+template<class Ntk, class = void>
+struct has_create_and_no_strash : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_create_and_no_strash<Ntk, std::void_t<decltype( std::declval<Ntk>().create_and_no_strash( std::declval<signal<Ntk>>(), std::declval<signal<Ntk>>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_create_and_no_strash_v = has_create_and_no_strash<Ntk>::value;
+#pragma endregion
+
+#pragma region has_create_xor_no_strash
+template<class Ntk, class = void>
+struct has_create_xor_no_strash : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_create_xor_no_strash<Ntk, std::void_t<decltype( std::declval<Ntk>().create_xor_no_strash( std::declval<signal<Ntk>>(), std::declval<signal<Ntk>>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_create_xor_no_strash_v = has_create_xor_no_strash<Ntk>::value;
+#pragma endregion
+
+#pragma region has_rehash
+template<class Ntk, class = void>
+struct has_rehash : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_rehash<Ntk, std::void_t<decltype( std::declval<Ntk>().rehash() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_rehash_v = has_rehash<Ntk>::value;
+#pragma endregion
+
+#pragma region has_compact
+template<class Ntk, class = void>
+struct has_compact : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_compact<Ntk, std::void_t<decltype( std::declval<Ntk>().compact() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_compact_v = has_compact<Ntk>::value;
+#pragma endregion
+
+#pragma region has_reserve
+template<class Ntk, class = void>
+struct has_reserve : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_reserve<Ntk, std::void_t<decltype( std::declval<Ntk>().reserve( uint64_t() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_reserve_v = has_reserve<Ntk>::value;
+#pragma endregion
+
+#pragma region has_is_topo_sorted
+template<class Ntk, class = void>
+struct has_is_topo_sorted : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_is_topo_sorted<Ntk, std::void_t<decltype( std::declval<Ntk>().is_topo_sorted() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_is_topo_sorted_v = has_is_topo_sorted<Ntk>::value;
+#pragma endregion
+
 #pragma region has_clone_node
 template<class Ntk, class = void>
 struct has_clone_node : std::false_type
@@ -1953,6 +2088,21 @@ template<class Ntk>
 inline constexpr bool has_foreach_fanout_v = has_foreach_fanout<Ntk>::value;
 #pragma endregion
 
+#pragma region has_foreach_tracked_fanout
+template<class Ntk, class = void>
+struct has_foreach_tracked_fanout : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_foreach_tracked_fanout<Ntk, std::void_t<decltype( std::declval<Ntk>().foreach_tracked_fanout( std::declval<node<Ntk>>(), std::declval<void( node<Ntk>, uint32_t )>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_foreach_tracked_fanout_v = has_foreach_tracked_fanout<Ntk>::value;
+#pragma endregion
+
 #pragma region has_foreach_choice
 template<class Ntk, class = void>
 struct has_foreach_choice : std::false_type
@@ -2628,6 +2778,36 @@ template<class Ntk>
 inline constexpr bool has_eval_fanins_color_v = has_eval_fanins_color<Ntk>::value;
 #pragma endregion
 
+#pragma region has_switching_activity
+template<class Ntk, class = void>
+struct has_switching_activity : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_switching_activity<Ntk, std::void_t<decltype( std::declval<Ntk>().switching_activity( std::declval<node<Ntk>>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_switching_activity_v = has_switching_activity<Ntk>::value;
+#pragma endregion
+
+#pragma region has_switching_activities
+template<class Ntk, class = void>
+struct has_switching_activities : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_switching_activities<Ntk, std::void_t<decltype( std::declval<Ntk>().switching_activities() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_switching_activities_v = has_switching_activities<Ntk>::value;
+#pragma endregion
+
 #pragma region has_EXCDC_interface
 template<class Ntk, class = void>
 struct has_EXCDC_interface : std::false_type
@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iterator>
 
 namespace mockturtle
@@ -143,6 +144,27 @@ constexpr auto range( T end )
   return range<T>( {}, end );
 }
 
+/*! \brief Partitions a range in place, keeping the order of the first part.
+ *
+ * Moves the elements for which `pred` returns true to the front, in their
+ * original order, and returns an iterator to the first element of the second
+ * part.  Contrary to `std::stable_partition`, the order of the elements in
+ * the second part is not preserved, which allows to partition with swaps and
+ * without allocating a temporary buffer.
+ */
+template<class Iterator, class UnaryPredicate>
+Iterator stable_front_partition( Iterator first, Iterator last, UnaryPredicate&& pred )
+{
+  for ( auto it = first; it != last; ++it )
+  {
+    if ( pred( *it ) )
+    {
+      std::iter_swap( first++, it );
+    }
+  }
+  return first;
+}
+
 /*! \brief Performs the set union of two sorted sets.
  *
  * Compared to std::set_union, limits the copy to `limit`.
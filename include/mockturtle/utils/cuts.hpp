@@ -34,10 +34,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <type_traits>
+
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+#include <immintrin.h>
+#endif
 
 #include <kitty/detail/mscfix.hpp>
 
@@ -334,6 +341,233 @@ bool cut<MaxLeaves, T>::merge( cut const& that, cut& res, uint32_t cut_size ) co
   return false;
 }
 
+/*! \brief A cut with at most 8 leaves packed into 256 bits.
+ *
+ * The packed cut has the same interface as `cut<8, T>`, but stores its
+ * sorted leaves in one 32-byte aligned block, in which unused positions hold
+ * `UINT32_MAX`.  Subset tests and merges then compare all leaves at once with
+ * SSE2 or, if the code is compiled with AVX2 support, AVX2 instructions.
+ * The number of common leaves is computed in the same way, such that merges
+ * exceeding the cut size are rejected before the sorted union is built.
+ *
+ * Leaves must be smaller than `UINT32_MAX`.  Cut types with up to 8 leaves
+ * can be selected with `fixed_cut_t<MaxLeaves, T>`, which falls back to
+ * `cut<MaxLeaves, T>` for larger cuts.
+ */
+template<typename T = empty_cut_data>
+class packed_cut
+{
+public:
+  static constexpr uint32_t max_leaves = 8u;
+
+  /*! \brief Default constructor. */
+  packed_cut()
+  {
+    _leaves.fill( UINT32_MAX );
+  }
+
+  /*! \brief Sets leaves (using iterators).
+   *
+   * \param begin Begin iterator to leaves
+   * \param end End iterator to leaves (exclusive)
+   */
+  template<typename Iterator>
+  void set_leaves( Iterator begin, Iterator end )
+  {
+    _leaves.fill( UINT32_MAX );
+    _length = 0u;
+    _signature = 0u;
+    add_leaves( begin, end );
+  }
+
+  /*! \brief Sets leaves (using container). */
+  template<typename Container>
+  void set_leaves( Container const& c )
+  {
+    set_leaves( std::begin( c ), std::end( c ) );
+  }
+
+  /*! \brief Add leaves (using iterators).
+   *
+   * \param begin Begin iterator to leaves
+   * \param end End iterator to leaves (exclusive)
+   */
+  template<typename Iterator>
+  void add_leaves( Iterator begin, Iterator end )
+  {
+    while ( begin != end )
+    {
+      assert( _length < max_leaves );
+      _signature |= UINT64_C( 1 ) << ( *begin & 0x3f );
+      _leaves[_length++] = *begin++;
+    }
+  }
+
+  /*! \brief Signature of the cut. */
+  auto signature() const { return _signature; }
+
+  /*! \brief Returns the size of the cut (number of leaves). */
+  auto size() const { return _length; }
+
+  /*! \brief Begin iterator (constant). */
+  uint32_t const* begin() const { return _leaves.data(); }
+
+  /*! \brief End iterator (constant). */
+  uint32_t const* end() const { return _leaves.data() + _length; }
+
+  /*! \brief Begin iterator (mutable). */
+  uint32_t* begin() { return _leaves.data(); }
+
+  /*! \brief End iterator (mutable). */
+  uint32_t* end() { return _leaves.data() + _length; }
+
+  /*! \brief Access to data (mutable). */
+  T* operator->() { return &_data; }
+
+  /*! \brief Access to data (constant). */
+  T const* operator->() const { return &_data; }
+
+  /*! \brief Access to data (mutable). */
+  T& data() { return _data; }
+
+  /*! \brief Access to data (constant). */
+  T const& data() const { return _data; }
+
+  /*! \brief Checks whether the cut is a subset of another cut.
+   *
+   * \param that Other cut
+   */
+  bool dominates( packed_cut const& that ) const
+  {
+    if ( _length > that._length || ( _signature & that._signature ) != _signature )
+    {
+      return false;
+    }
+
+    auto const mask = ( 1u << _length ) - 1u;
+    return ( contained_leaves( that ) & mask ) == mask;
+  }
+
+  /*! \brief Merges two cuts.
+   *
+   * Stores the union of the leaves in `res` if it has not more than
+   * `cut_size` elements, and returns whether it did.
+   *
+   * \param that Other cut
+   * \param res Resulting cut
+   * \param cut_size Maximum cut size
+   * \return True, if resulting cut is small enough
+   */
+  bool merge( packed_cut const& that, packed_cut& res, uint32_t cut_size ) const
+  {
+    cut_size = std::min( cut_size, max_leaves );
+    if ( _length + that._length > cut_size )
+    {
+      const auto sign = _signature | that._signature;
+      if ( uint32_t( __builtin_popcount( static_cast<uint32_t>( sign & 0xffffffff ) ) ) + uint32_t( __builtin_popcount( static_cast<uint32_t>( sign >> 32 ) ) ) > cut_size )
+      {
+        return false;
+      }
+
+      auto const common = __builtin_popcount( that.contained_leaves( *this ) & ( ( 1u << that._length ) - 1u ) );
+      if ( _length + that._length - common > cut_size )
+      {
+        return false;
+      }
+    }
+
+    /* the union fits: merge using the padding as sentinel */
+    alignas( 32 ) std::array<uint32_t, max_leaves> leaves;
+    leaves.fill( UINT32_MAX );
+    uint32_t i = 0u, j = 0u, length = 0u;
+    while ( i < _length || j < that._length )
+    {
+      auto const a = i < max_leaves ? _leaves[i] : UINT32_MAX;
+      auto const b = j < max_leaves ? that._leaves[j] : UINT32_MAX;
+      auto const l = std::min( a, b );
+      leaves[length++] = l;
+      i += a == l;
+      j += b == l;
+    }
+
+    res._leaves = leaves;
+    res._length = length;
+    res._signature = _signature | that._signature;
+    return true;
+  }
+
+private:
+  /* bit i is set if leaf position i of the cut occurs in `that` */
+  uint32_t contained_leaves( packed_cut const& that ) const
+  {
+#if defined( __AVX2__ )
+    __m256i const a = _mm256_load_si256( reinterpret_cast<__m256i const*>( _leaves.data() ) );
+    __m256i b = _mm256_load_si256( reinterpret_cast<__m256i const*>( that._leaves.data() ) );
+    __m256i const rotate = _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 0 );
+    __m256i eq = _mm256_cmpeq_epi32( a, b );
+    for ( auto k = 1u; k < max_leaves; ++k )
+    {
+      b = _mm256_permutevar8x32_epi32( b, rotate );
+      eq = _mm256_or_si256( eq, _mm256_cmpeq_epi32( a, b ) );
+    }
+    return static_cast<uint32_t>( _mm256_movemask_ps( _mm256_castsi256_ps( eq ) ) );
+#elif defined( __SSE2__ )
+    __m128i const a0 = _mm_load_si128( reinterpret_cast<__m128i const*>( _leaves.data() ) );
+    __m128i const a1 = _mm_load_si128( reinterpret_cast<__m128i const*>( _leaves.data() + 4 ) );
+    __m128i b0 = _mm_load_si128( reinterpret_cast<__m128i const*>( that._leaves.data() ) );
+    __m128i b1 = _mm_load_si128( reinterpret_cast<__m128i const*>( that._leaves.data() + 4 ) );
+    __m128i eq0 = _mm_or_si128( _mm_cmpeq_epi32( a0, b0 ), _mm_cmpeq_epi32( a0, b1 ) );
+    __m128i eq1 = _mm_or_si128( _mm_cmpeq_epi32( a1, b0 ), _mm_cmpeq_epi32( a1, b1 ) );
+    for ( auto k = 1u; k < 4u; ++k )
+    {
+      b0 = _mm_shuffle_epi32( b0, _MM_SHUFFLE( 0, 3, 2, 1 ) );
+      b1 = _mm_shuffle_epi32( b1, _MM_SHUFFLE( 0, 3, 2, 1 ) );
+      eq0 = _mm_or_si128( eq0, _mm_or_si128( _mm_cmpeq_epi32( a0, b0 ), _mm_cmpeq_epi32( a0, b1 ) ) );
+      eq1 = _mm_or_si128( eq1, _mm_or_si128( _mm_cmpeq_epi32( a1, b0 ), _mm_cmpeq_epi32( a1, b1 ) ) );
+    }
+    return static_cast<uint32_t>( _mm_movemask_ps( _mm_castsi128_ps( eq0 ) ) | ( _mm_movemask_ps( _mm_castsi128_ps( eq1 ) ) << 4 ) );
+#else
+    uint32_t mask = 0u;
+    for ( auto i = 0u; i < max_leaves; ++i )
+    {
+      if ( std::find( that._leaves.begin(), that._leaves.end(), _leaves[i] ) != that._leaves.end() )
+      {
+        mask |= 1u << i;
+      }
+    }
+    return mask;
+#endif
+  }
+
+private:
+  alignas( 32 ) std::array<uint32_t, max_leaves> _leaves;
+  uint32_t _length{ 0u };
+  uint64_t _signature{ 0u };
+
+  T _data;
+};
+
+/*! \brief Compare two packed cuts by their number of leaves. */
+template<typename T>
+bool operator<( packed_cut<T> const& c1, packed_cut<T> const& c2 )
+{
+  return c1.size() < c2.size();
+}
+
+/*! \brief Prints a packed cut. */
+template<typename T>
+std::ostream& operator<<( std::ostream& os, packed_cut<T> const& c )
+{
+  os << "{ ";
+  std::copy( c.begin(), c.end(), std::ostream_iterator<uint32_t>( os, " " ) );
+  os << "}";
+  return os;
+}
+
+/*! \brief Packed cut type for up to 8 leaves, `cut` otherwise. */
+template<int MaxLeaves, typename T = empty_cut_data>
+using fixed_cut_t = std::conditional_t<( MaxLeaves <= 8 ), packed_cut<T>, cut<MaxLeaves, T>>;
+
 /*! \brief A data-structure to hold a set of cuts.
  *
  * The aim of a cut set is to contain cuts and maintain two properties.  First,
@@ -527,7 +761,7 @@ template<typename CutType, int MaxCuts>
 void cut_set<CutType, MaxCuts>::insert( CutType const& cut )
 {
   /* remove elements that are dominated by new cut */
-  _pcend = _pend = std::stable_partition( _pcuts.begin(), _pend, [&cut]( auto const* other ) { return !cut.dominates( *other ); } );
+  _pcend = _pend = stable_front_partition( _pcuts.begin(), _pend, [&cut]( auto const* other ) { return !cut.dominates( *other ); } );
 
   /* insert cut in a sorted way */
   auto ipos = std::lower_bound( _pcuts.begin(), _pend, &cut, []( auto a, auto b ) { return *a < *b; } );
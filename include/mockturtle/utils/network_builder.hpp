@@ -0,0 +1,245 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file network_builder.hpp
+  \brief Bulk construction of networks
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../traits.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Bulk construction of networks
+ *
+ * Creates gates in a network without structural hashing and rebuilds the
+ * structural hash table once in `finalize` (which is also called by the
+ * destructor).  This avoids one hash table probe and insertion per gate
+ * when constructing large networks, e.g., when reading files or copying
+ * networks.  Structurally equivalent gates created by the builder are merged
+ * in `finalize` and, if the network implements `compact`, removed from the
+ * network, such that the gates are renumbered; signals obtained before
+ * `finalize` must be passed through `resolve` afterwards.
+ *
+ * Bulk construction is used if the network implements `create_and_no_strash`
+ * and `rehash` (and `create_xor_no_strash` for XOR gates), is neither a view
+ * nor a buffered network, and contains only constants and combinational
+ * inputs when the builder is constructed.  Otherwise, all functions are
+ * forwarded to the network.  Gates created directly in the network while the
+ * builder is active are merged as well.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig;
+      network_builder builder( aig, 1u + 2u + 1u );
+      auto const a = builder.create_pi();
+      auto const b = builder.create_pi();
+      builder.create_po( builder.create_and( a, b ) );
+      builder.finalize();
+   \endverbatim
+ */
+template<class Ntk>
+class network_builder
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit network_builder( Ntk& ntk, uint64_t capacity = 0u )
+      : _ntk( ntk )
+  {
+    if constexpr ( has_create_and_no_strash_v<Ntk> && has_rehash_v<Ntk> && !is_buffered_network_type_v<Ntk> && std::is_same_v<Ntk, typename Ntk::base_type> )
+    {
+      auto const num_constants = _ntk.get_node( _ntk.get_constant( false ) ) != _ntk.get_node( _ntk.get_constant( true ) ) ? 2u : 1u;
+      _bulk = _ntk.size() == num_constants + _ntk.num_cis();
+    }
+    reserve( capacity );
+  }
+
+  network_builder( network_builder const& ) = delete;
+  network_builder& operator=( network_builder const& ) = delete;
+
+  ~network_builder()
+  {
+    finalize();
+  }
+
+  /*! \brief Reserves memory for `capacity` nodes in the network. */
+  void reserve( uint64_t capacity )
+  {
+    if constexpr ( has_reserve_v<Ntk> )
+    {
+      if ( capacity > _ntk.size() )
+      {
+        _ntk.reserve( capacity );
+      }
+    }
+    else
+    {
+      (void)capacity;
+    }
+  }
+
+  /*! \brief Whether gates are created without structural hashing. */
+  bool is_bulk() const
+  {
+    return _bulk;
+  }
+
+  signal get_constant( bool value = false ) const
+  {
+    return _ntk.get_constant( value );
+  }
+
+  signal create_pi()
+  {
+    return _ntk.create_pi();
+  }
+
+  uint32_t create_po( signal const& f )
+  {
+    return _ntk.create_po( f );
+  }
+
+  signal create_not( signal const& f )
+  {
+    return _ntk.create_not( f );
+  }
+
+  signal create_and( signal const& a, signal const& b )
+  {
+    if constexpr ( has_create_and_no_strash_v<Ntk> )
+    {
+      if ( _bulk )
+      {
+        _dirty = true;
+        return _ntk.create_and_no_strash( a, b );
+      }
+    }
+    return _ntk.create_and( a, b );
+  }
+
+  signal create_xor( signal const& a, signal const& b )
+  {
+    if constexpr ( has_create_xor_no_strash_v<Ntk> )
+    {
+      if ( _bulk )
+      {
+        _dirty = true;
+        return _ntk.create_xor_no_strash( a, b );
+      }
+    }
+    return _ntk.create_xor( a, b );
+  }
+
+  /*! \brief Clones node `source` of `other` with new `children`.
+   *
+   * AND and XOR gates are created without structural hashing; all other
+   * gates are cloned using the network's `clone_node`.
+   */
+  template<class NtkSrc>
+  signal clone_node( NtkSrc const& other, typename NtkSrc::node const& source, std::vector<signal> const& children )
+  {
+    if ( _bulk )
+    {
+      if constexpr ( has_create_and_no_strash_v<Ntk> && has_is_and_v<NtkSrc> )
+      {
+        if ( other.is_and( source ) )
+        {
+          return create_and( children[0u], children[1u] );
+        }
+      }
+      if constexpr ( has_create_xor_no_strash_v<Ntk> && has_is_xor_v<NtkSrc> )
+      {
+        if ( other.is_xor( source ) )
+        {
+          return create_xor( children[0u], children[1u] );
+        }
+      }
+    }
+    return _ntk.clone_node( other, source, children );
+  }
+
+  /*! \brief Rebuilds the structural hash table of the network.
+   *
+   * Gates that have been merged are removed with `compact`.  `num_threads`
+   * is passed to `rehash` and only used by networks with a sharded hash table
+   * (see `parallel_hash_policy`).
+   */
+  void finalize( uint32_t num_threads = 1u )
+  {
+    if constexpr ( has_rehash_v<Ntk> )
+    {
+      if ( _dirty )
+      {
+        _repr = _ntk.rehash( num_threads );
+        _dirty = false;
+
+        if constexpr ( has_compact_v<Ntk> )
+        {
+          if ( !_repr.empty() )
+          {
+            auto const old_to_new = _ntk.compact();
+            for ( auto& f : _repr )
+            {
+              auto const g = _ntk.make_signal( old_to_new[_ntk.node_to_index( _ntk.get_node( f ) )] );
+              f = _ntk.is_complemented( f ) ? _ntk.create_not( g ) : g;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /*! \brief Returns the representative of a signal after `finalize`. */
+  signal resolve( signal const& f ) const
+  {
+    if ( _repr.empty() )
+    {
+      return f;
+    }
+    auto const n = _ntk.get_node( f );
+    return _ntk.is_complemented( f ) ? _ntk.create_not( _repr[_ntk.node_to_index( n )] ) : _repr[_ntk.node_to_index( n )];
+  }
+
+private:
+  Ntk& _ntk;
+  bool _bulk{ false };
+  bool _dirty{ false };
+  std::vector<signal> _repr;
+};
+
+} /* namespace mockturtle */
@@ -25,7 +25,8 @@
 
 /*!
   \file network_utils.hpp
-  \brief Utility functions to insert a network into another network.
+  \brief Utility functions to insert a network into another network and to
+         take snapshots of networks.
 
   \author Siang-Yun (Sonia) Lee
 */
@@ -234,4 +235,43 @@ void insert_ntk( Ntk& ntk, BeginIter begin, EndIter end, SubNtk const& subntk, F
   } );
 }
 
+/*! \brief Takes a snapshot of a network.
+ *
+ * Uses `ntk.snapshot()` if the network implements it (which is cheap for
+ * copy-on-write storage, see `cow_aig_network`), and `ntk.clone()`
+ * otherwise.  The snapshot can be restored with `rollback_network`.
+ */
+template<typename Ntk>
+Ntk snapshot_network( Ntk const& ntk )
+{
+  if constexpr ( has_snapshot_v<Ntk> )
+  {
+    return ntk.snapshot();
+  }
+  else
+  {
+    static_assert( has_clone_v<Ntk>, "Ntk does not implement the clone method" );
+    return ntk.clone();
+  }
+}
+
+/*! \brief Restores a network to a snapshot taken with `snapshot_network`.
+ *
+ * Uses `ntk.rollback( snapshot )` if the network implements it, which
+ * restores the storage in place.  Otherwise, `ntk` is assigned a clone of the
+ * snapshot.  In both cases, the snapshot can be restored again.
+ */
+template<typename Ntk>
+void rollback_network( Ntk& ntk, Ntk const& snapshot )
+{
+  if constexpr ( has_rollback_v<Ntk> )
+  {
+    ntk.rollback( snapshot );
+  }
+  else
+  {
+    ntk = snapshot.clone();
+  }
+}
+
 } // namespace mockturtle
\ No newline at end of file
@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <unordered_map>
@@ -194,6 +195,27 @@ public:
     }
   }
 
+  /*! \brief Renumbers the map after the network has been compacted.
+   *
+   * This function should be called after the network's `compact` method,
+   * which returns `old_to_new`.  Values of removed nodes are dropped, and
+   * the map is resized to the current network's size.
+   *
+   * \param old_to_new Map from old to new node indices
+   */
+  void compact( std::vector<node> const& old_to_new )
+  {
+    container_type compacted( ntk->size() );
+    for ( auto i = 0u; i < std::min<uint64_t>( old_to_new.size(), data->size() ); ++i )
+    {
+      if ( old_to_new[i] < compacted.size() )
+      {
+        compacted[ntk->node_to_index( old_to_new[i] )] = std::move( ( *data )[i] );
+      }
+    }
+    *data = std::move( compacted );
+  }
+
 private:
   Ntk const* ntk;
   std::shared_ptr<container_type> data;
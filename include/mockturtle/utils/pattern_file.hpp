@@ -0,0 +1,247 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file pattern_file.hpp
+  \brief Memory-mapped binary simulation pattern files
+
+  \author Siang-Yun (Sonia) Lee
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MOCKTURTLE_PATTERN_FILE_MMAP
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Header of a binary simulation pattern file.
+ *
+ * The header is followed by `num_pis` rows of `stride` 64-bit words, one
+ * row per primary input, holding the patterns in the bit order of
+ * `kitty::partial_truth_table`.  Words are stored in the byte order of the
+ * machine.  Rows are padded to a multiple of 64 bytes, such that each row
+ * is aligned for SIMD loads when the file is mapped, and leave room for
+ * appending patterns without moving the rows.
+ */
+struct pattern_file_header
+{
+  /*! \brief Identifies the format, `pattern_file_header::magic_value`. */
+  char magic[8];
+
+  /*! \brief Version of the format. */
+  uint32_t version;
+
+  /*! \brief Number of primary inputs (rows). */
+  uint32_t num_pis;
+
+  /*! \brief Number of patterns (valid bits per row). */
+  uint64_t num_patterns;
+
+  /*! \brief Number of words per row, a multiple of `words_alignment`. */
+  uint64_t stride;
+
+  uint64_t reserved[4];
+
+  static constexpr char magic_value[8] = { 'M', 'T', 'P', 'A', 'T', 'B', 'I', 'N' };
+  static constexpr uint32_t current_version = 1u;
+  static constexpr uint64_t words_alignment = 8u;
+};
+
+static_assert( sizeof( pattern_file_header ) == 64u, "pattern file header must be 64 bytes" );
+
+/*! \brief Read-only view on a binary simulation pattern file.
+ *
+ * On POSIX systems, the file is mapped into memory and the words of each
+ * primary input are accessed in place, without copying or parsing.
+ * Elsewhere, the file is read into memory.  `is_open` returns false if the
+ * file cannot be read or is not a pattern file.
+ *
+ * **Example**
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      write_patterns_binary( sim, "patterns.bin" );
+
+      pattern_file file( "patterns.bin" );
+      uint64_t const* words = file.words( 0u ); // patterns of the first PI
+      partial_simulator sim2( "patterns.bin" );  // detects the binary format
+   \endverbatim
+ */
+class pattern_file
+{
+public:
+  explicit pattern_file( std::string const& filename )
+  {
+#ifdef MOCKTURTLE_PATTERN_FILE_MMAP
+    int const fd = ::open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+      return;
+    }
+    struct stat st;
+    if ( ::fstat( fd, &st ) == 0 && static_cast<uint64_t>( st.st_size ) >= sizeof( pattern_file_header ) )
+    {
+      void* data = ::mmap( nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+      if ( data != MAP_FAILED )
+      {
+        _mapped = data;
+        _size = st.st_size;
+        _data = static_cast<uint8_t const*>( data );
+      }
+    }
+    ::close( fd );
+#else
+    std::ifstream in( filename, std::ifstream::in | std::ifstream::binary | std::ifstream::ate );
+    if ( !in )
+    {
+      return;
+    }
+    _size = static_cast<uint64_t>( in.tellg() );
+    _buffer.resize( ( _size + 7u ) / 8u );
+    in.seekg( 0 );
+    in.read( reinterpret_cast<char*>( _buffer.data() ), _size );
+    _data = reinterpret_cast<uint8_t const*>( _buffer.data() );
+#endif
+
+    if ( !valid() )
+    {
+      close();
+    }
+  }
+
+  pattern_file( pattern_file const& ) = delete;
+  pattern_file& operator=( pattern_file const& ) = delete;
+
+  ~pattern_file()
+  {
+    close();
+  }
+
+  /*! \brief Whether the file was read and has a valid header. */
+  bool is_open() const
+  {
+    return _data != nullptr;
+  }
+
+  pattern_file_header const& header() const
+  {
+    return *reinterpret_cast<pattern_file_header const*>( _data );
+  }
+
+  uint32_t num_pis() const
+  {
+    return header().num_pis;
+  }
+
+  uint64_t num_patterns() const
+  {
+    return header().num_patterns;
+  }
+
+  /*! \brief Number of words holding patterns in each row. */
+  uint64_t num_words() const
+  {
+    return ( header().num_patterns >> 6 ) + ( ( header().num_patterns & 63u ) != 0u ? 1u : 0u );
+  }
+
+  /*! \brief Number of words between two rows. */
+  uint64_t stride() const
+  {
+    return header().stride;
+  }
+
+  /*! \brief Words of the `index`-th primary input, 64-byte aligned. */
+  uint64_t const* words( uint32_t index ) const
+  {
+    return reinterpret_cast<uint64_t const*>( _data + sizeof( pattern_file_header ) ) + index * stride();
+  }
+
+  /*! \brief Whether a file starts with the magic value of pattern files. */
+  static bool is_pattern_file( std::string const& filename )
+  {
+    std::ifstream in( filename, std::ifstream::in | std::ifstream::binary );
+    char magic[8];
+    return in.read( magic, 8 ) && std::memcmp( magic, pattern_file_header::magic_value, 8 ) == 0;
+  }
+
+private:
+  bool valid() const
+  {
+    if ( _data == nullptr || _size < sizeof( pattern_file_header ) )
+    {
+      return false;
+    }
+    auto const& h = header();
+
+    /* bounds are checked by division, such that crafted headers cannot overflow them */
+    auto const max_words = ( _size - sizeof( pattern_file_header ) ) / 8u;
+    return std::memcmp( h.magic, pattern_file_header::magic_value, 8 ) == 0 &&
+           h.version == pattern_file_header::current_version &&
+           h.stride % pattern_file_header::words_alignment == 0u &&
+           num_words() <= h.stride &&
+           ( h.num_pis == 0u || h.stride <= max_words / h.num_pis );
+  }
+
+  void close()
+  {
+#ifdef MOCKTURTLE_PATTERN_FILE_MMAP
+    if ( _mapped != nullptr )
+    {
+      ::munmap( _mapped, _size );
+      _mapped = nullptr;
+    }
+#else
+    _buffer.clear();
+#endif
+    _data = nullptr;
+    _size = 0u;
+  }
+
+private:
+  uint8_t const* _data{ nullptr };
+  uint64_t _size{ 0u };
+#ifdef MOCKTURTLE_PATTERN_FILE_MMAP
+  void* _mapped{ nullptr };
+#else
+  std::vector<uint64_t> _buffer;
+#endif
+};
+
+} // namespace mockturtle
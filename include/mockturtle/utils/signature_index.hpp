@@ -0,0 +1,308 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file signature_index.hpp
+  \brief Hash index of simulation signatures
+
+  \author Siang-Yun (Sonia) Lee
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <parallel_hashmap/phmap.h>
+
+#include "../traits.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Index of nodes by the hash of their simulation signature.
+ *
+ * Nodes are grouped into buckets by a hash of the first `num_bits()` bits
+ * of their simulation values, canonicalized with respect to complementation
+ * (signatures whose first bit is 1 are hashed complemented).  Two nodes
+ * that are equal or complemented on the simulated patterns are in the same
+ * bucket; nodes in different buckets are guaranteed to differ.  The index
+ * only stores hashes: the values are passed by the caller, which compares
+ * them to rule out hash collisions.
+ *
+ * When patterns are appended, `refine` rehashes only the nodes that share
+ * their bucket with other nodes, since nodes that differ on a prefix of the
+ * patterns still differ on all of them.  The hash of a node is a sum over
+ * its words, so only the new words are hashed.  Singleton buckets keep their
+ * old hash, which can only cause spurious candidates but no missed ones.
+ *
+ * **Example**
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      unordered_node_map<kitty::partial_truth_table, aig_network> tts( aig );
+      simulate_nodes<aig_network>( aig, tts, sim, true );
+
+      signature_index index( aig );
+      index.build( sim.num_bits(), [&]( auto const& n ) -> auto const& { return tts[n]; } );
+      index.foreach_candidate( n, [&]( auto const& m, bool complemented ) {
+        // tts[m] may equal tts[n] (or ~tts[n] if complemented)
+      } );
+   \endverbatim
+ */
+template<class Ntk>
+class signature_index
+{
+public:
+  using node = typename Ntk::node;
+
+  explicit signature_index( Ntk const& ntk )
+      : _ntk( ntk )
+  {
+  }
+
+  /*! \brief Indexes all nodes of the network on the first `num_bits` bits.
+   *
+   * `value_of( n )` must return the simulation values of `n` with at least
+   * `num_bits` bits.
+   */
+  template<class ValueFn>
+  void build( uint32_t num_bits, ValueFn&& value_of )
+  {
+    _buckets.clear();
+    _entries.assign( _ntk.size(), entry{} );
+    _num_bits = num_bits;
+    _ntk.foreach_node( [&]( auto const& n ) {
+      insert( n, value_of( n ) );
+    } );
+  }
+
+  /*! \brief Indexes a node on the first `num_bits()` bits of `tt`.
+   *
+   * Nodes inserted after `refine` are hashed on more bits than the singleton
+   * buckets, which may then be missed as candidates.  Insert new nodes only
+   * before the first `refine`, or re-`build` the index.
+   */
+  void insert( node const& n, kitty::partial_truth_table const& tt )
+  {
+    auto const index = _ntk.node_to_index( n );
+    if ( index >= _entries.size() )
+    {
+      _entries.resize( index + 1u );
+    }
+    auto& e = _entries[index];
+    assert( !e.indexed );
+    e.indexed = true;
+    e.phase = _num_bits > 0u && kitty::get_bit( tt, 0 );
+    e.prefix = 0u;
+    e.prefix_words = 0u;
+    rehash( e, tt );
+    _buckets[e.hash].emplace_back( n );
+  }
+
+  /*! \brief Removes a node from the index, e.g., after it was substituted. */
+  void erase( node const& n )
+  {
+    auto const index = _ntk.node_to_index( n );
+    if ( !contains( n ) )
+    {
+      return;
+    }
+    auto& e = _entries[index];
+    e.indexed = false;
+
+    auto it = _buckets.find( e.hash );
+    assert( it != _buckets.end() );
+    auto& nodes = it->second;
+    for ( auto i = 0u; i < nodes.size(); ++i )
+    {
+      if ( nodes[i] == n )
+      {
+        nodes[i] = nodes.back();
+        nodes.pop_back();
+        break;
+      }
+    }
+    if ( nodes.empty() )
+    {
+      _buckets.erase( it );
+    }
+  }
+
+  /*! \brief Rehashes the nodes of shared buckets on the first `num_bits` bits.
+   *
+   * `num_bits` must not be smaller than `num_bits()` and the first
+   * `num_bits()` bits of the values must not have changed.  Dead nodes of
+   * shared buckets are removed from the index.
+   */
+  template<class ValueFn>
+  void refine( uint32_t num_bits, ValueFn&& value_of )
+  {
+    assert( num_bits >= _num_bits );
+    _num_bits = num_bits;
+
+    std::vector<node> shared;
+    for ( auto it = _buckets.begin(); it != _buckets.end(); )
+    {
+      if ( it->second.size() > 1u )
+      {
+        shared.insert( shared.end(), it->second.begin(), it->second.end() );
+        it = _buckets.erase( it );
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    for ( auto const& n : shared )
+    {
+      auto& e = _entries[_ntk.node_to_index( n )];
+      if constexpr ( has_is_dead_v<Ntk> )
+      {
+        if ( _ntk.is_dead( n ) )
+        {
+          e.indexed = false;
+          continue;
+        }
+      }
+      rehash( e, value_of( n ) );
+      _buckets[e.hash].emplace_back( n );
+    }
+    _num_rehashed += shared.size();
+  }
+
+  /*! \brief Whether the node is in the index. */
+  bool contains( node const& n ) const
+  {
+    auto const index = _ntk.node_to_index( n );
+    return index < _entries.size() && _entries[index].indexed;
+  }
+
+  /*! \brief Whether no other node may have the same or complemented values. */
+  bool is_singleton( node const& n ) const
+  {
+    assert( contains( n ) );
+    return _buckets.find( _entries[_ntk.node_to_index( n )].hash )->second.size() == 1u;
+  }
+
+  /*! \brief Whether two indexed nodes may have the same or complemented values. */
+  bool same_bucket( node const& a, node const& b ) const
+  {
+    assert( contains( a ) && contains( b ) );
+    return _entries[_ntk.node_to_index( a )].hash == _entries[_ntk.node_to_index( b )].hash;
+  }
+
+  /*! \brief Calls `fn( m, complemented )` for the other nodes in the bucket of `n`.
+   *
+   * `complemented` is true if the values of `m` may equal the complement of
+   * the values of `n`.
+   */
+  template<class Fn>
+  void foreach_candidate( node const& n, Fn&& fn ) const
+  {
+    assert( contains( n ) );
+    auto const& e = _entries[_ntk.node_to_index( n )];
+    for ( auto const& m : _buckets.find( e.hash )->second )
+    {
+      if ( m != n )
+      {
+        fn( m, _entries[_ntk.node_to_index( m )].phase != e.phase );
+      }
+    }
+  }
+
+  /*! \brief Number of bits the signatures are hashed on. */
+  uint32_t num_bits() const
+  {
+    return _num_bits;
+  }
+
+  /*! \brief Number of buckets. */
+  uint64_t num_buckets() const
+  {
+    return _buckets.size();
+  }
+
+  /*! \brief Number of nodes rehashed by `refine`. */
+  uint64_t num_rehashed() const
+  {
+    return _num_rehashed;
+  }
+
+private:
+  struct entry
+  {
+    uint64_t hash{ 0u };
+    /* sum over the first `prefix_words` words, which are complete */
+    uint64_t prefix{ 0u };
+    uint32_t prefix_words{ 0u };
+    bool indexed{ false };
+    bool phase{ false };
+  };
+
+  static uint64_t hash_word( uint64_t word, uint64_t position )
+  {
+    /* splitmix64 finalizer */
+    uint64_t z = word + ( position + 1u ) * UINT64_C( 0x9e3779b97f4a7c15 );
+    z = ( z ^ ( z >> 30 ) ) * UINT64_C( 0xbf58476d1ce4e5b9 );
+    z = ( z ^ ( z >> 27 ) ) * UINT64_C( 0x94d049bb133111eb );
+    return z ^ ( z >> 31 );
+  }
+
+  void rehash( entry& e, kitty::partial_truth_table const& tt ) const
+  {
+    assert( static_cast<uint32_t>( tt.num_bits() ) >= _num_bits );
+    uint64_t const flip = e.phase ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+    uint32_t const num_words = _num_bits >> 6;
+
+    for ( auto i = e.prefix_words; i < num_words; ++i )
+    {
+      e.prefix += hash_word( tt._bits[i] ^ flip, i );
+    }
+    e.prefix_words = num_words;
+
+    e.hash = e.prefix;
+    if ( ( _num_bits & 63u ) != 0u )
+    {
+      auto const mask = ( UINT64_C( 1 ) << ( _num_bits & 63u ) ) - 1u;
+      e.hash += hash_word( ( tt._bits[num_words] ^ flip ) & mask, num_words );
+    }
+  }
+
+private:
+  Ntk const& _ntk;
+  uint32_t _num_bits{ 0u };
+  std::vector<entry> _entries;
+  phmap::flat_hash_map<uint64_t, std::vector<node>> _buckets;
+  uint64_t _num_rehashed{ 0u };
+};
+
+} // namespace mockturtle
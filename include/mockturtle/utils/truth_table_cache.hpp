@@ -34,11 +34,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
+#include <kitty/constructors.hpp>
+#include <kitty/detail/constants.hpp>
 #include <kitty/hash.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
+#include <kitty/traits.hpp>
 
 #include <parallel_hashmap/phmap.h>
 
@@ -169,4 +174,201 @@ void truth_table_cache<TT>::resize( uint32_t capacity )
   _data.reserve( capacity );
 }
 
+/*! \brief Non-owning read-only view on the words of a truth table.
+ *
+ * The view provides the members `num_vars`, `num_blocks`, `num_bits`,
+ * `cbegin`, `cend`, and `_bits`, such that it can be passed to kitty
+ * functions that read a truth table through its iterators (e.g.,
+ * `kitty::count_ones`, `kitty::get_bit`, `kitty::extend_to`) and can be
+ * assigned to a `kitty::dynamic_truth_table`.
+ */
+struct truth_table_view
+{
+  inline auto num_vars() const noexcept { return _num_vars; }
+
+  inline uint64_t num_blocks() const noexcept { return _num_vars <= 6 ? 1u : ( uint64_t( 1 ) << ( _num_vars - 6 ) ); }
+
+  inline uint64_t num_bits() const noexcept { return uint64_t( 1 ) << _num_vars; }
+
+  inline auto begin() const noexcept { return _bits; }
+
+  inline auto end() const noexcept { return _bits + num_blocks(); }
+
+  inline auto cbegin() const noexcept { return _bits; }
+
+  inline auto cend() const noexcept { return _bits + num_blocks(); }
+
+  uint64_t const* _bits{ nullptr };
+  uint32_t _num_vars{ 0 };
+};
+
+/*! \brief Truth table cache with contiguous storage.
+ *
+ * This variant of `truth_table_cache` has the same literals and insertion
+ * semantics, but stores the words of all truth tables, together with
+ * their complements, in one contiguous arena.  `operator[]` returns a
+ * `truth_table_view` into the arena instead of a copy of the truth table.
+ * Views are invalidated by the next insertion.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      truth_table_arena_cache<kitty::dynamic_truth_table> cache;
+
+      kitty::dynamic_truth_table maj( 3 );
+      kitty::create_majority( maj );
+      auto l1 = cache.insert( maj );  // index is 0
+
+      auto ones = kitty::count_ones( cache[l1 ^ 1] ); // reads ~maj in place
+      kitty::dynamic_truth_table tt = cache.copy( l1 ); // copies maj
+   \endverbatim
+ */
+template<typename TT>
+class truth_table_arena_cache
+{
+public:
+  /*! \brief Creates a truth table cache and reserves memory. */
+  truth_table_arena_cache( uint32_t capacity = 1000u )
+  {
+    resize( capacity );
+  }
+
+  /*! \brief Inserts a truth table and returns a literal.
+   *
+   * `tt` can be of any complete truth table type, including a view into
+   * another cache, but not a view into this cache.
+   */
+  template<typename TTFrom>
+  uint32_t insert( TTFrom const& tt );
+
+  /*! \brief Returns a view on the truth table for a given literal. */
+  truth_table_view operator[]( uint32_t lit ) const
+  {
+    auto const& e = _entries[lit >> 1];
+    return truth_table_view{ _words.data() + e.offset + ( lit & 1 ) * num_blocks( e.num_vars ), e.num_vars };
+  }
+
+  /*! \brief Returns a copy of the truth table for a given literal. */
+  TT copy( uint32_t lit ) const;
+
+  /*! \brief Returns number of normalized truth tables in the cache. */
+  auto size() const { return _entries.size(); }
+
+  /*! \brief Resizes the cache.
+   *
+   * Reserve additional space for cache and data.
+   */
+  void resize( uint32_t capacity )
+  {
+    _first.reserve( capacity );
+    _entries.reserve( capacity );
+    _next.reserve( capacity );
+  }
+
+private:
+  struct entry
+  {
+    uint64_t offset;
+    uint32_t num_vars;
+  };
+
+  static uint64_t num_blocks( uint32_t num_vars )
+  {
+    return num_vars <= 6 ? 1u : ( uint64_t( 1 ) << ( num_vars - 6 ) );
+  }
+
+private:
+  /* words of the normal truth table, followed by its complement */
+  std::vector<uint64_t> _words;
+  std::vector<entry> _entries;
+
+  /* first entry and chain of entries with the same hash value */
+  phmap::flat_hash_map<uint64_t, uint32_t> _first;
+  std::vector<uint32_t> _next;
+};
+
+template<typename TT>
+template<typename TTFrom>
+uint32_t truth_table_arena_cache<TT>::insert( TTFrom const& tt )
+{
+  uint32_t const num_vars = tt.num_vars();
+  uint64_t const mask = num_vars < 6 ? kitty::detail::masks[num_vars] : ~uint64_t( 0 );
+  uint64_t const flip = ( *tt.cbegin() & 1 ) ? mask : 0u;
+  uint32_t const is_compl = flip != 0u ? 1u : 0u;
+
+  uint64_t hash = num_vars;
+  for ( auto it = tt.cbegin(); it != tt.cend(); ++it )
+  {
+    hash ^= ( ( *it ^ flip ) & mask ) + UINT64_C( 0x9e3779b97f4a7c15 ) + ( hash << 6 ) + ( hash >> 2 );
+  }
+
+  /* is truth table already in cache? */
+  auto const it = _first.find( hash );
+  if ( it != _first.end() )
+  {
+    for ( auto index = it->second; index != UINT32_MAX; index = _next[index] )
+    {
+      auto const& e = _entries[index];
+      if ( e.num_vars == num_vars &&
+           std::equal( tt.cbegin(), tt.cend(), _words.begin() + e.offset, [&]( uint64_t a, uint64_t b ) { return ( ( a ^ flip ) & mask ) == b; } ) )
+      {
+        return 2 * index + is_compl;
+      }
+    }
+  }
+
+  /* add truth table to end of cache */
+  auto const index = static_cast<uint32_t>( _entries.size() );
+  auto const offset = _words.size();
+  auto const blocks = num_blocks( num_vars );
+  _words.resize( offset + 2 * blocks );
+  std::transform( tt.cbegin(), tt.cend(), _words.begin() + offset, [&]( uint64_t w ) { return ( w ^ flip ) & mask; } );
+  std::transform( tt.cbegin(), tt.cend(), _words.begin() + offset + blocks, [&]( uint64_t w ) { return ( ~w ^ flip ) & mask; } );
+  _entries.push_back( { offset, num_vars } );
+
+  if ( it != _first.end() )
+  {
+    _next.push_back( it->second );
+    it->second = index;
+  }
+  else
+  {
+    _next.push_back( UINT32_MAX );
+    _first.emplace( hash, index );
+  }
+  return 2 * index + is_compl;
+}
+
+template<typename TT>
+TT truth_table_arena_cache<TT>::copy( uint32_t lit ) const
+{
+  auto const view = ( *this )[lit];
+  TT tt = kitty::create<TT>( view.num_vars() );
+  std::copy( view.cbegin(), view.cend(), tt.begin() );
+  return tt;
+}
+
 } /* namespace mockturtle */
+
+namespace kitty
+{
+
+template<>
+struct is_truth_table<mockturtle::truth_table_view> : std::true_type
+{
+};
+
+template<>
+struct is_complete_truth_table<mockturtle::truth_table_view> : std::true_type
+{
+};
+
+template<>
+struct is_completely_specified_truth_table<mockturtle::truth_table_view> : std::true_type
+{
+};
+
+} /* namespace kitty */
@@ -42,7 +42,9 @@
 #include "immutable_view.hpp"
 
 #include <cstdint>
+#include <optional>
 #include <stack>
+#include <type_traits>
 #include <vector>
 
 namespace mockturtle
@@ -55,6 +57,25 @@ struct fanout_view_params
   bool update_on_delete{ true };
 };
 
+namespace detail
+{
+
+/* `Ntk` has fan-out lists in its storage and enumerates the same gates and
+   fanins as its base network (unlike, e.g., `topo_view` or `window_view`) */
+template<class Ntk, class = void>
+struct has_forwardable_fanout : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_forwardable_fanout<Ntk, std::enable_if_t<has_foreach_tracked_fanout_v<Ntk> &&
+                                                    std::is_same_v<decltype( &Ntk::template foreach_gate<void ( * )( node<Ntk> )> ), decltype( &Ntk::base_type::template foreach_gate<void ( * )( node<Ntk> )> )> &&
+                                                    std::is_same_v<decltype( &Ntk::template foreach_fanin<void ( * )( signal<Ntk> )> ), decltype( &Ntk::base_type::template foreach_fanin<void ( * )( signal<Ntk> )> )>>> : std::true_type
+{
+};
+
+} // namespace detail
+
 /*! \brief Implements `foreach_fanout` methods for networks.
  *
  * This view computes the fanout of each node of the network.
@@ -62,6 +83,13 @@ struct fanout_view_params
  * fanout are computed at construction and can be recomputed by
  * calling the `update_fanout` method.
  *
+ * If the network keeps fan-out lists in its storage (such as `aig_network`,
+ * `xag_network`, `mig_network`, and `xmg_network`, see `acquire_fanouts`),
+ * the view acquires them and forwards to them instead of computing its own,
+ * unless updates are disabled in `fanout_view_params`.  Views on the same
+ * network share the lists, which are dropped when the last view is
+ * destroyed.
+ *
  * **Required network functions:**
  * - `foreach_node`
  * - `foreach_fanin`
@@ -90,26 +118,28 @@ public:
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
 
+  static constexpr bool forwards_fanout = detail::has_forwardable_fanout<Ntk>::value;
+
   explicit fanout_view( fanout_view_params const& ps = {} )
-      : Ntk(), _fanout( *this ), _ps( ps )
+      : Ntk(), _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
-    update_fanout();
+    init_fanout();
 
     register_events();
   }
 
   explicit fanout_view( Ntk const& ntk, fanout_view_params const& ps = {} )
-      : Ntk( ntk ), _fanout( ntk ), _ps( ps )
+      : Ntk( ntk ), _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
-    update_fanout();
+    init_fanout();
 
     register_events();
   }
@@ -118,12 +148,14 @@ public:
   fanout_view( fanout_view<Ntk, false> const& other )
       : Ntk( other ), _fanout( other._fanout ), _ps( other._ps )
   {
+    acquire_tracked_fanouts();
     register_events();
   }
 
   fanout_view<Ntk, false>& operator=( fanout_view<Ntk, false> const& other )
   {
     release_events();
+    release_tracked_fanouts();
 
     /* update the base class */
     this->_storage = other._storage;
@@ -133,6 +165,7 @@ public:
     _ps = other._ps;
     _fanout = other._fanout;
 
+    acquire_tracked_fanouts();
     register_events();
 
     return *this;
@@ -141,23 +174,50 @@ public:
   ~fanout_view()
   {
     release_events();
+    release_tracked_fanouts();
   }
 
   template<typename Fn>
   void foreach_fanout( node const& n, Fn&& fn ) const
   {
     assert( n < this->size() );
-    detail::foreach_element( _fanout[n].begin(), _fanout[n].end(), fn );
+    if constexpr ( forwards_fanout )
+    {
+      if ( !_fanout )
+      {
+        Ntk::foreach_tracked_fanout( n, fn );
+        return;
+      }
+    }
+    auto const& fanout = ( *_fanout )[n];
+    detail::foreach_element( fanout.begin(), fanout.end(), fn );
   }
 
   void update_fanout()
   {
+    if constexpr ( forwards_fanout )
+    {
+      if ( !_fanout )
+      {
+        Ntk::rebuild_fanouts();
+        return;
+      }
+    }
     compute_fanout();
   }
 
   std::vector<node> fanout( node const& n ) const /* deprecated */
   {
-    return _fanout[n];
+    if constexpr ( forwards_fanout )
+    {
+      if ( !_fanout )
+      {
+        std::vector<node> fanout;
+        Ntk::foreach_tracked_fanout( n, [&]( auto const& f ) { fanout.push_back( f ); } );
+        return fanout;
+      }
+    }
+    return ( *_fanout )[n];
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -199,7 +259,7 @@ public:
       if ( Ntk::get_node( _new ) == _old && !Ntk::is_complemented( _new ) )
         continue;
 
-      const auto parents = _fanout[_old];
+      const auto parents = fanout( _old );
       for ( auto n : parents )
       {
         if ( const auto repl = Ntk::replace_in_node( n, _old, _new ); repl )
@@ -230,7 +290,7 @@ public:
       Ntk::revive_node( Ntk::get_node( new_signal ) );
     }
 
-    const auto parents = _fanout[old_node];
+    const auto parents = fanout( old_node );
     for ( auto n : parents )
     {
       Ntk::replace_in_node_no_restrash( n, old_node, new_signal );
@@ -247,14 +307,57 @@ public:
   }
 
 private:
+  void init_fanout()
+  {
+    if constexpr ( forwards_fanout )
+    {
+      if ( _ps.update_on_add && _ps.update_on_modified && _ps.update_on_delete )
+      {
+        Ntk::acquire_fanouts();
+        return;
+      }
+    }
+    _fanout.emplace( *this );
+    compute_fanout();
+  }
+
+  /* a view that forwards to the fan-out lists of the network holds a reference to them */
+  void acquire_tracked_fanouts()
+  {
+    if constexpr ( forwards_fanout )
+    {
+      if ( !_fanout )
+      {
+        Ntk::acquire_fanouts();
+      }
+    }
+  }
+
+  void release_tracked_fanouts()
+  {
+    if constexpr ( forwards_fanout )
+    {
+      if ( !_fanout )
+      {
+        Ntk::release_fanouts();
+      }
+    }
+  }
+
   void register_events()
   {
+    if ( !_fanout )
+    {
+      return; /* the network updates its fan-out lists */
+    }
+
     if ( _ps.update_on_add )
     {
       add_event = Ntk::events().register_add_event( [this]( auto const& n ) {
-        _fanout.resize();
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
+        auto& fanout = *_fanout;
+        fanout.resize();
+        Ntk::foreach_fanin( n, [&]( auto const& f ) {
+          fanout[f].push_back( n );
         } );
       } );
     }
@@ -262,13 +365,13 @@ private:
     if ( _ps.update_on_modified )
     {
       modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) {
-        (void)previous;
+        auto& fanout = *_fanout;
         for ( auto const& f : previous )
         {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
+          fanout[f].erase( std::remove( fanout[f].begin(), fanout[f].end(), n ), fanout[f].end() );
         }
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
+        Ntk::foreach_fanin( n, [&]( auto const& f ) {
+          fanout[f].push_back( n );
         } );
       } );
     }
@@ -276,9 +379,10 @@ private:
     if ( _ps.update_on_delete )
     {
       delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) {
-        _fanout[n].clear();
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
+        auto& fanout = *_fanout;
+        fanout[n].clear();
+        Ntk::foreach_fanin( n, [&]( auto const& f ) {
+          fanout[f].erase( std::remove( fanout[f].begin(), fanout[f].end(), n ), fanout[f].end() );
         } );
       } );
     }
@@ -304,7 +408,7 @@ private:
 
   void compute_fanout()
   {
-    _fanout.reset();
+    _fanout->reset();
 
     /* Compute fanout also for buffers in buffered networks */
     if constexpr ( is_buffered_network_type_v<Ntk> )
@@ -313,7 +417,7 @@ private:
         if ( this->is_pi( n ) || this->is_constant( n ) )
           return true;
         this->foreach_fanin( n, [&]( auto const& c ) {
-          auto& fanout = _fanout[c];
+          auto& fanout = ( *_fanout )[c];
           if ( std::find( fanout.begin(), fanout.end(), n ) == fanout.end() )
           {
             fanout.push_back( n );
@@ -326,7 +430,7 @@ private:
     {
       this->foreach_gate( [&]( auto const& n ) {
         this->foreach_fanin( n, [&]( auto const& c ) {
-          auto& fanout = _fanout[c];
+          auto& fanout = ( *_fanout )[c];
           if ( std::find( fanout.begin(), fanout.end(), n ) == fanout.end() )
           {
             fanout.push_back( n );
@@ -336,7 +440,7 @@ private:
     }
   }
 
-  node_map<std::vector<node>, Ntk> _fanout;
+  std::optional<node_map<std::vector<node>, Ntk>> _fanout; /* unset if the network's fan-out lists are used */
   fanout_view_params _ps;
 
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
@@ -0,0 +1,161 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file switching_activity_view.hpp
+  \brief Implements switching activity queries for a network
+
+  \author Alessandro Tempia Calvino
+*/
+
+#pragma once
+
+#include "../algorithms/switching_activity.hpp"
+#include "../traits.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Implements `switching_activity` methods for networks.
+ *
+ * This view keeps a `switching_activity_engine` for the network.  The
+ * activities are estimated on the first query and cached; afterwards, a
+ * query costs a lookup until the network changes.  Changes made through the
+ * view or any other view of the same network are tracked with network
+ * events and re-simulated incrementally on the next query.
+ *
+ * The mappers `map` and `emap` use the cached activities of this view for
+ * power recovery instead of simulating the network again.
+ *
+ * **Required network functions:**
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `compute`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      switching_activity_params ps;
+      ps.num_patterns = 4096;
+      ps.num_threads = 4;
+      switching_activity_view aig_sw{ aig, ps };
+
+      float const a = aig_sw.switching_activity( n );
+      auto const res = emap( aig_sw, lib, emap_ps ); // reuses the cached activities
+   \endverbatim
+ */
+template<class Ntk, bool has_switching_activity_interface = has_switching_activity_v<Ntk>&& has_switching_activities_v<Ntk>>
+class switching_activity_view
+{
+};
+
+template<class Ntk>
+class switching_activity_view<Ntk, true> : public Ntk
+{
+public:
+  switching_activity_view( Ntk const& ntk, switching_activity_params const& ps = {} ) : Ntk( ntk )
+  {
+    (void)ps;
+  }
+};
+
+template<class Ntk>
+class switching_activity_view<Ntk, false> : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit switching_activity_view( Ntk const& ntk, switching_activity_params const& ps = {} )
+      : Ntk( ntk ), _engine( std::make_unique<switching_activity_engine<Ntk>>( *this, ps ) )
+  {
+  }
+
+  /*! \brief Copy constructor. */
+  switching_activity_view( switching_activity_view<Ntk, false> const& other )
+      : Ntk( other ), _engine( std::make_unique<switching_activity_engine<Ntk>>( *this, other._engine->params() ) )
+  {
+  }
+
+  switching_activity_view<Ntk, false>& operator=( switching_activity_view<Ntk, false> const& other )
+  {
+    _engine.reset();
+
+    /* update the base class */
+    this->_storage = other._storage;
+    this->_events = other._events;
+
+    _engine = std::make_unique<switching_activity_engine<Ntk>>( *this, other._engine->params() );
+    return *this;
+  }
+
+  /*! \brief Returns the switching activity of a node. */
+  float switching_activity( node const& n ) const
+  {
+    return _engine->activity( n );
+  }
+
+  /*! \brief Returns the switching activities of all nodes, indexed by `node_to_index`. */
+  std::vector<float> const& switching_activities() const
+  {
+    return _engine->activities();
+  }
+
+  /*! \brief Returns the sum of activity times fanout size over all gates. */
+  double switching_power() const
+  {
+    return _engine->power();
+  }
+
+  /*! \brief Re-estimates the activities of all nodes on the next query. */
+  void reset_switching_activity()
+  {
+    _engine->reset();
+  }
+
+  switching_activity_stats const& switching_activity_statistics() const
+  {
+    return _engine->stats();
+  }
+
+private:
+  std::unique_ptr<switching_activity_engine<Ntk>> _engine;
+};
+
+template<class T>
+switching_activity_view( T const& ) -> switching_activity_view<T>;
+
+template<class T>
+switching_activity_view( T const&, switching_activity_params const& ) -> switching_activity_view<T>;
+
+} // namespace mockturtle
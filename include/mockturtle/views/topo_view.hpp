@@ -46,6 +46,18 @@
 namespace mockturtle
 {
 
+struct topo_view_params
+{
+  /*! \brief Visit the gates in index order if the indices are topologically sorted.
+   *
+   * Only applies to networks that implement `is_topo_sorted`.  Index order
+   * is a topological order as well, but differs from the depth-first order
+   * that is used otherwise, which may change the results of algorithms that
+   * depend on the order in which gates are visited.
+   */
+  bool index_order{ false };
+};
+
 /*! \brief Ensures topological order for of all nodes reachable from the outputs.
  *
  * Overrides the interface methods `foreach_node`, `foreach_gate`,
@@ -63,6 +75,11 @@ namespace mockturtle
  * reachable nodes are traversed, not all network nodes may be called in
  * `foreach_node` and `foreach_gate`.
  *
+ * If `index_order` is set in the parameters and the network reports that its
+ * node indices are in topological order (`is_topo_sorted`), the reachable
+ * gates are collected in index order with two linear passes instead of a
+ * depth-first search.
+ *
  * **Required network functions:**
  * - `get_constant`
  * - `foreach_pi`
@@ -107,7 +124,9 @@ public:
    *
    * Constructs topological view on another network.
    */
-  topo_view( Ntk const& ntk ) : immutable_view<Ntk>( ntk )
+  topo_view( Ntk const& ntk, topo_view_params const& ps = {} )
+      : immutable_view<Ntk>( ntk ),
+        ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
@@ -128,8 +147,9 @@ public:
    * Constructs topological view, but only for the transitive fan-in starting
    * from a given start signal.
    */
-  topo_view( Ntk const& ntk, typename Ntk::signal const& start_signal )
+  topo_view( Ntk const& ntk, typename Ntk::signal const& start_signal, topo_view_params const& ps = {} )
       : immutable_view<Ntk>( ntk ),
+        ps( ps ),
         start_signal( start_signal )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -235,6 +255,14 @@ public:
 
   void update_topo()
   {
+    if constexpr ( has_is_topo_sorted_v<Ntk> )
+    {
+      if ( ps.index_order && this->is_topo_sorted() && update_topo_sorted() )
+      {
+        return;
+      }
+    }
+
     this->incr_trav_id();
     this->incr_trav_id();
     topo_order.reserve( this->size() );
@@ -277,6 +305,66 @@ public:
   }
 
 private:
+  /* collects the reachable nodes in index order; fails if the order is not topological */
+  bool update_topo_sorted()
+  {
+    std::vector<bool> reachable( Ntk::size(), false );
+    if ( start_signal )
+    {
+      reachable[Ntk::node_to_index( this->get_node( *start_signal ) )] = true;
+    }
+    else
+    {
+      Ntk::foreach_co( [&]( auto const& f ) {
+        reachable[Ntk::node_to_index( this->get_node( f ) )] = true;
+      } );
+    }
+
+    for ( auto i = Ntk::size(); i-- > 0u; )
+    {
+      const auto n = Ntk::index_to_node( i );
+      if ( !reachable[i] || this->is_constant( n ) || this->is_ci( n ) )
+      {
+        continue;
+      }
+
+      bool sorted = true;
+      this->foreach_fanin( n, [&]( auto const& f ) {
+        const auto j = Ntk::node_to_index( this->get_node( f ) );
+        sorted = sorted && j < i;
+        reachable[j] = true;
+      } );
+      if ( !sorted )
+      {
+        return false;
+      }
+    }
+
+    /* constants and CIs */
+    const auto c0 = this->get_node( this->get_constant( false ) );
+    const auto c1 = this->get_node( this->get_constant( true ) );
+    topo_order.reserve( Ntk::size() );
+    topo_order.push_back( c0 );
+    if ( c1 != c0 )
+    {
+      topo_order.push_back( c1 );
+    }
+    this->foreach_ci( [this]( auto const& n ) {
+      topo_order.push_back( n );
+    } );
+
+    for ( auto i = 0u; i < Ntk::size(); ++i )
+    {
+      const auto n = Ntk::index_to_node( i );
+      if ( reachable[i] && !this->is_constant( n ) && !this->is_ci( n ) )
+      {
+        topo_order.push_back( n );
+      }
+    }
+
+    return true;
+  }
+
   void create_topo_rec( node const& n )
   {
     /* is permanently marked? */
@@ -303,6 +391,7 @@ private:
 
 private:
   std::vector<node> topo_order;
+  topo_view_params ps;
   std::optional<signal> start_signal;
 };
 
@@ -310,7 +399,7 @@ template<typename Ntk>
 class topo_view<Ntk, true> : public Ntk
 {
 public:
-  topo_view( Ntk const& ntk ) : Ntk( ntk )
+  topo_view( Ntk const& ntk, topo_view_params const& = {} ) : Ntk( ntk )
   {
   }
 };
@@ -318,7 +407,13 @@ public:
 template<class T>
 topo_view( T const& ) -> topo_view<T>;
 
+template<class T>
+topo_view( T const&, topo_view_params const& ) -> topo_view<T>;
+
 template<class T>
 topo_view( T const&, typename T::signal const& ) -> topo_view<T>;
 
+template<class T>
+topo_view( T const&, typename T::signal const&, topo_view_params const& ) -> topo_view<T>;
+
 } // namespace mockturtle
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <mockturtle/algorithms/compiled_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+
+#include "../random_networks.hpp"
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+void check_compiled_simulation( Ntk const& ntk )
+{
+  /* 200 patterns to cover a partially used last word */
+  partial_simulator const sim( ntk.num_pis(), 200u );
+  auto const expected = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+
+  for ( auto backend : { simd_backend::scalar, simd_backend::avx2, simd_backend::avx512 } )
+  {
+    compiled_simulator<Ntk> csim( ntk, backend );
+    CHECK( csim.num_instructions() == ntk.num_gates() );
+    csim.set_patterns( sim.get_patterns() );
+    csim.run();
+    CHECK( csim.num_words() == 4u );
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      CHECK( csim.node_value( n ) == expected[n] );
+    } );
+  }
+
+  auto const pos = simulate_compiled( ntk, sim );
+  auto const expected_pos = simulate<kitty::partial_truth_table>( ntk, sim );
+  CHECK( pos == expected_pos );
+}
+
+} // namespace
+
+TEST_CASE( "compiled simulation of AIGs and XAGs", "[compiled_simulation]" )
+{
+  auto aig = random_aig( 10u, 300u, 5u );
+  aig.create_po( aig.get_constant( true ) );
+  check_compiled_simulation( aig );
+
+  auto const xag = random_xag( 10u, 300u, 5u );
+  check_compiled_simulation( xag );
+
+  compiled_simulator<xag_network> csim( xag );
+  uint32_t num_xors{ 0u };
+  for ( auto const& ins : csim.instructions() )
+  {
+    CHECK( ins.opcode != compiled_opcode::lut );
+    num_xors += ins.opcode == compiled_opcode::xor2 ? 1u : 0u;
+  }
+  CHECK( num_xors > 0u );
+}
+
+TEST_CASE( "compiled simulation of MIGs and XMGs", "[compiled_simulation]" )
+{
+  auto const mig = random_mig( 10u, 300u, 5u );
+  check_compiled_simulation( mig );
+
+  auto const xmg = random_xmg( 10u, 300u, 5u );
+  check_compiled_simulation( xmg );
+}
+
+TEST_CASE( "compiled simulation of k-LUT networks", "[compiled_simulation]" )
+{
+  auto klut = random_klut( 10u, 300u, 5u, 5u );
+  klut.create_po( klut.get_constant( true ) );
+  check_compiled_simulation( klut );
+
+  compiled_simulator<klut_network> csim( klut );
+  for ( auto const& ins : csim.instructions() )
+  {
+    CHECK( ins.opcode == compiled_opcode::lut );
+    CHECK( ins.num_minterms <= ( 1u << ins.num_fanins ) / 2u );
+  }
+}
+
+TEST_CASE( "compiled simulation of networks in non-topological order", "[compiled_simulation]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( f1, c );
+  aig.create_po( f2 );
+
+  /* f2 now depends on a gate with a larger index */
+  auto const f3 = aig.create_xor( b, c );
+  aig.substitute_node( aig.get_node( f1 ), f3 );
+
+  partial_simulator const sim( aig.num_pis(), 64u );
+  compiled_simulator<aig_network> csim( aig );
+  csim.set_patterns( sim.get_patterns() );
+  csim.run();
+  CHECK( csim.po_value( 0u ) == ( ( sim.compute_pi( 1u ) ^ sim.compute_pi( 2u ) ) & sim.compute_pi( 2u ) ) );
+}
+
+TEST_CASE( "simulate nodes with the SIMD simulator", "[compiled_simulation]" )
+{
+  auto const xag = random_xag( 12u, 500u, 5u );
+
+  partial_simulator psim( xag.num_pis(), 1000u );
+  simd_simulator ssim( psim.get_patterns() );
+  CHECK( ssim.num_bits() == 1000u );
+
+  unordered_node_map<kitty::partial_truth_table, xag_network> expected( xag ), values( xag );
+  simulate_nodes<xag_network>( xag, expected, psim, true );
+  simulate_nodes<xag_network>( xag, values, ssim, true );
+  xag.foreach_node( [&]( auto const& n ) {
+    CHECK( values[n] == expected[n] );
+  } );
+
+  /* adding patterns re-simulates the last block */
+  for ( auto i = 0u; i < 24u; ++i )
+  {
+    std::vector<bool> pattern( xag.num_pis(), ( i & 1u ) == 1u );
+    psim.add_pattern( pattern );
+    ssim.add_pattern( pattern );
+  }
+  simulate_nodes<xag_network>( xag, expected, psim, false );
+  simulate_nodes<xag_network>( xag, values, ssim, false );
+  xag.foreach_node( [&]( auto const& n ) {
+    CHECK( values[n].num_bits() == 1024 );
+    CHECK( values[n] == expected[n] );
+  } );
+}
+
+TEST_CASE( "re-run compiled simulation on new patterns", "[compiled_simulation]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  aig.create_po( aig.create_maj( a, !b, c ) );
+  aig.create_po( aig.create_xor( a, b ) );
+
+  compiled_simulator<aig_network> csim( aig );
+  csim.set_num_bits( 8u );
+  csim.pi_words( 0u )[0] = 0xaa;
+  csim.pi_words( 1u )[0] = 0xcc;
+  csim.pi_words( 2u )[0] = 0xf0;
+  csim.run();
+  CHECK( csim.po_value( 0u )._bits[0] == 0xb2 );
+  CHECK( csim.po_value( 1u )._bits[0] == 0x66 );
+
+  csim.pi_words( 1u )[0] = 0x00;
+  csim.run();
+  CHECK( csim.po_value( 0u )._bits[0] == 0xfa );
+  CHECK( csim.po_value( 1u )._bits[0] == 0xaa );
+}
@@ -1,14 +1,21 @@
 #include <catch.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <random>
+#include <vector>
 
+#include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 #include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/cut_enumeration/mf_cut.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/sequential.hpp>
 
+#include "../random_networks.hpp"
+
 using namespace mockturtle;
 
 TEST_CASE( "enumerate cuts for an AIG", "[cut_enumeration]" )
@@ -181,6 +188,213 @@ TEST_CASE( "compute XOR network cuts in 2-LUT network", "[cut_enumeration]" )
   }
 }
 
+struct cut_enumeration_ones_cut
+{
+  uint64_t ones{ 0 };
+};
+
+namespace mockturtle
+{
+template<bool ComputeTruth>
+bool operator<( cut_type<ComputeTruth, cut_enumeration_ones_cut> const& c1, cut_type<ComputeTruth, cut_enumeration_ones_cut> const& c2 )
+{
+  if ( c1->data.ones != c2->data.ones )
+  {
+    return c1->data.ones < c2->data.ones;
+  }
+  return c1.size() < c2.size();
+}
+
+template<>
+struct cut_enumeration_update_cut<cut_enumeration_ones_cut>
+{
+  template<typename Cut, typename NetworkCuts, typename Ntk>
+  static void apply( Cut& cut, NetworkCuts const& cuts, Ntk const&, node<Ntk> const& )
+  {
+    cut->data.ones = kitty::count_ones( cuts.truth_table( cut ) );
+  }
+};
+} // namespace mockturtle
+
+template<class Ntk, class NetworkCuts>
+void check_same_cuts( Ntk const& ntk, NetworkCuts const& cuts1, NetworkCuts const& cuts2 )
+{
+  CHECK( cuts1.total_tuples() == cuts2.total_tuples() );
+  CHECK( cuts1.total_cuts() == cuts2.total_cuts() );
+  ntk.foreach_node( [&]( auto const& n ) {
+    auto const& set1 = cuts1.cuts( ntk.node_to_index( n ) );
+    auto const& set2 = cuts2.cuts( ntk.node_to_index( n ) );
+    REQUIRE( set1.size() == set2.size() );
+    for ( auto i = 0u; i < set1.size(); ++i )
+    {
+      CHECK( std::vector<uint32_t>( set1[i].begin(), set1[i].end() ) == std::vector<uint32_t>( set2[i].begin(), set2[i].end() ) );
+      if constexpr ( NetworkCuts::compute_truth )
+      {
+        CHECK( set1[i]->func_id == set2[i]->func_id );
+        CHECK( cuts1.truth_table( set1[i] ) == cuts2.truth_table( set2[i] ) );
+      }
+    }
+  } );
+}
+
+TEST_CASE( "enumerate cuts on several threads", "[cut_enumeration]" )
+{
+  auto const aig = random_aig( 32u, 2000u, 7u );
+
+  cut_enumeration_params ps;
+  ps.cut_size = 5u;
+  cut_enumeration_params ps_mt = ps;
+  ps_mt.num_threads = 3u;
+
+  check_same_cuts( aig, cut_enumeration( aig, ps ), cut_enumeration( aig, ps_mt ) );
+  check_same_cuts( aig, cut_enumeration<aig_network, true>( aig, ps ), cut_enumeration<aig_network, true>( aig, ps_mt ) );
+
+  /* cut data computed from truth tables */
+  check_same_cuts( aig, cut_enumeration<aig_network, true, cut_enumeration_ones_cut>( aig, ps ), cut_enumeration<aig_network, true, cut_enumeration_ones_cut>( aig, ps_mt ) );
+
+  /* k-LUT network with single-fanin nodes and truth table minimization */
+  auto const klut = random_klut( 16u, 1000u, 3u, 7u );
+
+  ps.minimize_truth_table = true;
+  ps_mt.minimize_truth_table = true;
+  ps_mt.num_threads = 4u;
+  check_same_cuts( klut, cut_enumeration<klut_network, true>( klut, ps ), cut_enumeration<klut_network, true>( klut, ps_mt ) );
+}
+
+template<class Ntk, class NetworkCuts, class LazyCuts>
+void check_lazy_cuts( Ntk const& ntk, NetworkCuts const& cuts, LazyCuts& lazy, std::vector<uint32_t> const& order )
+{
+  for ( auto const& index : order )
+  {
+    auto const& set1 = cuts.cuts( index );
+    auto const& set2 = lazy.cuts( index );
+    REQUIRE( set1.size() == set2.size() );
+    for ( auto i = 0u; i < set1.size(); ++i )
+    {
+      CHECK( std::vector<uint32_t>( set1[i].begin(), set1[i].end() ) == std::vector<uint32_t>( set2[i].begin(), set2[i].end() ) );
+      if constexpr ( NetworkCuts::compute_truth )
+      {
+        CHECK( cuts.truth_table( set1[i] ) == lazy.truth_table( set2[i] ) );
+      }
+    }
+  }
+  CHECK( lazy.nodes_size() == ntk.size() );
+}
+
+TEST_CASE( "enumerate cuts on demand", "[cut_enumeration]" )
+{
+  auto const aig = random_aig( 16u, 500u, 11u );
+
+  std::vector<uint32_t> order;
+  aig.foreach_node( [&]( auto const& n ) {
+    order.emplace_back( aig.node_to_index( n ) );
+  } );
+  std::vector<uint32_t> reverse_order( order.rbegin(), order.rend() );
+  std::vector<uint32_t> random_order = order;
+  std::shuffle( random_order.begin(), random_order.end(), std::mt19937( 11u ) );
+
+  cut_enumeration_params ps;
+  ps.cut_size = 5u;
+
+  /* unbounded: every cut set is computed once */
+  auto lazy_all = lazy_cut_enumeration<aig_network, true>( aig, aig.size(), ps );
+  auto const cuts = cut_enumeration<aig_network, true>( aig, ps );
+  check_lazy_cuts( aig, cuts, lazy_all, reverse_order );
+  check_lazy_cuts( aig, cuts, lazy_all, random_order );
+  CHECK( lazy_all.num_evictions() == 0u );
+  CHECK( lazy_all.num_recomputations() == 0u );
+  CHECK( lazy_all.total_cuts() == cuts.total_cuts() );
+
+  /* bounded: evicted cut sets are recomputed */
+  auto lazy = lazy_cut_enumeration<aig_network, true, cut_enumeration_ones_cut>( aig, 16u, ps );
+  auto const ones_cuts = cut_enumeration<aig_network, true, cut_enumeration_ones_cut>( aig, ps );
+  check_lazy_cuts( aig, ones_cuts, lazy, order );
+  check_lazy_cuts( aig, ones_cuts, lazy, random_order );
+  check_lazy_cuts( aig, ones_cuts, lazy, reverse_order );
+  CHECK( lazy.num_evictions() > 0u );
+  CHECK( lazy.num_recomputations() > 0u );
+  CHECK( lazy.num_cut_sets() < 64u );
+
+  /* cut data that reads the cuts of the leaves */
+  auto lazy_mf = lazy_cut_enumeration<aig_network, false, cut_enumeration_mf_cut>( aig, 4u, ps );
+  check_lazy_cuts( aig, cut_enumeration<aig_network, false, cut_enumeration_mf_cut>( aig, ps ), lazy_mf, random_order );
+}
+
+TEST_CASE( "enumerate priority cuts", "[cut_enumeration]" )
+{
+  auto const aig = random_aig( 16u, 500u, 5u );
+
+  /* depth first, then area flow of the best cuts of the leaves */
+  auto const cost = []( auto const& cut, auto const& cuts ) {
+    uint32_t delay{ 0 };
+    float flow{ 1.0f };
+    for ( auto leaf : cut )
+    {
+      delay = std::max( delay, cuts.cuts( leaf )[0]->data.delay );
+      flow += cuts.cuts( leaf )[0]->data.flow;
+    }
+    return std::make_pair( delay, flow );
+  };
+
+  cut_enumeration_params ps;
+  ps.cut_size = 4u;
+  ps.cut_limit = 5u;
+  cut_enumeration_stats st;
+  auto const cuts = priority_cut_enumeration<aig_network, true, cut_enumeration_mf_cut>( aig, cost, ps, &st );
+  CHECK( st.num_merged > 0u );
+  CHECK( st.num_pruned > 0u );
+  CHECK( st.num_merged >= st.num_pruned + st.num_dominated );
+
+  cut_enumeration_params ps_all;
+  ps_all.cut_size = 4u;
+  cut_enumeration_stats st_all;
+  auto const all_cuts = cut_enumeration<aig_network, true, cut_enumeration_mf_cut>( aig, ps_all, &st_all );
+  CHECK( st_all.num_pruned == 0u );
+  CHECK( st.num_merged < st_all.num_merged );
+
+  aig.foreach_gate( [&]( auto const& n ) {
+    auto const index = aig.node_to_index( n );
+    auto const& set = cuts.cuts( index );
+    REQUIRE( set.size() > 1u );
+    CHECK( set.size() <= ps.cut_limit );
+
+    /* unit cut at the end */
+    CHECK( std::vector<uint32_t>( set[set.size() - 1u].begin(), set[set.size() - 1u].end() ) == std::vector<uint32_t>{ index } );
+
+    for ( auto i = 0u; i + 1u < set.size(); ++i )
+    {
+      if ( i + 2u < set.size() )
+      {
+        auto const c1 = cost( set[i], cuts );
+        auto const c2 = cost( set[i + 1u], cuts );
+        CHECK( !( c2 < c1 ) );
+        CHECK( ( c1 < c2 || set[i].size() <= set[i + 1u].size() ) );
+      }
+      for ( auto j = 0u; j + 1u < set.size(); ++j )
+      {
+        CHECK( ( i == j || !set[i].dominates( set[j] ) ) );
+      }
+
+      /* same truth table as in the exhaustive enumeration */
+      for ( auto const& other : all_cuts.cuts( index ) )
+      {
+        if ( std::equal( set[i].begin(), set[i].end(), other->begin(), other->end() ) )
+        {
+          CHECK( cuts.truth_table( set[i] ) == all_cuts.truth_table( *other ) );
+        }
+      }
+    }
+  } );
+
+  /* the same cuts on several threads */
+  cut_enumeration_params ps_mt = ps;
+  ps_mt.num_threads = 3u;
+  cut_enumeration_stats st_mt;
+  check_same_cuts( aig, cuts, priority_cut_enumeration<aig_network, true, cut_enumeration_mf_cut>( aig, cost, ps_mt, &st_mt ) );
+  CHECK( st_mt.num_merged == st.num_merged );
+  CHECK( st_mt.num_pruned == st.num_pruned );
+}
+
 TEST_CASE( "enumerate cuts for an AIG (small graph version)", "[fast_small_cut_enumeration]" )
 {
   aig_network aig;
@@ -228,6 +228,37 @@ TEST_CASE( "Cut rewriting of bad MAJ", "[cut_rewriting]" )
   CHECK( mig.num_gates() == 1 );
 }
 
+TEST_CASE( "Cut rewriting with bounded cut memory", "[cut_rewriting]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.emplace_back( xag.create_pi() );
+  }
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    auto const a = fs[( i * 7u + 3u ) % fs.size()];
+    auto const b = fs[( i * 13u + 5u ) % fs.size()];
+    fs.emplace_back( i % 3u == 0u ? xag.create_xor( a, b ) : xag.create_and( a, !b ) );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    xag.create_po( fs[fs.size() - 1u - i] );
+  }
+
+  xag_npn_resynthesis<xag_network> resyn;
+  cut_rewriting_params ps;
+  ps.cut_enumeration_ps.cut_size = 4u;
+  auto const xag1 = cut_rewriting( xag, resyn, ps );
+  ps.max_cut_sets = 8u;
+  auto const xag2 = cut_rewriting( xag, resyn, ps );
+
+  CHECK( xag1.num_gates() < xag.num_gates() );
+  CHECK( xag1.num_gates() == xag2.num_gates() );
+  CHECK( xag1.size() == xag2.size() );
+}
+
 TEST_CASE( "Cut rewriting with XMG3 4-input npn database", "[cut_rewriting]" )
 {
 
@@ -53,7 +53,7 @@ std::string const super_library = "test.genlib\n"
                                   "* nand2 2 4\n"
                                   "\0";
 
-TEST_CASE( "Emap on MAJ3", "[emap]" )
+TEMPLATE_TEST_CASE( "Emap on MAJ3", "[emap]", aig_network, aig_network32 )
 {
   std::vector<gate> gates;
 
@@ -63,7 +63,7 @@ TEST_CASE( "Emap on MAJ3", "[emap]" )
 
   tech_library<3> lib( gates );
 
-  aig_network aig;
+  TestType aig;
   const auto a = aig.create_pi();
   const auto b = aig.create_pi();
   const auto c = aig.create_pi();
@@ -3,6 +3,7 @@
 #include <kitty/static_truth_table.hpp>
 
 #include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/compiled_simulation.hpp>
 #include <mockturtle/algorithms/functional_reduction.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
@@ -34,7 +35,37 @@ TEST_CASE( "functional reduction on AIG", "[functional_reduction]" )
   auto vals = simulate<kitty::static_truth_table<2>>( ntk );
 
   CHECK( ntk.size() == 10 );
-  functional_reduction( ntk );
+  functional_reduction_stats st;
+  functional_reduction( ntk, {}, &st );
+  ntk = cleanup_dangling( ntk );
+  CHECK( ntk.size() == 6 );
+  CHECK( st.num_unique_signatures > 0u ); /* the minterms are not compared */
+  CHECK( vals == simulate<kitty::static_truth_table<2>>( ntk ) );
+}
+
+TEST_CASE( "functional reduction on AIG with SIMD simulation", "[functional_reduction]" )
+{
+  aig_network ntk;
+
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+
+  const auto f1 = ntk.create_and( a, !b );
+  const auto f2 = ntk.create_and( !a, b );
+  const auto f3 = ntk.create_and( !a, !b );
+  const auto f4 = ntk.create_and( a, b );
+  const auto f5 = ntk.create_or( f1, f2 );  // a ^ b
+  const auto f6 = ntk.create_or( f3, f4 );  // a == b
+  const auto f7 = ntk.create_and( f5, f6 ); // 0
+
+  ntk.create_po( f5 );
+  ntk.create_po( f6 );
+  ntk.create_po( f7 );
+
+  auto vals = simulate<kitty::static_truth_table<2>>( ntk );
+
+  CHECK( ntk.size() == 10 );
+  functional_reduction<aig_network, simd_simulator>( ntk );
   ntk = cleanup_dangling( ntk );
   CHECK( ntk.size() == 6 );
   CHECK( vals == simulate<kitty::static_truth_table<2>>( ntk ) );
@@ -0,0 +1,127 @@
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <mockturtle/algorithms/incremental_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+
+#include "../random_networks.hpp"
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk, class Simulator>
+bool check_values( Ntk const& ntk, incremental_simulator<Ntk, Simulator>& isim, Simulator const& sim )
+{
+  /* substitutions break the topological order of the node indices */
+  unordered_node_map<kitty::partial_truth_table, Ntk> expected( ntk );
+  bool equal{ true };
+  ntk.foreach_node( [&]( auto const& n ) {
+    simulate_node<Ntk>( ntk, n, expected, sim );
+    equal = equal && isim.value( n ) == expected[n];
+  } );
+  return equal;
+}
+
+} // namespace
+
+TEST_CASE( "incremental simulation of appended patterns", "[incremental_simulation]" )
+{
+  auto const xag = random_xag( 10u, 200u, 11u );
+  fanout_view<xag_network> ntk{ xag };
+
+  partial_simulator sim( ntk.num_pis(), 300u );
+  incremental_simulator isim( ntk, sim );
+  CHECK( check_values( ntk, isim, sim ) );
+  CHECK( isim.stats().num_full == ntk.num_gates() );
+  CHECK( isim.stats().num_partial == 0u );
+
+  /* nothing is stale */
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( !isim.is_stale( n ) );
+  } );
+  CHECK( check_values( ntk, isim, sim ) );
+  CHECK( isim.stats().num_full == ntk.num_gates() );
+
+  /* 100 more patterns spill into two new words */
+  std::mt19937 rng( 3u );
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    std::vector<bool> pattern( ntk.num_pis() );
+    for ( auto j = 0u; j < ntk.num_pis(); ++j )
+    {
+      pattern[j] = ( rng() & 1u ) == 1u;
+    }
+    sim.add_pattern( pattern );
+  }
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( isim.is_stale( n ) );
+  } );
+  auto const num_words = isim.stats().num_words;
+  CHECK( check_values( ntk, isim, sim ) );
+  CHECK( isim.stats().num_full == ntk.num_gates() );
+  CHECK( isim.stats().num_partial == ntk.num_gates() );
+  CHECK( isim.stats().num_words - num_words == 3u * ntk.num_gates() );
+}
+
+TEST_CASE( "incremental simulation after substitutions", "[incremental_simulation]" )
+{
+  auto const aig = random_aig( 10u, 300u, 11u );
+  fanout_view<aig_network> ntk{ aig };
+
+  partial_simulator sim( ntk.num_pis(), 256u );
+  incremental_simulator isim( ntk, sim );
+  isim.update();
+  CHECK( isim.stats().num_full == ntk.num_gates() );
+
+  /* substitute a gate in the middle of the network by a new gate */
+  std::vector<aig_network::node> gates;
+  ntk.foreach_gate( [&]( auto const& n ) {
+    gates.push_back( n );
+  } );
+  auto const old_node = gates[gates.size() / 2];
+  auto const a = ntk.make_signal( gates[1] );
+  auto const b = ntk.make_signal( gates[2] );
+  auto const g = ntk.create_and( a, !b );
+
+  /* count the transitive fanout before the substitution */
+  std::vector<bool> in_tfo( ntk.size(), false );
+  std::vector<aig_network::node> stack{ old_node };
+  uint32_t tfo_size{ 0u };
+  while ( !stack.empty() )
+  {
+    auto const n = stack.back();
+    stack.pop_back();
+    if ( in_tfo[n] )
+    {
+      continue;
+    }
+    in_tfo[n] = true;
+    ++tfo_size;
+    ntk.foreach_fanout( n, [&]( auto const& f ) {
+      stack.push_back( f );
+    } );
+  }
+
+  ntk.substitute_node( old_node, g );
+  CHECK( isim.is_stale( ntk.get_node( g ) ) );
+  CHECK( !isim.is_stale( gates[0] ) );
+
+  /* querying a node outside of the fanout does not simulate anything */
+  auto const num_full = isim.stats().num_full;
+  isim.value( gates[3] );
+  CHECK( isim.stats().num_full == num_full );
+
+  /* only the new gate and the former fanout of the substituted node */
+  CHECK( check_values( ntk, isim, sim ) );
+  CHECK( isim.stats().num_full - num_full <= tfo_size );
+  CHECK( isim.stats().num_full - num_full < ntk.num_gates() );
+}
@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -19,6 +20,7 @@
 #include <mockturtle/networks/xmg.hpp>
 #include <mockturtle/utils/tech_library.hpp>
 #include <mockturtle/views/binding_view.hpp>
+#include <mockturtle/views/switching_activity_view.hpp>
 
 using namespace mockturtle;
 
@@ -375,6 +377,39 @@ TEST_CASE( "Map of sequential AIG", "[mapper]" )
   CHECK( st.delay < 1.9f + eps );
 }
 
+TEST_CASE( "Map with cached switching activities", "[mapper]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4u ), b( 4u );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+
+  map_params ps;
+  ps.eswp_rounds = 2u;
+  map_stats st, st_view;
+  binding_view<klut_network> luts = map( aig, lib, ps, &st );
+
+  switching_activity_view aig_sw{ aig };
+  binding_view<klut_network> luts_view = map( aig_sw, lib, ps, &st_view );
+
+  CHECK( luts_view.num_gates() == luts.num_gates() );
+  CHECK( st_view.area == st.area );
+  CHECK( st_view.power == st.power );
+  CHECK( aig_sw.switching_activity_statistics().num_full_updates == 1u );
+}
+
 TEST_CASE( "Exact map of bad MAJ3 and constant output", "[mapper]" )
 {
   mig_npn_resynthesis resyn{ true };
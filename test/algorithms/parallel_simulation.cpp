@@ -0,0 +1,90 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/detail/switching_activity.hpp>
+#include <mockturtle/algorithms/functional_reduction.hpp>
+#include <mockturtle/algorithms/parallel_simulation.hpp>
+#include <mockturtle/algorithms/pattern_generation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+
+#include "../random_networks.hpp"
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+void check_parallel_simulation( Ntk const& ntk )
+{
+  /* 79 words, such that the threads get ranges of different sizes */
+  partial_simulator const psim( ntk.num_pis(), 5000u );
+  auto const expected = simulate_nodes<kitty::partial_truth_table>( ntk, psim );
+
+  for ( auto num_threads : { 1u, 2u, 3u, 8u, 100u } )
+  {
+    parallel_simulator sim( psim.get_patterns() );
+    sim.set_num_threads( num_threads );
+    CHECK( sim.num_threads() == num_threads );
+
+    unordered_node_map<kitty::partial_truth_table, Ntk> values( ntk );
+    simulate_nodes<Ntk>( ntk, values, sim, true );
+    ntk.foreach_node( [&]( auto const& n ) {
+      CHECK( values[n] == expected[n] );
+    } );
+  }
+}
+
+} // namespace
+
+TEST_CASE( "parallel simulation of AIGs and MIGs", "[parallel_simulation]" )
+{
+  auto const aig = random_aig( 16u, 1000u, 7u );
+  check_parallel_simulation( aig );
+
+  auto const mig = random_mig( 16u, 1000u, 7u );
+  check_parallel_simulation( mig );
+}
+
+TEST_CASE( "parallel simulation of k-LUT networks", "[parallel_simulation]" )
+{
+  auto const klut = random_klut( 16u, 500u, 4u, 7u );
+  check_parallel_simulation( klut );
+}
+
+TEST_CASE( "switching activity with several threads", "[parallel_simulation]" )
+{
+  auto const aig = random_aig( 16u, 1000u, 7u );
+
+  CHECK( detail::switching_activity( aig, 4096u, 4u ) == detail::switching_activity( aig, 4096u ) );
+}
+
+TEST_CASE( "pattern generation and functional reduction with parallel simulation", "[parallel_simulation]" )
+{
+  auto aig = random_aig( 8u, 300u, 7u );
+  auto const expected = simulate<kitty::partial_truth_table>( aig, partial_simulator( aig.num_pis(), 256u ) );
+
+  partial_simulator psim( aig.num_pis(), 1024u );
+  parallel_simulator sim( psim.get_patterns() );
+  sim.set_num_threads( 4u );
+  pattern_generation( aig, psim );
+  pattern_generation( aig, sim );
+  CHECK( sim.num_bits() == psim.num_bits() );
+  for ( auto i = 0u; i < aig.num_pis(); ++i )
+  {
+    CHECK( sim.compute_pi( i ) == psim.compute_pi( i ) );
+  }
+
+  auto reduced = aig.clone();
+  functional_reduction( aig );
+  functional_reduction<aig_network, parallel_simulator>( reduced );
+  aig = cleanup_dangling( aig );
+  reduced = cleanup_dangling( reduced );
+  CHECK( reduced.num_gates() == aig.num_gates() );
+  CHECK( simulate<kitty::partial_truth_table>( reduced, partial_simulator( reduced.num_pis(), 256u ) ) == expected );
+}
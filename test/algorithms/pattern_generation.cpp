@@ -1,5 +1,8 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/pattern_generation.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
@@ -117,3 +120,55 @@ TEST_CASE( "With observability awareness", "[pattern_generation]" )
   /* the generated pattern should be either 000, 010, or 101 */
   CHECK( ( ( !kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) || ( kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 1 ), 3 ) && kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) ) == true );
 }
+
+TEST_CASE( "Stuck-at pattern generation with several threads", "[pattern_generation]" )
+{
+  /* a network with redundant (constant) nodes and many rare nodes */
+  aig_network aig;
+  std::vector<aig_network::signal> pis( 16u );
+  std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+
+  std::vector<aig_network::signal> constants, rare;
+  for ( auto i = 0u; i < 12u; ++i )
+  {
+    auto const f = aig.create_and( pis[i], pis[i + 1] );
+    constants.emplace_back( aig.create_and( f, !pis[i] ) );
+    rare.emplace_back( aig.create_and( aig.create_and( f, pis[i + 2] ), aig.create_and( pis[i + 3], pis[( i + 4 ) % 16u] ) ) );
+  }
+  for ( auto i = 0u; i < 12u; ++i )
+  {
+    aig.create_po( aig.create_or( constants[i], rare[i] ) );
+  }
+
+  partial_simulator sim( aig.num_pis(), 0 );
+  sim.add_pattern( std::vector<bool>( 16u, false ) );
+  pattern_generation_stats st;
+  pattern_generation( aig, sim, {}, &st );
+
+  for ( auto num_threads : { 2u, 3u } )
+  {
+    partial_simulator psim( aig.num_pis(), 0 );
+    psim.add_pattern( std::vector<bool>( 16u, false ) );
+
+    pattern_generation_params ps;
+    ps.num_threads = num_threads;
+    ps.batch_size = 4u;
+    pattern_generation_stats pst;
+    pattern_generation( aig, psim, ps, &pst );
+
+    CHECK( pst.num_constant == st.num_constant );
+    CHECK( pst.num_constant == 12u );
+    CHECK( pst.num_batches > 1u );
+
+    /* all other nodes take both values */
+    auto const tts = simulate_nodes<kitty::partial_truth_table>( aig, psim );
+    uint32_t num_constant_looking{ 0u };
+    aig.foreach_gate( [&]( auto const& n ) {
+      if ( kitty::is_const0( tts[n] ) || kitty::count_zeros( tts[n] ) == 0u )
+      {
+        ++num_constant_looking;
+      }
+    } );
+    CHECK( num_constant_looking == 12u );
+  }
+}
@@ -1,6 +1,9 @@
 #include <catch.hpp>
 
 #include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/compiled_simulation.hpp>
+#include <mockturtle/algorithms/experimental/boolean_optimization.hpp>
+#include <mockturtle/algorithms/experimental/sim_resub.hpp>
 #include <mockturtle/algorithms/resubstitution.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/io/write_verilog.hpp>
@@ -548,3 +551,47 @@ TEST_CASE( "Simulation-guided resubstitution", "[resubstitution]" )
   CHECK( aig.num_pos() == 1 );
   CHECK( aig.num_gates() == 1 );
 }
+
+TEST_CASE( "Simulation-guided resubstitution with SIMD simulation", "[resubstitution]" )
+{
+  aig_network aig;
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+
+  const auto f = aig.create_and( a, aig.create_and( b, a ) );
+  aig.create_po( f );
+
+  const auto tt = simulate<kitty::static_truth_table<2u>>( aig )[0];
+  CHECK( tt._bits == 0x8 );
+
+  sim_resubstitution<aig_network, simd_simulator>( aig );
+
+  aig = cleanup_dangling( aig );
+
+  /* check equivalence */
+  const auto tt_opt = simulate<kitty::static_truth_table<2u>>( aig )[0];
+  CHECK( tt_opt._bits == tt._bits );
+  CHECK( aig.num_gates() == 1 );
+}
+
+TEST_CASE( "Simulation-guided resubstitution of an AIG with a sharded hash table", "[resubstitution]" )
+{
+  parallel_aig_network aig;
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  aig.create_po( aig.create_and( a, aig.create_and( b, a ) ) );
+  aig.create_po( aig.create_and( c, aig.create_and( c, b ) ) );
+
+  const auto tts = simulate<kitty::static_truth_table<3u>>( aig );
+
+  sim_resubstitution( aig );
+  experimental::simulation_aig_heuristic_resub( aig );
+
+  aig = cleanup_dangling( aig );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig ) == tts );
+  CHECK( aig.num_gates() == 2 );
+}
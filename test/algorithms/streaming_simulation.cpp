@@ -0,0 +1,99 @@
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/streaming_simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* a chain of ripple-carry adders, whose cut width is small */
+template<class Ntk>
+Ntk adder_chain( uint32_t num_bits )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a, b;
+  for ( auto i = 0u; i < num_bits; ++i )
+  {
+    a.push_back( ntk.create_pi() );
+    b.push_back( ntk.create_pi() );
+  }
+  auto carry = ntk.get_constant( false );
+  for ( auto i = 0u; i < num_bits; ++i )
+  {
+    ntk.create_po( ntk.create_xor3( a[i], b[i], carry ) );
+    carry = ntk.create_maj( a[i], b[i], carry );
+  }
+  ntk.create_po( carry );
+  ntk.create_po( ntk.get_constant( true ) );
+  return ntk;
+}
+
+} // namespace
+
+TEST_CASE( "streaming simulation with truth tables", "[streaming_simulation]" )
+{
+  auto const aig = adder_chain<aig_network>( 4u );
+  CHECK( simulate_streaming<kitty::static_truth_table<8>>( aig ) == simulate<kitty::static_truth_table<8>>( aig ) );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  streaming_simulation_stats st;
+  CHECK( simulate_streaming<kitty::dynamic_truth_table>( aig, sim, &st ) == simulate<kitty::dynamic_truth_table>( aig, sim ) );
+  CHECK( st.num_chunks == 1u );
+  CHECK( st.max_live_values > 0u );
+  CHECK( st.max_live_values < aig.size() );
+
+  CHECK( simulate_streaming<bool>( aig, default_simulator<bool>( { true, false, true, true, false, true, false, false } ) ) ==
+         simulate<bool>( aig, default_simulator<bool>( { true, false, true, true, false, true, false, false } ) ) );
+}
+
+TEST_CASE( "streaming simulation frees values after their last use", "[streaming_simulation]" )
+{
+  auto const mig = adder_chain<mig_network>( 64u );
+  partial_simulator const sim( mig.num_pis(), 200u );
+
+  streaming_simulation_stats st;
+  CHECK( simulate_streaming<kitty::partial_truth_table>( mig, sim, &st ) == simulate<kitty::partial_truth_table>( mig, sim ) );
+
+  /* the primary outputs are kept alive until the end */
+  CHECK( st.max_live_values < mig.num_pos() + 16u );
+  CHECK( st.max_live_values < mig.size() / 4u );
+}
+
+TEST_CASE( "streaming simulation of pattern chunks", "[streaming_simulation]" )
+{
+  auto const aig = adder_chain<aig_network>( 16u );
+  partial_simulator const sim( aig.num_pis(), 1000u );
+  auto const expected = simulate<kitty::partial_truth_table>( aig, sim );
+
+  for ( auto chunk_words : { 0u, 1u, 3u, 15u, 16u, 100u } )
+  {
+    streaming_simulation_params ps;
+    ps.chunk_words = chunk_words;
+    streaming_simulation_stats st;
+    CHECK( simulate_streaming( aig, sim, ps, &st ) == expected );
+    CHECK( st.num_chunks == ( chunk_words == 0u ? 1u : ( 16u + chunk_words - 1u ) / chunk_words ) );
+  }
+
+  /* networks without in-place simulation */
+  klut_network klut;
+  auto const a = klut.create_pi();
+  auto const b = klut.create_pi();
+  auto const c = klut.create_pi();
+  klut.create_po( klut.create_maj( a, b, klut.create_xor( b, c ) ) );
+  partial_simulator const klut_sim( klut.num_pis(), 300u );
+  streaming_simulation_params ps;
+  ps.chunk_words = 2u;
+  CHECK( simulate_streaming( klut, klut_sim, ps ) == simulate<kitty::partial_truth_table>( klut, klut_sim ) );
+}
@@ -0,0 +1,97 @@
+#include <catch.hpp>
+
+#include <cmath>
+#include <random>
+
+#include <mockturtle/algorithms/detail/switching_activity.hpp>
+#include <mockturtle/algorithms/switching_activity.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+
+#include "../random_networks.hpp"
+
+using namespace mockturtle;
+
+TEST_CASE( "switching activity engine without input statistics", "[switching_activity]" )
+{
+  auto const aig = random_aig( 16u, 500u, 11u );
+  switching_activity_engine engine( aig );
+  CHECK( engine.activities() == detail::switching_activity( aig ) );
+
+  auto const klut = random_klut( 12u, 200u, 3u, 11u );
+  switching_activity_params ps;
+  ps.num_patterns = 1000u;
+  ps.num_threads = 3u;
+  switching_activity_engine klut_engine( klut, ps );
+  CHECK( klut_engine.activities() == detail::switching_activity( klut, 1000u ) );
+
+  /* queries are served from the cache */
+  klut.foreach_node( [&]( auto const& n ) {
+    klut_engine.activity( n );
+  } );
+  CHECK( klut_engine.stats().num_full_updates == 1u );
+}
+
+TEST_CASE( "switching activity with input statistics", "[switching_activity]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const f = aig.create_and( a, b );
+  aig.create_po( f );
+
+  switching_activity_params ps;
+  ps.num_patterns = 1u << 14;
+  ps.input_probabilities = { 0.5, 1.0 };
+  switching_activity_engine weighted( aig, ps );
+  CHECK( weighted.activity( aig.get_node( b ) ) == 0.0f );
+  CHECK( weighted.activity( aig.get_node( f ) ) == weighted.activity( aig.get_node( a ) ) );
+  CHECK( std::abs( weighted.activity( aig.get_node( a ) ) - 0.5f ) < 0.02f );
+
+  /* temporally correlated inputs toggle less often than independent ones */
+  ps.input_probabilities = { 0.5, 0.25 };
+  ps.toggle_rates = { 0.1, 0.0 };
+  switching_activity_engine correlated( aig, ps );
+  CHECK( std::abs( correlated.activity( aig.get_node( a ) ) - 0.1f ) < 0.02f );
+  CHECK( correlated.activity( aig.get_node( b ) ) == 0.0f );
+  CHECK( correlated.activity( aig.get_node( f ) ) <= correlated.activity( aig.get_node( a ) ) );
+
+  ps.toggle_rates = { 0.1, 0.5 };
+  switching_activity_engine correlated2( aig, ps );
+  CHECK( std::abs( correlated2.activity( aig.get_node( b ) ) - 0.5f ) < 0.02f );
+  CHECK( correlated2.power( []( auto const& ) { return 1.0; } ) == Approx( correlated2.activity( aig.get_node( f ) ) ) );
+}
+
+TEST_CASE( "incremental switching activity after substitutions", "[switching_activity]" )
+{
+  auto aig = random_aig( 16u, 500u, 11u );
+
+  switching_activity_params ps;
+  ps.toggle_rates.assign( aig.num_pis(), 0.2 );
+  switching_activity_engine engine( aig, ps );
+  engine.update();
+  CHECK( engine.is_up_to_date() );
+
+  std::mt19937 rng( 3u );
+  for ( auto i = 0u; i < 10u; ++i )
+  {
+    auto const n = aig.index_to_node( aig.num_pis() + 1u + rng() % 100u );
+    if ( aig.is_dead( n ) )
+    {
+      continue;
+    }
+    auto const g = aig.create_xor( aig.make_signal( aig.index_to_node( 1u + rng() % aig.num_pis() ) ), aig.make_signal( aig.index_to_node( 1u + rng() % aig.num_pis() ) ) );
+    aig.substitute_node( n, g );
+  }
+  CHECK( !engine.is_up_to_date() );
+
+  switching_activity_engine fresh( aig, ps );
+  auto const& activities = engine.activities();
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( activities[aig.node_to_index( n )] == fresh.activity( n ) );
+  } );
+  CHECK( engine.stats().num_full_updates == 1u );
+  CHECK( engine.stats().num_incremental_updates == 1u );
+  CHECK( engine.stats().num_resimulated < aig.num_gates() );
+  CHECK( engine.power() == fresh.power() );
+}
@@ -0,0 +1,147 @@
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <mockturtle/algorithms/dont_cares.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/ternary_simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include "../random_networks.hpp"
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* known values agree with binary simulation, and X only occurs where an input is X */
+template<class Ntk>
+void check_ternary_simulation( Ntk const& ntk )
+{
+  partial_simulator const sim( ntk.num_pis(), 300u );
+  auto const expected = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+
+  auto const known = simulate_nodes<ternary_truth_table>( ntk, ternary_simulator( sim ) );
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( known[n].ones == expected[n] );
+    CHECK( known[n].zeros == ~expected[n] );
+  } );
+
+  /* inputs are X with probability 1/4; two completions of the X inputs */
+  std::mt19937 rng( 1u );
+  std::vector<kitty::partial_truth_table> masks, completion0, completion1;
+  for ( auto i = 0u; i < ntk.num_pis(); ++i )
+  {
+    kitty::partial_truth_table a( 300u ), b( 300u ), c( 300u );
+    kitty::create_random( a, rng() );
+    kitty::create_random( b, rng() );
+    kitty::create_random( c, rng() );
+    masks.push_back( a | b );
+    completion0.push_back( ( sim.compute_pi( i ) & masks.back() ) | ( c & ~masks.back() ) );
+    completion1.push_back( ( sim.compute_pi( i ) & masks.back() ) | ( ~c & ~masks.back() ) );
+  }
+
+  auto const values = simulate_nodes<ternary_truth_table>( ntk, ternary_simulator( sim.get_patterns(), masks ) );
+  auto const values0 = simulate_nodes<kitty::partial_truth_table>( ntk, partial_simulator( completion0 ) );
+  auto const values1 = simulate_nodes<kitty::partial_truth_table>( ntk, partial_simulator( completion1 ) );
+  ntk.foreach_node( [&]( auto const& n ) {
+    auto const k = values[n].known();
+    CHECK( ( k & values[n].ones ) == ( k & values0[n] ) );
+    CHECK( ( k & values[n].ones ) == ( k & values1[n] ) );
+    CHECK( ( values0[n] ^ values1[n] ) == ( ( values0[n] ^ values1[n] ) & ~k ) );
+  } );
+}
+
+} // namespace
+
+TEST_CASE( "ternary simulation of single gates", "[ternary_simulation]" )
+{
+  xmg_network xmg;
+  auto const a = xmg.create_pi();
+  auto const b = xmg.create_pi();
+  auto const c = xmg.create_pi();
+  xmg.create_po( xmg.create_and( a, b ) );
+  xmg.create_po( xmg.create_maj( a, b, c ) );
+  xmg.create_po( xmg.create_xor3( a, b, c ) );
+
+  /* patterns: a = 0, 1, 1, X; b = X, X, 1, X; c = 1, 1, X, 0 */
+  ternary_simulator sim( 3u, 0u );
+  sim.add_pattern( { false, false, true }, { true, false, true } );
+  sim.add_pattern( { true, false, true }, { true, false, true } );
+  sim.add_pattern( { true, true, false }, { true, true, false } );
+  sim.add_pattern( { false, false, false }, { false, false, true } );
+  CHECK( sim.num_bits() == 4u );
+
+  auto const values = simulate_nodes<ternary_truth_table>( xmg, sim );
+  std::vector<ternary_truth_table> pos;
+  xmg.foreach_po( [&]( auto const& f ) {
+    pos.push_back( xmg.is_complemented( f ) ? ~values[f] : values[f] );
+  } );
+
+  /* AND: 0, X, 1, X */
+  CHECK( !pos[0].is_unknown( 0u ) );
+  CHECK( !pos[0].is_one( 0u ) );
+  CHECK( pos[0].is_unknown( 1u ) );
+  CHECK( pos[0].is_one( 2u ) );
+  CHECK( pos[0].is_unknown( 3u ) );
+
+  /* MAJ: X, 1, 1, X */
+  CHECK( pos[1].is_unknown( 0u ) );
+  CHECK( pos[1].is_one( 1u ) );
+  CHECK( pos[1].is_one( 2u ) );
+  CHECK( pos[1].is_unknown( 3u ) );
+
+  /* XOR3 is X whenever an input is X */
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    CHECK( pos[2].is_unknown( i ) );
+  }
+
+  /* LUT: a | b with a = 1 and b = X */
+  klut_network klut;
+  auto const x = klut.create_pi();
+  auto const y = klut.create_pi();
+  klut.create_po( klut.create_or( x, y ) );
+  ternary_simulator lut_sim( 2u, 0u );
+  lut_sim.add_pattern( { true, false }, { true, false } );
+  lut_sim.add_pattern( { false, false }, { true, false } );
+  auto const lut_values = simulate_nodes<ternary_truth_table>( klut, lut_sim );
+  klut.foreach_po( [&]( auto const& f ) {
+    CHECK( lut_values[f].is_one( 0u ) );
+    CHECK( lut_values[f].is_unknown( 1u ) );
+  } );
+}
+
+TEST_CASE( "ternary simulation of random networks", "[ternary_simulation]" )
+{
+  check_ternary_simulation( random_aig( 12u, 200u, 13u ) );
+  check_ternary_simulation( random_xag( 12u, 200u, 13u ) );
+  check_ternary_simulation( random_mig( 12u, 200u, 13u ) );
+  check_ternary_simulation( random_klut( 12u, 100u, 4u, 13u ) );
+}
+
+TEST_CASE( "observability don't cares with ternary simulation", "[ternary_simulation]" )
+{
+  auto const aig = random_aig( 8u, 100u, 13u );
+  fanout_view<aig_network> ntk{ aig };
+  partial_simulator const sim( ntk.num_pis(), 256u );
+
+  uint32_t num_unobservable{ 0u };
+  ntk.foreach_gate( [&]( auto const& n ) {
+    unordered_node_map<kitty::partial_truth_table, fanout_view<aig_network>> tts( ntk );
+    auto const odc = observability_dont_cares( ntk, n, sim, tts );
+    auto const ternary_odc = ternary_observability_dont_cares( ntk, n, sim );
+    CHECK( ( ternary_odc & ~odc ) == kitty::partial_truth_table( sim.num_bits() ) );
+    num_unobservable += kitty::count_ones( ternary_odc );
+  } );
+  CHECK( num_unobservable > 0u );
+}
@@ -39,6 +39,24 @@ TEST_CASE( "build a full adder with an AIG", "[arithmetic]" )
   CHECK( simm[1]._bits == 0xe8 );
 }
 
+TEST_CASE( "build a full adder with an AIG with a sharded hash table", "[arithmetic]" )
+{
+  parallel_aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  auto [sum, carry] = full_adder( aig, a, b, c );
+
+  aig.create_po( sum );
+  aig.create_po( carry );
+
+  const auto simm = simulate<kitty::static_truth_table<3u>>( aig );
+  CHECK( simm[0]._bits == 0x96 );
+  CHECK( simm[1]._bits == 0xe8 );
+  CHECK( !aig.is_maj( aig.get_node( carry ) ) );
+}
+
 TEST_CASE( "build a half adder with an AIG", "[arithmetic]" )
 {
   aig_network aig;
@@ -1,9 +1,18 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/io/write_patterns.hpp>
+#include <mockturtle/utils/pattern_file.hpp>
 
 using namespace mockturtle;
 
@@ -30,3 +39,148 @@ TEST_CASE( "write patterns", "[write_patterns]" )
                       "0d4\n"
                       "19a\n" );
 }
+
+TEST_CASE( "write and read binary patterns", "[write_patterns]" )
+{
+  partial_simulator sim( 5, 300 );
+  std::string const filename = "write_patterns_binary.bin";
+  CHECK( write_patterns_binary( sim, filename ) );
+  CHECK( pattern_file::is_pattern_file( filename ) );
+
+  {
+    pattern_file file( filename );
+    CHECK( file.is_open() );
+    CHECK( file.num_pis() == 5u );
+    CHECK( file.num_patterns() == 300u );
+    CHECK( file.num_words() == 5u );
+    CHECK( file.stride() == 8u );
+    CHECK( reinterpret_cast<std::uintptr_t>( file.words( 1u ) ) % 64u == 0u );
+    CHECK( std::equal( sim.get_pattern( 3u ).begin(), sim.get_pattern( 3u ).end(), file.words( 3u ) ) );
+  }
+
+  partial_simulator const sim2( filename );
+  CHECK( sim2.num_bits() == 300u );
+  CHECK( sim2.get_patterns() == sim.get_patterns() );
+
+  bit_packed_simulator const sim3( filename, 100u );
+  CHECK( sim3.num_bits() == 100u );
+  CHECK( sim3.num_pis() == 5u );
+  for ( auto i = 0u; i < 5u; ++i )
+  {
+    auto tt = sim.get_pattern( i );
+    tt.resize( 100 );
+    CHECK( sim3.get_pattern( i ) == tt );
+  }
+
+  /* text files are still read as before */
+  std::ofstream os( "write_patterns.txt" );
+  write_patterns( sim, os );
+  os.close();
+  CHECK( !pattern_file::is_pattern_file( "write_patterns.txt" ) );
+  CHECK( partial_simulator( "write_patterns.txt" ).get_patterns() == sim.get_patterns() );
+  CHECK( !pattern_file( "write_patterns.txt" ).is_open() );
+
+  std::remove( filename.c_str() );
+  std::remove( "write_patterns.txt" );
+}
+
+TEST_CASE( "read truncated binary patterns", "[write_patterns]" )
+{
+  partial_simulator sim( 5, 300 );
+  std::string const filename = "truncated_patterns_binary.bin";
+  CHECK( write_patterns_binary( sim, filename ) );
+
+  std::string contents;
+  {
+    std::ifstream in( filename, std::ifstream::binary );
+    contents.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+  }
+
+  /* header only partially written, and rows missing */
+  for ( auto const size : { std::size_t( 8u ), std::size_t( 40u ), contents.size() - 64u } )
+  {
+    {
+      std::ofstream out( filename, std::ofstream::binary | std::ofstream::trunc );
+      out.write( contents.data(), size );
+    }
+    CHECK( pattern_file::is_pattern_file( filename ) );
+    CHECK( !pattern_file( filename ).is_open() );
+
+    partial_simulator const sim2( filename );
+    CHECK( sim2.num_pis() == 0u );
+    CHECK( sim2.num_bits() == 0u );
+  }
+
+  std::remove( filename.c_str() );
+}
+
+TEST_CASE( "read binary patterns with an overflowing header", "[write_patterns]" )
+{
+  std::string const filename = "overflow_patterns_binary.bin";
+
+  pattern_file_header header{};
+  std::copy( pattern_file_header::magic_value, pattern_file_header::magic_value + 8, header.magic );
+  header.version = pattern_file_header::current_version;
+  header.num_pis = 2u;
+
+  /* 2 * 2^60 words wrap around to 0 bytes, and 2^64 - 1 patterns to 0 words */
+  for ( auto const [num_patterns, stride] : { std::make_pair( UINT64_C( 64 ), UINT64_C( 1 ) << 60 ),
+                                              std::make_pair( ~UINT64_C( 0 ), pattern_file_header::words_alignment ) } )
+  {
+    header.num_patterns = num_patterns;
+    header.stride = stride;
+    {
+      std::vector<uint64_t> const rows( 2u * pattern_file_header::words_alignment, UINT64_C( 0 ) );
+      std::ofstream out( filename, std::ofstream::binary | std::ofstream::trunc );
+      out.write( reinterpret_cast<char const*>( &header ), sizeof( header ) );
+      out.write( reinterpret_cast<char const*>( rows.data() ), rows.size() * sizeof( uint64_t ) );
+    }
+    CHECK( pattern_file::is_pattern_file( filename ) );
+    CHECK( !pattern_file( filename ).is_open() );
+
+    partial_simulator const sim( filename );
+    CHECK( sim.num_pis() == 0u );
+    CHECK( sim.num_bits() == 0u );
+  }
+
+  std::remove( filename.c_str() );
+}
+
+TEST_CASE( "append binary patterns", "[write_patterns]" )
+{
+  std::string const filename = "append_patterns_binary.bin";
+  std::remove( filename.c_str() );
+
+  /* first run creates the file */
+  partial_simulator sim( 7, 100 );
+  CHECK( append_patterns_binary( sim, filename ) );
+
+  /* later runs continue from the file and append their new patterns */
+  std::mt19937 rng( 1u );
+  for ( auto run = 0u; run < 3u; ++run )
+  {
+    partial_simulator loaded( filename );
+    CHECK( loaded.get_patterns() == sim.get_patterns() );
+
+    for ( auto j = 0u; j < 77u + run * 400u; ++j )
+    {
+      std::vector<bool> pattern( 7u );
+      std::generate( pattern.begin(), pattern.end(), [&]() { return ( rng() & 1u ) == 1u; } );
+      loaded.add_pattern( pattern );
+      sim.add_pattern( pattern );
+    }
+    CHECK( append_patterns_binary( loaded, filename ) );
+  }
+
+  pattern_file const file( filename );
+  CHECK( file.num_patterns() == sim.num_bits() );
+  CHECK( file.stride() >= file.num_words() );
+  CHECK( partial_simulator( filename ).get_patterns() == sim.get_patterns() );
+
+  /* files with different number of inputs are not modified */
+  partial_simulator other( 3, 10 );
+  CHECK( !append_patterns_binary( other, filename, 0u ) );
+  CHECK( partial_simulator( filename ).num_bits() == sim.num_bits() );
+
+  std::remove( filename.c_str() );
+}
@@ -1,5 +1,11 @@
 #include <catch.hpp>
 
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operations.hpp>
@@ -8,25 +14,36 @@
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/traits.hpp>
+#include <mockturtle/utils/node_map.hpp>
+
+namespace mockturtle
+{
+/* the network classes can be forward declared */
+class aig_network;
+class parallel_aig_network;
+class cow_aig_network;
+class soa_aig_network;
+class aig_network32;
+} // namespace mockturtle
 
 using namespace mockturtle;
 
-TEST_CASE( "create and use constants in an AIG", "[aig]" )
+TEMPLATE_TEST_CASE( "create and use constants in an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
   CHECK( aig.size() == 1 );
-  CHECK( has_get_constant_v<aig_network> );
-  CHECK( has_is_constant_v<aig_network> );
-  CHECK( has_get_node_v<aig_network> );
-  CHECK( has_is_complemented_v<aig_network> );
+  CHECK( has_get_constant_v<TestType> );
+  CHECK( has_is_constant_v<TestType> );
+  CHECK( has_get_node_v<TestType> );
+  CHECK( has_is_complemented_v<TestType> );
 
   const auto c0 = aig.get_constant( false );
   CHECK( aig.is_constant( aig.get_node( c0 ) ) );
   CHECK( !aig.is_pi( aig.get_node( c0 ) ) );
 
   CHECK( aig.size() == 1 );
-  CHECK( std::is_same_v<std::decay_t<decltype( c0 )>, aig_network::signal> );
+  CHECK( std::is_same_v<std::decay_t<decltype( c0 )>, typename TestType::signal> );
   CHECK( aig.get_node( c0 ) == 0 );
   CHECK( !aig.is_complemented( c0 ) );
 
@@ -45,11 +62,11 @@ TEST_CASE( "create and use constants in an AIG", "[aig]" )
   CHECK( c0 == +c0 );
 }
 
-TEST_CASE( "create and use primary inputs in an AIG", "[aig]" )
+TEMPLATE_TEST_CASE( "create and use primary inputs in an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
-  CHECK( has_create_pi_v<aig_network> );
+  CHECK( has_create_pi_v<TestType> );
 
   auto a = aig.create_pi();
   auto b = aig.create_pi();
@@ -62,7 +79,7 @@ TEST_CASE( "create and use primary inputs in an AIG", "[aig]" )
   CHECK( aig.pi_index( aig.get_node( a ) ) == 0 );
   CHECK( aig.pi_index( aig.get_node( b ) ) == 1 );
 
-  CHECK( std::is_same_v<std::decay_t<decltype( a )>, aig_network::signal> );
+  CHECK( std::is_same_v<std::decay_t<decltype( a )>, typename TestType::signal> );
 
   CHECK( a.index == 1 );
   CHECK( a.complement == 0 );
@@ -103,11 +120,11 @@ TEST_CASE( "create and use primary inputs in an AIG", "[aig]" )
   CHECK( a.complement == 1 );
 }
 
-TEST_CASE( "create and use primary outputs in an AIG", "[aig]" )
+TEMPLATE_TEST_CASE( "create and use primary outputs in an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
-  CHECK( has_create_po_v<aig_network> );
+  CHECK( has_create_po_v<TestType> );
 
   const auto c0 = aig.get_constant( false );
   const auto x1 = aig.create_pi();
@@ -139,12 +156,12 @@ TEST_CASE( "create and use primary outputs in an AIG", "[aig]" )
   } );
 }
 
-TEST_CASE( "create unary operations in an AIG", "[aig]" )
+TEMPLATE_TEST_CASE( "create unary operations in an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
-  CHECK( has_create_buf_v<aig_network> );
-  CHECK( has_create_not_v<aig_network> );
+  CHECK( has_create_buf_v<TestType> );
+  CHECK( has_create_not_v<TestType> );
 
   auto x1 = aig.create_pi();
 
@@ -158,16 +175,16 @@ TEST_CASE( "create unary operations in an AIG", "[aig]" )
   CHECK( f2 == !x1 );
 }
 
-TEST_CASE( "create binary operations in an AIG", "[aig]" )
+TEMPLATE_TEST_CASE( "create binary operations in an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
-  CHECK( has_create_and_v<aig_network> );
-  CHECK( has_create_nand_v<aig_network> );
-  CHECK( has_create_or_v<aig_network> );
-  CHECK( has_create_nor_v<aig_network> );
-  CHECK( has_create_xor_v<aig_network> );
-  CHECK( has_create_xnor_v<aig_network> );
+  CHECK( has_create_and_v<TestType> );
+  CHECK( has_create_nand_v<TestType> );
+  CHECK( has_create_or_v<TestType> );
+  CHECK( has_create_nor_v<TestType> );
+  CHECK( has_create_xor_v<TestType> );
+  CHECK( has_create_xnor_v<TestType> );
 
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
@@ -196,9 +213,9 @@ TEST_CASE( "create binary operations in an AIG", "[aig]" )
   CHECK( f5 == !f6 );
 }
 
-TEST_CASE( "hash nodes in AIG network", "[aig]" )
+TEMPLATE_TEST_CASE( "hash nodes in AIG network", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
   auto a = aig.create_pi();
   auto b = aig.create_pi();
@@ -212,11 +229,11 @@ TEST_CASE( "hash nodes in AIG network", "[aig]" )
   CHECK( aig.get_node( f ) == aig.get_node( g ) );
 }
 
-TEST_CASE( "clone a AIG network", "[aig]" )
+TEMPLATE_TEST_CASE( "clone a AIG network", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  CHECK( has_clone_v<aig_network> );
+  CHECK( has_clone_v<TestType> );
 
-  aig_network aig0;
+  TestType aig0;
   auto a = aig0.create_pi();
   auto b = aig0.create_pi();
   auto f0 = aig0.create_and( a, b );
@@ -235,11 +252,11 @@ TEST_CASE( "clone a AIG network", "[aig]" )
   CHECK( aig_clone.num_gates() == 1 );
 }
 
-TEST_CASE( "clone a node in AIG network", "[aig]" )
+TEMPLATE_TEST_CASE( "clone a node in AIG network", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig1, aig2;
+  TestType aig1, aig2;
 
-  CHECK( has_clone_node_v<aig_network> );
+  CHECK( has_clone_node_v<TestType> );
 
   auto a1 = aig1.create_pi();
   auto b1 = aig1.create_pi();
@@ -258,16 +275,16 @@ TEST_CASE( "clone a node in AIG network", "[aig]" )
   } );
 }
 
-TEST_CASE( "structural properties of an AIG", "[aig]" )
+TEMPLATE_TEST_CASE( "structural properties of an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
-  CHECK( has_size_v<aig_network> );
-  CHECK( has_num_pis_v<aig_network> );
-  CHECK( has_num_pos_v<aig_network> );
-  CHECK( has_num_gates_v<aig_network> );
-  CHECK( has_fanin_size_v<aig_network> );
-  CHECK( has_fanout_size_v<aig_network> );
+  CHECK( has_size_v<TestType> );
+  CHECK( has_num_pis_v<TestType> );
+  CHECK( has_num_pos_v<TestType> );
+  CHECK( has_num_gates_v<TestType> );
+  CHECK( has_fanin_size_v<TestType> );
+  CHECK( has_fanout_size_v<TestType> );
 
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
@@ -292,9 +309,9 @@ TEST_CASE( "structural properties of an AIG", "[aig]" )
   CHECK( aig.fanout_size( aig.get_node( f2 ) ) == 1 );
 }
 
-TEST_CASE( "check has_and in AIG", "[aig]" )
+TEMPLATE_TEST_CASE( "check has_and in AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   auto const x1 = aig.create_pi();
   auto const x2 = aig.create_pi();
   auto const x3 = aig.create_pi();
@@ -316,15 +333,15 @@ TEST_CASE( "check has_and in AIG", "[aig]" )
   CHECK( *aig.has_and( !n7, !n5 ) == n8 );
 }
 
-TEST_CASE( "node and signal iteration in an AIG", "[aig]" )
+TEMPLATE_TEST_CASE( "node and signal iteration in an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
-  CHECK( has_foreach_node_v<aig_network> );
-  CHECK( has_foreach_pi_v<aig_network> );
-  CHECK( has_foreach_po_v<aig_network> );
-  CHECK( has_foreach_gate_v<aig_network> );
-  CHECK( has_foreach_fanin_v<aig_network> );
+  CHECK( has_foreach_node_v<TestType> );
+  CHECK( has_foreach_pi_v<TestType> );
+  CHECK( has_foreach_po_v<TestType> );
+  CHECK( has_foreach_gate_v<TestType> );
+  CHECK( has_foreach_fanin_v<TestType> );
 
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
@@ -431,14 +448,14 @@ TEST_CASE( "node and signal iteration in an AIG", "[aig]" )
   CHECK( mask == 2 );
 }
 
-TEST_CASE( "compute values in AIGs", "[aig]" )
+TEMPLATE_TEST_CASE( "compute values in AIGs", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
-  CHECK( has_compute_v<aig_network, bool> );
-  CHECK( has_compute_v<aig_network, kitty::dynamic_truth_table> );
-  CHECK( has_compute_v<aig_network, kitty::partial_truth_table> );
-  CHECK( has_compute_inplace_v<aig_network, kitty::partial_truth_table> );
+  CHECK( has_compute_v<TestType, bool> );
+  CHECK( has_compute_v<TestType, kitty::dynamic_truth_table> );
+  CHECK( has_compute_v<TestType, kitty::partial_truth_table> );
+  CHECK( has_compute_inplace_v<TestType, kitty::partial_truth_table> );
 
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
@@ -532,15 +549,15 @@ TEST_CASE( "compute values in AIGs", "[aig]" )
   }
 }
 
-TEST_CASE( "custom node values in AIGs", "[aig]" )
+TEMPLATE_TEST_CASE( "custom node values in AIGs", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
-  CHECK( has_clear_values_v<aig_network> );
-  CHECK( has_value_v<aig_network> );
-  CHECK( has_set_value_v<aig_network> );
-  CHECK( has_incr_value_v<aig_network> );
-  CHECK( has_decr_value_v<aig_network> );
+  CHECK( has_clear_values_v<TestType> );
+  CHECK( has_value_v<TestType> );
+  CHECK( has_set_value_v<TestType> );
+  CHECK( has_incr_value_v<TestType> );
+  CHECK( has_decr_value_v<TestType> );
 
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
@@ -567,13 +584,13 @@ TEST_CASE( "custom node values in AIGs", "[aig]" )
   } );
 }
 
-TEST_CASE( "visited values in AIGs", "[aig]" )
+TEMPLATE_TEST_CASE( "visited values in AIGs", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
-  CHECK( has_clear_visited_v<aig_network> );
-  CHECK( has_visited_v<aig_network> );
-  CHECK( has_set_visited_v<aig_network> );
+  CHECK( has_clear_visited_v<TestType> );
+  CHECK( has_visited_v<TestType> );
+  CHECK( has_set_visited_v<TestType> );
 
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
@@ -596,9 +613,9 @@ TEST_CASE( "visited values in AIGs", "[aig]" )
   } );
 }
 
-TEST_CASE( "simulate some special functions in AIGs", "[aig]" )
+TEMPLATE_TEST_CASE( "simulate some special functions in AIGs", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
   const auto x3 = aig.create_pi();
@@ -617,12 +634,12 @@ TEST_CASE( "simulate some special functions in AIGs", "[aig]" )
   CHECK( result[1]._bits[0] == 0xd8u );
 }
 
-TEST_CASE( "substitute nodes with propagation in AIGs (test case 1)", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute nodes with propagation in AIGs (test case 1)", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  CHECK( has_substitute_node_v<aig_network> );
-  CHECK( has_replace_in_node_v<aig_network> );
+  CHECK( has_substitute_node_v<TestType> );
+  CHECK( has_replace_in_node_v<TestType> );
 
-  aig_network aig;
+  TestType aig;
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
   const auto x3 = aig.create_pi();
@@ -670,9 +687,9 @@ TEST_CASE( "substitute nodes with propagation in AIGs (test case 1)", "[aig]" )
   CHECK( aig.num_gates() == 4u );
 }
 
-TEST_CASE( "substitute nodes with propagation in AIGs (test case 2)", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute nodes with propagation in AIGs (test case 2)", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
   const auto x3 = aig.create_pi();
@@ -719,9 +736,9 @@ TEST_CASE( "substitute nodes with propagation in AIGs (test case 2)", "[aig]" )
   CHECK( aig.num_gates() == 1u );
 }
 
-TEST_CASE( "substitute input by constant in NAND-based XOR circuit", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute input by constant in NAND-based XOR circuit", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
 
@@ -744,9 +761,9 @@ TEST_CASE( "substitute input by constant in NAND-based XOR circuit", "[aig]" )
   CHECK( aig.fanout_size( aig.get_node( f4 ) ) == 0u );
 }
 
-TEST_CASE( "substitute node by constant in NAND-based XOR circuit", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute node by constant in NAND-based XOR circuit", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
 
@@ -774,9 +791,9 @@ TEST_CASE( "substitute node by constant in NAND-based XOR circuit", "[aig]" )
   CHECK( aig.is_dead( aig.get_node( f4 ) ) );
 }
 
-TEST_CASE( "substitute node by constant in NAND-based XOR circuit (test case 2)", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute node by constant in NAND-based XOR circuit (test case 2)", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
 
@@ -799,9 +816,9 @@ TEST_CASE( "substitute node by constant in NAND-based XOR circuit (test case 2)"
   CHECK( aig.fanout_size( aig.get_node( f4 ) ) == 1u );
 }
 
-TEST_CASE( "invoke take_out_node two times on the same node", "[aig]" )
+TEMPLATE_TEST_CASE( "invoke take_out_node two times on the same node", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   const auto x1 = aig.create_pi();
   const auto x2 = aig.create_pi();
 
@@ -827,9 +844,9 @@ TEST_CASE( "invoke take_out_node two times on the same node", "[aig]" )
   CHECK( aig.fanout_size( aig.get_node( x2 ) ) == 1u );
 }
 
-TEST_CASE( "substitute node and restrash", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute node and restrash", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   auto const x1 = aig.create_pi();
   auto const x2 = aig.create_pi();
 
@@ -860,9 +877,9 @@ TEST_CASE( "substitute node and restrash", "[aig]" )
   CHECK( aig.fanout_size( aig.get_node( f2 ) ) == 1 );
 }
 
-TEST_CASE( "substitute node with complemented node in aig_network", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute node with complemented node in aig_network", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   auto const x1 = aig.create_pi();
   auto const x2 = aig.create_pi();
 
@@ -887,12 +904,12 @@ TEST_CASE( "substitute node with complemented node in aig_network", "[aig]" )
   CHECK( simulate<kitty::static_truth_table<2u>>( aig )[0]._bits == 0x7 );
 }
 
-TEST_CASE( "substitute multiple nodes", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute multiple nodes", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  using node = aig_network::node;
-  using signal = aig_network::signal;
+  using node = typename TestType::node;
+  using signal = typename TestType::signal;
 
-  aig_network aig;
+  TestType aig;
   auto const x1 = aig.create_pi();
   auto const x2 = aig.create_pi();
   auto const x3 = aig.create_pi();
@@ -948,9 +965,9 @@ TEST_CASE( "substitute multiple nodes", "[aig]" )
   } );
 }
 
-TEST_CASE( "substitute node with dependency in aig_network", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute node with dependency in aig_network", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig{};
+  TestType aig{};
 
   auto const a = aig.create_pi();
   auto const b = aig.create_pi();
@@ -988,9 +1005,9 @@ TEST_CASE( "substitute node with dependency in aig_network", "[aig]" )
   } );
 }
 
-TEST_CASE( "substitute node and re-strash case 2", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute node and re-strash case 2", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
   auto const x1 = aig.create_pi();
   auto const x2 = aig.create_pi();
@@ -1026,9 +1043,9 @@ TEST_CASE( "substitute node and re-strash case 2", "[aig]" )
   CHECK( aig.fanout_size( aig.get_node( n4 ) ) == 1 );
 }
 
-TEST_CASE( "substitute node without re-strashing case 1", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute node without re-strashing case 1", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
   auto const x1 = aig.create_pi();
   auto const x2 = aig.create_pi();
   auto const f1 = aig.create_and( x1, x2 );
@@ -1041,9 +1058,9 @@ TEST_CASE( "substitute node without re-strashing case 1", "[aig]" )
   CHECK( simulate<kitty::static_truth_table<2u>>( aig )[0]._bits == 0x8 );
 }
 
-TEST_CASE( "substitute node without re-strashing case 2", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute node without re-strashing case 2", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
   auto const a = aig.create_pi();
   auto const b = aig.create_pi();
@@ -1063,9 +1080,9 @@ TEST_CASE( "substitute node without re-strashing case 2", "[aig]" )
   CHECK( aig.get_node( aig.po_at( 0 ) ) == aig.pi_at( 0 ) );
 }
 
-TEST_CASE( "substitute node without re-strashing case 3", "[aig]" )
+TEMPLATE_TEST_CASE( "substitute node without re-strashing case 3", "[aig]", aig_network, soa_aig_network, aig_network32 )
 {
-  aig_network aig;
+  TestType aig;
 
   auto const x1 = aig.create_pi();
   auto const x2 = aig.create_pi();
@@ -1081,3 +1098,516 @@ TEST_CASE( "substitute node without re-strashing case 3", "[aig]" )
   CHECK( aig.num_gates() == 2 );
   CHECK( simulate<kitty::static_truth_table<3u>>( aig )[0]._bits == 0x80 );
 }
+
+TEST_CASE( "concurrent structural hashing lookups in aig", "[aig]" )
+{
+  parallel_aig_network aig;
+  CHECK( has_rehash_v<parallel_aig_network> );
+
+  std::vector<parallel_aig_network::signal> pis, gates;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    pis.emplace_back( aig.create_pi() );
+  }
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    for ( auto j = i + 1u; j < 16u; ++j )
+    {
+      gates.emplace_back( ( i + j ) % 2u ? aig.create_and( pis[i], !pis[j] ) : aig.create_and( pis[i], pis[j] ) );
+    }
+  }
+  CHECK( aig.num_gates() == 120u );
+
+  /* read-only lookups from several threads */
+  std::vector<uint32_t> found( 4u, 0u );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < 4u; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      auto k = 0u;
+      for ( auto i = 0u; i < 16u; ++i )
+      {
+        for ( auto j = i + 1u; j < 16u; ++j, ++k )
+        {
+          const auto f = ( i + j ) % 2u ? aig.has_and( !pis[j], pis[i] ) : aig.has_and( pis[j], pis[i] );
+          if ( f && *f == gates[k] && !aig.has_and( !pis[i], !pis[j] ) )
+          {
+            ++found[t];
+          }
+        }
+      }
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+  CHECK( found == std::vector<uint32_t>( 4u, 120u ) );
+
+  /* parallel rebuild yields the same table */
+  CHECK( aig.rehash( 4u ).empty() );
+  CHECK( aig.num_gates() == 120u );
+  auto k = 0u;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    for ( auto j = i + 1u; j < 16u; ++j, ++k )
+    {
+      const auto f = ( i + j ) % 2u ? aig.has_and( pis[i], !pis[j] ) : aig.has_and( pis[i], pis[j] );
+      CHECK( f );
+      CHECK( *f == gates[k] );
+    }
+  }
+}
+
+TEST_CASE( "AIGs with different storage policies", "[aig]" )
+{
+  CHECK( std::is_same_v<parallel_aig_network::base_type, parallel_aig_network> );
+  CHECK( std::is_same_v<cow_aig_network::base_type, cow_aig_network> );
+  CHECK( std::is_same_v<decltype( parallel_aig_network().clone() ), parallel_aig_network> );
+  CHECK( is_aig_network_type_v<parallel_aig_network> );
+  CHECK( is_aig_network_type_v<cow_aig_network> );
+  CHECK( is_aig_network_type_v<soa_aig_network> );
+  CHECK( is_aig_network_type_v<aig_network32> );
+
+  /* all of them share the signal type (and its hash function) */
+  CHECK( std::is_same_v<parallel_aig_network::signal, aig_network::signal> );
+  CHECK( std::is_same_v<cow_aig_network::signal, aig_network::signal> );
+  CHECK( std::is_same_v<soa_aig_network::signal, aig_network::signal> );
+
+  parallel_aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto f = aig.create_and( a, b );
+  std::unordered_set<parallel_aig_network::signal> signals{ a, b, f, !f, f };
+  CHECK( signals.size() == 4u );
+}
+
+TEST_CASE( "copy an AIG into an AIG with structure-of-arrays storage", "[aig]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_xor( a, b );
+  const auto f2 = aig.create_maj( a, b, c );
+  aig.create_po( aig.create_xor( f1, c ) );
+  aig.create_po( f2 );
+
+  const auto soa = cleanup_dangling<aig_network, soa_aig_network>( aig );
+  CHECK( soa.num_pis() == aig.num_pis() );
+  CHECK( soa.num_pos() == aig.num_pos() );
+  CHECK( soa.num_gates() == aig.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<3u>>( soa ) == simulate<kitty::static_truth_table<3u>>( aig ) );
+}
+
+TEST_CASE( "AIGs with 32-bit node indices", "[aig]" )
+{
+  CHECK( sizeof( aig_network32::node ) == 4u );
+  CHECK( sizeof( aig_network32::signal ) == 4u );
+  CHECK( sizeof( aig_network32::storage::element_type::node_type ) == 8u );
+
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  aig.create_po( aig.create_xor( aig.create_xor( a, b ), c ) );
+  aig.create_po( aig.create_maj( a, b, c ) );
+
+  const auto aig32 = cleanup_dangling<aig_network, aig_network32>( aig );
+  CHECK( aig32.num_gates() == aig.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig32 ) == simulate<kitty::static_truth_table<3u>>( aig ) );
+
+  node_map<uint32_t, aig_network32> levels( aig32, 0u );
+  aig32.foreach_gate( [&]( auto const& n ) {
+    static_assert( std::is_same_v<std::decay_t<decltype( n )>, aig_network32::node> );
+    aig32.foreach_fanin( n, [&]( auto const& f ) {
+      levels[n] = std::max( levels[n], levels[f] + 1u );
+    } );
+  } );
+  CHECK( levels[aig32.get_node( aig32.po_at( 0u ) )] == 4u );
+}
+
+TEST_CASE( "parallel rehash with structurally equivalent gates in aig", "[aig]" )
+{
+  parallel_aig_network aig;
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and_no_strash( a, b );
+  const auto f2 = aig.create_and_no_strash( b, a );
+  const auto f3 = aig.create_and_no_strash( f1, c );
+  const auto f4 = aig.create_and_no_strash( f2, c );
+  aig.create_po( f3 );
+  aig.create_po( f4 );
+
+  /* falls back to sequential merging */
+  const auto repr = aig.rehash( 4u );
+  CHECK( repr.size() == aig.size() );
+  CHECK( repr[aig.get_node( f2 )] == f1 );
+  CHECK( repr[aig.get_node( f4 )] == f3 );
+  CHECK( aig.num_gates() == 2u );
+  CHECK( aig.po_at( 0 ) == aig.po_at( 1 ) );
+  CHECK( aig.has_and( b, a ) == f1 );
+}
+
+TEMPLATE_TEST_CASE( "compact an AIG after substitution", "[aig]", aig_network, soa_aig_network, aig_network32 )
+{
+  TestType aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( a, c );
+  const auto f4 = aig.create_and( f2, f3 );
+  aig.create_po( f4 );
+  const auto d = aig.create_pi();
+  const auto f5 = aig.create_and( b, c );
+  const auto f6 = aig.create_and( a, f5 );
+  aig.create_po( !f6 );
+  aig.create_po( d );
+
+  const auto tts = simulate<kitty::static_truth_table<4u>>( aig );
+
+  aig.substitute_node( aig.get_node( f4 ), f6 );
+  CHECK( aig.size() == 11u );
+  CHECK( aig.num_gates() == 2u );
+
+  node_map<typename TestType::node, TestType> old_index( aig );
+  aig.foreach_node( [&]( auto const& n ) {
+    old_index[n] = n;
+  } );
+
+  const auto old_to_new = aig.compact();
+  old_index.compact( old_to_new );
+
+  CHECK( aig.size() == 7u );
+  CHECK( aig.num_gates() == 2u );
+  CHECK( aig.pi_at( 3u ) == 4u );
+  CHECK( old_to_new[aig.get_node( f1 )] >= aig.size() );
+  CHECK( old_to_new[aig.get_node( f4 )] >= aig.size() );
+  CHECK( old_to_new[aig.get_node( f5 )] == 5u );
+  CHECK( old_to_new[aig.get_node( f6 )] == 6u );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( old_to_new[old_index[n]] == n );
+  } );
+  CHECK( aig.fanout_size( 5u ) == 1u );
+  CHECK( aig.fanout_size( 6u ) == 2u );
+  CHECK( aig.has_and( aig.make_signal( aig.pi_at( 1u ) ), aig.make_signal( aig.pi_at( 2u ) ) ) == aig.make_signal( 5u ) );
+  CHECK( simulate<kitty::static_truth_table<4u>>( aig ) == tts );
+}
+
+TEMPLATE_TEST_CASE( "reuse dead nodes in an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
+{
+  TestType aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  aig.create_po( f2 );
+
+  aig.set_node_reuse( true );
+  const auto f3 = aig.create_and( b, c );
+  aig.substitute_node( aig.get_node( f2 ), f3 );
+  CHECK( aig.is_dead( aig.get_node( f1 ) ) );
+  CHECK( aig.size() == 7u );
+
+  /* reuses the index of f1, which is smaller than the index of its fanin f3 */
+  const auto f4 = aig.create_and( a, f3 );
+  aig.create_po( f4 );
+  CHECK( aig.get_node( f4 ) == aig.get_node( f1 ) );
+  CHECK( !aig.is_dead( aig.get_node( f4 ) ) );
+  CHECK( aig.size() == 7u );
+  CHECK( aig.num_gates() == 2u );
+
+  const auto old_to_new = aig.compact();
+  CHECK( aig.size() == 6u );
+  CHECK( old_to_new[aig.get_node( f3 )] == 4u );
+  CHECK( old_to_new[aig.get_node( f4 )] == 5u );
+  CHECK( old_to_new[aig.get_node( f2 )] >= aig.size() );
+
+  const auto tts = simulate<kitty::static_truth_table<3u>>( aig );
+  CHECK( tts[0]._bits == 0xc0 );
+  CHECK( tts[1]._bits == 0x80 );
+
+  /* no dead nodes are left to reuse */
+  aig.create_and( a, c );
+  CHECK( aig.size() == 7u );
+}
+
+TEST_CASE( "clone copy-on-write AIG", "[aig]" )
+{
+  cow_aig_network aig;
+  std::vector<cow_aig_network::signal> fs;
+  for ( auto i = 0u; i < 64u; ++i )
+  {
+    fs.emplace_back( aig.create_pi() );
+  }
+  for ( auto i = 0u; fs.size() < 10000u; ++i )
+  {
+    fs.emplace_back( aig.create_and( fs[i], !fs[i + 1u] ) );
+  }
+  aig.create_po( fs.back() );
+  CHECK( aig.size() == 10001u );
+
+  auto copy = aig.clone();
+  CHECK( copy._storage->nodes.num_shared_pages() == 3u );
+  CHECK( copy._storage->hash.num_shared_shards() == 64u );
+
+  /* read-only accesses do not copy pages */
+  uint32_t num_fanins{ 0u };
+  copy.foreach_gate( [&]( auto const& n ) {
+    copy.foreach_fanin( n, [&]( auto const& f ) {
+      num_fanins += copy.is_pi( copy.get_node( f ) ) ? 1u : 0u;
+    } );
+  } );
+  CHECK( num_fanins == 127u );
+  CHECK( copy.has_and( fs[0], !fs[1] ) == fs[64] );
+  CHECK( copy._storage->nodes.num_shared_pages() == 3u );
+  CHECK( copy._storage->terminal.num_shared_pages() == 3u );
+
+  /* values and visited flags are not stored in the pages */
+  copy.clear_values();
+  copy.clear_visited();
+  copy.foreach_gate( [&]( auto const& n ) {
+    copy.set_value( n, 1u );
+    copy.set_visited( n, copy.trav_id() );
+  } );
+  CHECK( copy._storage->nodes.num_shared_pages() == 3u );
+  CHECK( aig.value( aig.get_node( fs[100] ) ) == 0u );
+
+  /* modifications only copy the page of the new node, since fan-out sizes
+     are not stored in the pages either */
+  const auto g = copy.create_and( fs[100], fs[200] );
+  CHECK( copy.size() == 10002u );
+  CHECK( aig.size() == 10001u );
+  CHECK( copy._storage->nodes.num_shared_pages() == 2u );
+  CHECK( copy._storage->hash.num_shared_shards() == 63u );
+  CHECK( copy.has_and( fs[200], fs[100] ) == g );
+  CHECK( !aig.has_and( fs[200], fs[100] ) );
+  CHECK( aig.fanout_size( aig.get_node( fs[100] ) ) == 2u );
+  CHECK( copy.fanout_size( copy.get_node( fs[100] ) ) == 3u );
+}
+
+TEST_CASE( "snapshot and rollback AIG", "[aig]" )
+{
+  cow_aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  aig.create_po( f2 );
+  const auto tts = simulate<kitty::static_truth_table<3u>>( aig );
+
+  const auto snapshot = aig.snapshot();
+  cow_aig_network alias = aig;
+
+  aig.substitute_node( aig.get_node( f2 ), aig.create_and( a, c ) );
+  CHECK( aig.is_dead( aig.get_node( f1 ) ) );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig ) != tts );
+
+  aig.rollback( snapshot );
+  CHECK( aig.size() == 6u );
+  CHECK( aig.num_gates() == 2u );
+  CHECK( !alias.is_dead( alias.get_node( f1 ) ) );
+  CHECK( aig.has_and( b, a ) == f1 );
+  CHECK( !aig.has_and( a, c ) );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig ) == tts );
+
+  /* the snapshot can be restored again */
+  aig.create_po( aig.create_and( b, c ) );
+  aig.rollback( snapshot );
+  CHECK( aig.num_pos() == 1u );
+  CHECK( aig.size() == 6u );
+}
+
+TEMPLATE_TEST_CASE( "track and restore topological order in an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
+{
+  TestType aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  aig.create_po( f2 );
+  CHECK( aig.is_topo_sorted() );
+  CHECK( aig.restore_topo_order().empty() );
+
+  const auto f3 = aig.create_and( b, c );
+  const auto f4 = aig.create_and( a, f3 );
+  aig.substitute_node( aig.get_node( f1 ), f4 );
+  CHECK( !aig.is_topo_sorted() );
+
+  aig.create_pi();
+  const auto old_to_new = aig.restore_topo_order();
+  CHECK( aig.is_topo_sorted() );
+  CHECK( old_to_new == std::vector<typename TestType::node>{ { 0, 1, 2, 3, 4, 7, 5, 6, 8 } } );
+  CHECK( aig.size() == 9u );
+  CHECK( aig.is_dead( 4u ) );
+  CHECK( aig.pi_at( 3u ) == 8u );
+  CHECK( aig.po_at( 0u ) == aig.make_signal( 7u ) );
+  CHECK( aig.has_and( aig.make_signal( 6u ), c ) == aig.make_signal( 7u ) );
+  CHECK( aig.has_and( c, b ) == aig.make_signal( 5u ) );
+  aig.foreach_gate( [&]( auto const& n ) {
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( aig.get_node( f ) < n );
+    } );
+  } );
+  CHECK( simulate<kitty::static_truth_table<4u>>( aig )[0]._bits == 0x8080 );
+}
+
+TEST_CASE( "batched modification events in an AIG", "[aig]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( f1, !c );
+  aig.create_po( f2 );
+  aig.create_po( f3 );
+
+  std::vector<std::string> log;
+  std::vector<aig_network::signal> previous;
+  auto modified = aig.events().register_modified_event( [&]( auto const& n, auto const& children ) {
+    log.push_back( "m" + std::to_string( n ) );
+    previous = children;
+  } );
+  auto deleted = aig.events().register_delete_event( [&]( auto const& n ) {
+    log.push_back( "d" + std::to_string( n ) );
+  } );
+
+  /* parents are reported before the substituted node is deleted */
+  aig.substitute_node( aig.get_node( f1 ), a );
+  CHECK( log == std::vector<std::string>{ { "m5", "m6", "d4" } } );
+  CHECK( previous == std::vector<aig_network::signal>{ { !c, f1 } } );
+
+  /* a node modified twice is reported once with its original children */
+  log.clear();
+  const auto d = aig.create_pi();
+  aig.events().begin_batch();
+  aig.replace_in_node( 5u, aig.get_node( c ), d );
+  aig.replace_in_node( 5u, aig.get_node( a ), b );
+  CHECK( log.empty() );
+  aig.events().end_batch();
+  CHECK( log == std::vector<std::string>{ { "m5" } } );
+  CHECK( previous == std::vector<aig_network::signal>{ { a, c } } );
+
+  /* pending modifications are delivered before deletions */
+  log.clear();
+  aig.events().begin_batch();
+  aig.events().notify_modified( 6u, { a, !c } );
+  aig.events().notify_modified( 5u, { b, d } );
+  aig.events().notify_delete( 5u );
+  aig.events().end_batch();
+  CHECK( log == std::vector<std::string>{ { "m5", "d5", "m6" } } );
+
+  aig.events().release_modified_event( modified );
+  aig.events().release_delete_event( deleted );
+  CHECK( aig.events().on_modified.empty() );
+  CHECK( aig.events().on_delete.empty() );
+}
+
+TEST_CASE( "modification events while restrashing an AIG", "[aig]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+  const auto g1 = aig.create_and( a, b );
+  const auto g2 = aig.create_and( a, c );
+  const auto h1 = aig.create_and( g1, c );
+  const auto h2 = aig.create_and( g2, c );
+  const auto p = aig.create_and( h2, d );
+  aig.create_po( h1 );
+  aig.create_po( p );
+
+  std::vector<std::string> log;
+  auto modified = aig.events().register_modified_event( [&]( auto const& n, auto const& ) {
+    log.push_back( "m" + std::to_string( n ) );
+  } );
+  auto deleted = aig.events().register_delete_event( [&]( auto const& n ) {
+    log.push_back( "d" + std::to_string( n ) );
+  } );
+
+  /* `h2` becomes equal to `h1` and is substituted in turn; the modification
+     of its parent `p` is reported before `h2` is deleted */
+  aig.substitute_node( aig.get_node( g2 ), g1 );
+  CHECK( log == std::vector<std::string>{ { "d6", "m9", "d8" } } );
+  CHECK( aig.is_dead( aig.get_node( h2 ) ) );
+
+  aig.events().release_modified_event( modified );
+  aig.events().release_delete_event( deleted );
+}
+
+TEMPLATE_TEST_CASE( "fan-out lists in an AIG", "[aig]", aig_network, soa_aig_network, aig_network32 )
+{
+  TestType aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( f1, !a );
+  aig.create_po( f2 );
+  aig.create_po( f3 );
+
+  aig.acquire_fanouts();
+  CHECK( aig.is_tracking_fanouts() );
+
+  const auto fanouts = [&]( typename TestType::node const& n ) {
+    std::vector<typename TestType::node> nodes;
+    aig.foreach_tracked_fanout( n, [&]( auto const& p ) { nodes.push_back( p ); } );
+    return nodes;
+  };
+  const auto check_lists = [&]() {
+    uint32_t num_edges{ 0u };
+    aig.foreach_node( [&]( auto const& n ) {
+      for ( auto const& p : fanouts( n ) )
+      {
+        CHECK( !aig.is_dead( p ) );
+        CHECK( ( aig.get_node( aig._storage->nodes[p].children[0] ) == n || aig.get_node( aig._storage->nodes[p].children[1] ) == n ) );
+        ++num_edges;
+      }
+    } );
+    CHECK( num_edges == 2u * aig.num_gates() );
+  };
+
+  CHECK( fanouts( aig.get_node( a ) ) == std::vector<typename TestType::node>{ { 4, 6 } } );
+  CHECK( fanouts( aig.get_node( f1 ) ) == std::vector<typename TestType::node>{ { 5, 6 } } );
+  CHECK( fanouts( aig.get_node( f3 ) ).empty() );
+
+  const auto f4 = aig.create_and( b, c );
+  CHECK( fanouts( aig.get_node( c ) ) == std::vector<typename TestType::node>{ { 5, 7 } } );
+
+  aig.substitute_node( aig.get_node( f1 ), f4 );
+  CHECK( fanouts( aig.get_node( f4 ) ) == std::vector<typename TestType::node>{ { 5, 6 } } );
+  CHECK( fanouts( aig.get_node( a ) ) == std::vector<typename TestType::node>{ { 6 } } );
+  CHECK( fanouts( aig.get_node( b ) ) == std::vector<typename TestType::node>{ { 7 } } );
+  CHECK( fanouts( aig.get_node( c ) ) == std::vector<typename TestType::node>{ { 7, 5 } } );
+  check_lists();
+
+  /* dead nodes are reused and compaction recomputes the lists */
+  aig.set_node_reuse( true );
+  const auto f5 = aig.create_and( !b, c );
+  CHECK( aig.get_node( f5 ) == 4u );
+  aig.create_po( f5 );
+  check_lists();
+
+  aig.compact();
+  check_lists();
+  CHECK( fanouts( aig.pi_at( 2u ) ) == std::vector<typename TestType::node>{ { 4, 5, 6 } } );
+
+  /* the lists are not copied into clones and dropped with the last user */
+  aig.acquire_fanouts();
+  CHECK( !aig.clone().is_tracking_fanouts() );
+  aig.release_fanouts();
+  CHECK( aig.is_tracking_fanouts() );
+  aig.release_fanouts();
+  CHECK( !aig.is_tracking_fanouts() );
+}
@@ -506,3 +506,41 @@ TEST_CASE( "substitute node by another in a block network", "[block_net]" )
     CHECK( block_net.get_output_pin( f ) == 0 );
   } );
 }
+
+TEST_CASE( "fan-ins and data of a block network in the arenas", "[block_net]" )
+{
+  block_network ntk1;
+
+  const auto a = ntk1.create_pi();
+  const auto b = ntk1.create_pi();
+  const auto c = ntk1.create_pi();
+
+  std::vector<block_network::signal> outputs;
+  for ( auto i = 0u; i < 40000u; ++i )
+  {
+    auto const f = i % 2u == 0u ? ntk1.create_ha( a, b ) : ntk1.create_fa( a, b, c );
+    outputs.push_back( ntk1.next_output_pin( f ) );
+  }
+  for ( auto const& f : outputs )
+  {
+    ntk1.create_po( f );
+  }
+
+  auto ntk2 = ntk1.clone();
+
+  for ( auto i = 0u; i < 40000u; ++i )
+  {
+    auto const n = ntk1.get_node( outputs[i] );
+    CHECK( ntk1.is_multioutput( n ) );
+    CHECK( ntk1.fanin_size( n ) == ( i % 2u == 0u ? 2u : 3u ) );
+    CHECK( ntk1.fanout_size_pin( n, 1 ) == 1u );
+    CHECK( ntk2.fanin_size( n ) == ntk1.fanin_size( n ) );
+    CHECK( ntk2.fanout_size_pin( n, 1 ) == 1u );
+  }
+
+  /* the clone owns its fan-ins and data */
+  ntk2.substitute_node( ntk2.get_node( outputs[0] ), ntk2.get_constant( false ) );
+  CHECK( ntk2.is_dead( ntk2.get_node( outputs[0] ) ) );
+  CHECK( !ntk1.is_dead( ntk1.get_node( outputs[0] ) ) );
+  CHECK( ntk1.fanout_size_pin( ntk1.get_node( outputs[0] ), 1 ) == 1u );
+}
@@ -522,3 +522,36 @@ TEST_CASE( "visited values in cover networks", "[cover]" )
     CHECK( cover.visited( n ) == 0 );
   } );
 }
+
+TEST_CASE( "fan-ins of a cover network in the fan-in arena", "[cover]" )
+{
+  cover_network cover;
+
+  const auto a = cover.create_pi();
+  const auto b = cover.create_pi();
+  const auto c = cover.create_pi();
+
+  std::vector<kitty::cube> _and{ kitty::cube( "11" ) };
+
+  const auto n1 = cover.create_cover_node( { a, b }, std::make_pair( _and, true ) );
+  const auto n2 = cover.create_cover_node( { n1, c }, std::make_pair( _and, true ) );
+  const auto n3 = cover.create_cover_node( { n1, n2 }, std::make_pair( _and, true ) );
+  cover.create_po( n3 );
+
+  /* the copy of the storage owns its fan-ins */
+  cover_storage copy( *cover._storage );
+  cover.substitute_node( n1, a );
+
+  std::vector<cover_network::signal> children;
+  cover.foreach_fanin( n2, [&]( auto const& f ) { children.push_back( f ); } );
+  CHECK( children == std::vector<cover_network::signal>{ a, c } );
+  children.clear();
+  cover.foreach_fanin( n3, [&]( auto const& f ) { children.push_back( f ); } );
+  CHECK( children == std::vector<cover_network::signal>{ a, n2 } );
+  CHECK( cover.fanout_size( n1 ) == 0u );
+  CHECK( cover.fanout_size( a ) == 3u );
+
+  CHECK( copy.nodes[n3].children.size() == 2u );
+  CHECK( copy.nodes[n3].children[0].index == n1 );
+  CHECK( copy.nodes[n3].children[1].index == n2 );
+}
@@ -485,3 +485,75 @@ TEST_CASE( "visited values in k-LUT networks", "[klut]" )
     CHECK( klut.visited( n ) == 0 );
   } );
 }
+
+TEST_CASE( "fan-ins of a k-LUT network in the fan-in arena", "[klut]" )
+{
+  klut_network klut;
+
+  std::vector<klut_network::signal> pis;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    pis.push_back( klut.create_pi() );
+  }
+
+  kitty::dynamic_truth_table tt_and3( 3u );
+  kitty::create_from_hex_string( tt_and3, "80" );
+
+  /* enough fan-ins to fill more than one chunk of the arena */
+  std::vector<klut_network::signal> nodes;
+  for ( auto i = 0u; i < 30000u; ++i )
+  {
+    nodes.push_back( klut.create_node( { pis[i % 8u], pis[( i / 8u ) % 8u], i < 64u ? pis[( i / 64u ) % 8u] : nodes[i - 64u] }, tt_and3 ) );
+  }
+  CHECK( klut.size() == 30010u );
+
+  for ( auto i = 0u; i < 30000u; ++i )
+  {
+    std::vector<klut_network::signal> children;
+    klut.foreach_fanin( nodes[i], [&]( auto const& f ) { children.push_back( f ); } );
+    CHECK( children == std::vector<klut_network::signal>{ pis[i % 8u], pis[( i / 8u ) % 8u], i < 64u ? pis[( i / 64u ) % 8u] : nodes[i - 64u] } );
+  }
+
+  /* the clone owns its fan-ins */
+  auto clone = klut.clone();
+  clone.substitute_node( pis[0], pis[1] );
+  klut.foreach_fanin( nodes[0], [&]( auto const& f, auto i ) {
+    if ( i == 0u )
+    {
+      CHECK( f == pis[0] );
+    }
+  } );
+  clone.foreach_fanin( nodes[0], [&]( auto const& f, auto i ) {
+    if ( i == 0u )
+    {
+      CHECK( f == pis[1] );
+    }
+  } );
+}
+
+TEST_CASE( "structural hashing after substitution in a k-LUT network", "[klut]" )
+{
+  klut_network klut;
+
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+
+  kitty::dynamic_truth_table tt_and( 2u );
+  kitty::create_from_hex_string( tt_and, "8" );
+
+  const auto n1 = klut.create_node( { a, b }, tt_and );
+  const auto n2 = klut.create_node( { n1, c }, tt_and );
+  klut.create_po( n2 );
+
+  klut.substitute_node( n1, a );
+
+  CHECK( klut.size() == 7u );
+  CHECK( klut.create_node( { a, c }, tt_and ) == n2 );
+  CHECK( klut.create_node( { a, b }, tt_and ) == n1 );
+  CHECK( klut.size() == 7u );
+
+  auto clone = klut.clone();
+  CHECK( clone.create_node( { a, c }, tt_and ) == n2 );
+  CHECK( clone.size() == 7u );
+}
@@ -1,6 +1,9 @@
 #include <catch.hpp>
 
 #include <algorithm>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 #include <kitty/algorithm.hpp>
@@ -13,25 +16,34 @@
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/traits.hpp>
+#include <mockturtle/utils/node_map.hpp>
+
+namespace mockturtle
+{
+/* the network classes can be forward declared */
+class xag_network;
+class parallel_xag_network;
+class soa_xag_network;
+} // namespace mockturtle
 
 using namespace mockturtle;
 
-TEST_CASE( "create and use constants in an xag", "[xag]" )
+TEMPLATE_TEST_CASE( "create and use constants in an xag", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
   CHECK( xag.size() == 1 );
-  CHECK( has_get_constant_v<xag_network> );
-  CHECK( has_is_constant_v<xag_network> );
-  CHECK( has_get_node_v<xag_network> );
-  CHECK( has_is_complemented_v<xag_network> );
+  CHECK( has_get_constant_v<TestType> );
+  CHECK( has_is_constant_v<TestType> );
+  CHECK( has_get_node_v<TestType> );
+  CHECK( has_is_complemented_v<TestType> );
 
   const auto c0 = xag.get_constant( false );
   CHECK( xag.is_constant( xag.get_node( c0 ) ) );
   CHECK( !xag.is_pi( xag.get_node( c0 ) ) );
 
   CHECK( xag.size() == 1 );
-  CHECK( std::is_same_v<std::decay_t<decltype( c0 )>, xag_network::signal> );
+  CHECK( std::is_same_v<std::decay_t<decltype( c0 )>, typename TestType::signal> );
   CHECK( xag.get_node( c0 ) == 0 );
   CHECK( !xag.is_complemented( c0 ) );
 
@@ -50,9 +62,9 @@ TEST_CASE( "create and use constants in an xag", "[xag]" )
   CHECK( c0 == +c0 );
 }
 
-TEST_CASE( "special cases in XAGs", "[xag]" )
+TEMPLATE_TEST_CASE( "special cases in XAGs", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
   auto x = xag.create_pi();
 
   CHECK( xag.create_xor( xag.get_constant( false ), xag.get_constant( false ) ) == xag.get_constant( false ) );
@@ -86,11 +98,11 @@ TEST_CASE( "special cases in XAGs", "[xag]" )
   CHECK( xag.create_and( !x, !x ) == !x );
 }
 
-TEST_CASE( "create and use primary inputs in an xag", "[xag]" )
+TEMPLATE_TEST_CASE( "create and use primary inputs in an xag", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
-  CHECK( has_create_pi_v<xag_network> );
+  CHECK( has_create_pi_v<TestType> );
 
   auto a = xag.create_pi();
   auto b = xag.create_pi();
@@ -103,7 +115,7 @@ TEST_CASE( "create and use primary inputs in an xag", "[xag]" )
   CHECK( xag.pi_index( xag.get_node( a ) ) == 0 );
   CHECK( xag.pi_index( xag.get_node( b ) ) == 1 );
 
-  CHECK( std::is_same_v<std::decay_t<decltype( a )>, xag_network::signal> );
+  CHECK( std::is_same_v<std::decay_t<decltype( a )>, typename TestType::signal> );
 
   CHECK( a.index == 1 );
   CHECK( a.complement == 0 );
@@ -144,11 +156,11 @@ TEST_CASE( "create and use primary inputs in an xag", "[xag]" )
   CHECK( a.complement == 1 );
 }
 
-TEST_CASE( "create and use primary outputs in an xag", "[xag]" )
+TEMPLATE_TEST_CASE( "create and use primary outputs in an xag", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
-  CHECK( has_create_po_v<xag_network> );
+  CHECK( has_create_po_v<TestType> );
 
   const auto c0 = xag.get_constant( false );
   const auto x1 = xag.create_pi();
@@ -180,12 +192,12 @@ TEST_CASE( "create and use primary outputs in an xag", "[xag]" )
   } );
 }
 
-TEST_CASE( "create unary operations in an xag", "[xag]" )
+TEMPLATE_TEST_CASE( "create unary operations in an xag", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
-  CHECK( has_create_buf_v<xag_network> );
-  CHECK( has_create_not_v<xag_network> );
+  CHECK( has_create_buf_v<TestType> );
+  CHECK( has_create_not_v<TestType> );
 
   auto x1 = xag.create_pi();
 
@@ -199,16 +211,16 @@ TEST_CASE( "create unary operations in an xag", "[xag]" )
   CHECK( f2 == !x1 );
 }
 
-TEST_CASE( "create binary operations in an xag", "[xag]" )
+TEMPLATE_TEST_CASE( "create binary operations in an xag", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
-  CHECK( has_create_and_v<xag_network> );
-  CHECK( has_create_nand_v<xag_network> );
-  CHECK( has_create_or_v<xag_network> );
-  CHECK( has_create_nor_v<xag_network> );
-  CHECK( has_create_xor_v<xag_network> );
-  CHECK( has_create_xnor_v<xag_network> );
+  CHECK( has_create_and_v<TestType> );
+  CHECK( has_create_nand_v<TestType> );
+  CHECK( has_create_or_v<TestType> );
+  CHECK( has_create_nor_v<TestType> );
+  CHECK( has_create_xor_v<TestType> );
+  CHECK( has_create_xnor_v<TestType> );
 
   const auto x1 = xag.create_pi();
   const auto x2 = xag.create_pi();
@@ -237,9 +249,9 @@ TEST_CASE( "create binary operations in an xag", "[xag]" )
   CHECK( f5 == !f6 );
 }
 
-TEST_CASE( "hash nodes in xag network", "[xag]" )
+TEMPLATE_TEST_CASE( "hash nodes in xag network", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
   auto a = xag.create_pi();
   auto b = xag.create_pi();
@@ -253,11 +265,11 @@ TEST_CASE( "hash nodes in xag network", "[xag]" )
   CHECK( xag.get_node( f ) == xag.get_node( g ) );
 }
 
-TEST_CASE( "clone a XAG network", "[xag]" )
+TEMPLATE_TEST_CASE( "clone a XAG network", "[xag]", xag_network, soa_xag_network )
 {
-  CHECK( has_clone_v<xag_network> );
+  CHECK( has_clone_v<TestType> );
 
-  xag_network xag0;
+  TestType xag0;
   auto a = xag0.create_pi();
   auto b = xag0.create_pi();
   auto f0 = xag0.create_and( a, b );
@@ -276,11 +288,11 @@ TEST_CASE( "clone a XAG network", "[xag]" )
   CHECK( xag_clone.num_gates() == 1 );
 }
 
-TEST_CASE( "clone a node in xag network", "[xag]" )
+TEMPLATE_TEST_CASE( "clone a node in xag network", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag1, xag2;
+  TestType xag1, xag2;
 
-  CHECK( has_clone_node_v<xag_network> );
+  CHECK( has_clone_node_v<TestType> );
 
   auto a1 = xag1.create_pi();
   auto b1 = xag1.create_pi();
@@ -299,16 +311,16 @@ TEST_CASE( "clone a node in xag network", "[xag]" )
   } );
 }
 
-TEST_CASE( "structural properties of an xag", "[xag]" )
+TEMPLATE_TEST_CASE( "structural properties of an xag", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
-  CHECK( has_size_v<xag_network> );
-  CHECK( has_num_pis_v<xag_network> );
-  CHECK( has_num_pos_v<xag_network> );
-  CHECK( has_num_gates_v<xag_network> );
-  CHECK( has_fanin_size_v<xag_network> );
-  CHECK( has_fanout_size_v<xag_network> );
+  CHECK( has_size_v<TestType> );
+  CHECK( has_num_pis_v<TestType> );
+  CHECK( has_num_pos_v<TestType> );
+  CHECK( has_num_gates_v<TestType> );
+  CHECK( has_fanin_size_v<TestType> );
+  CHECK( has_fanout_size_v<TestType> );
 
   const auto x1 = xag.create_pi();
   const auto x2 = xag.create_pi();
@@ -335,15 +347,15 @@ TEST_CASE( "structural properties of an xag", "[xag]" )
   CHECK( xag.fanout_size( xag.get_node( f2 ) ) == 1 );
 }
 
-TEST_CASE( "node and signal iteration in an xag", "[xag]" )
+TEMPLATE_TEST_CASE( "node and signal iteration in an xag", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
-  CHECK( has_foreach_node_v<xag_network> );
-  CHECK( has_foreach_pi_v<xag_network> );
-  CHECK( has_foreach_po_v<xag_network> );
-  CHECK( has_foreach_gate_v<xag_network> );
-  CHECK( has_foreach_fanin_v<xag_network> );
+  CHECK( has_foreach_node_v<TestType> );
+  CHECK( has_foreach_pi_v<TestType> );
+  CHECK( has_foreach_po_v<TestType> );
+  CHECK( has_foreach_gate_v<TestType> );
+  CHECK( has_foreach_fanin_v<TestType> );
 
   const auto x1 = xag.create_pi();
   const auto x2 = xag.create_pi();
@@ -450,14 +462,14 @@ TEST_CASE( "node and signal iteration in an xag", "[xag]" )
   CHECK( mask == 2 );
 }
 
-TEST_CASE( "compute values in XAGs", "[xag]" )
+TEMPLATE_TEST_CASE( "compute values in XAGs", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
-  CHECK( has_compute_v<xag_network, bool> );
-  CHECK( has_compute_v<xag_network, kitty::dynamic_truth_table> );
-  CHECK( has_compute_v<xag_network, kitty::partial_truth_table> );
-  CHECK( has_compute_inplace_v<xag_network, kitty::partial_truth_table> );
+  CHECK( has_compute_v<TestType, bool> );
+  CHECK( has_compute_v<TestType, kitty::dynamic_truth_table> );
+  CHECK( has_compute_v<TestType, kitty::partial_truth_table> );
+  CHECK( has_compute_inplace_v<TestType, kitty::partial_truth_table> );
 
   const auto x1 = xag.create_pi();
   const auto x2 = xag.create_pi();
@@ -551,15 +563,15 @@ TEST_CASE( "compute values in XAGs", "[xag]" )
   }
 }
 
-TEST_CASE( "custom node values in xags", "[xag]" )
+TEMPLATE_TEST_CASE( "custom node values in xags", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
-  CHECK( has_clear_values_v<xag_network> );
-  CHECK( has_value_v<xag_network> );
-  CHECK( has_set_value_v<xag_network> );
-  CHECK( has_incr_value_v<xag_network> );
-  CHECK( has_decr_value_v<xag_network> );
+  CHECK( has_clear_values_v<TestType> );
+  CHECK( has_value_v<TestType> );
+  CHECK( has_set_value_v<TestType> );
+  CHECK( has_incr_value_v<TestType> );
+  CHECK( has_decr_value_v<TestType> );
 
   const auto x1 = xag.create_pi();
   const auto x2 = xag.create_pi();
@@ -586,13 +598,13 @@ TEST_CASE( "custom node values in xags", "[xag]" )
   } );
 }
 
-TEST_CASE( "visited values in xags", "[xag]" )
+TEMPLATE_TEST_CASE( "visited values in xags", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
-  CHECK( has_clear_visited_v<xag_network> );
-  CHECK( has_visited_v<xag_network> );
-  CHECK( has_set_visited_v<xag_network> );
+  CHECK( has_clear_visited_v<TestType> );
+  CHECK( has_visited_v<TestType> );
+  CHECK( has_set_visited_v<TestType> );
 
   const auto x1 = xag.create_pi();
   const auto x2 = xag.create_pi();
@@ -615,9 +627,9 @@ TEST_CASE( "visited values in xags", "[xag]" )
   } );
 }
 
-TEST_CASE( "check has_and and has_xor in XAG", "[xag]" )
+TEMPLATE_TEST_CASE( "check has_and and has_xor in XAG", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
   auto const x1 = xag.create_pi();
   auto const x2 = xag.create_pi();
   auto const x3 = xag.create_pi();
@@ -647,9 +659,9 @@ TEST_CASE( "check has_and and has_xor in XAG", "[xag]" )
   CHECK( *xag.has_and( !n7, !n5 ) == n8 );
 }
 
-TEST_CASE( "simulate some special functions in XAGs", "[xag]" )
+TEMPLATE_TEST_CASE( "simulate some special functions in XAGs", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
   const auto x1 = xag.create_pi();
   const auto x2 = xag.create_pi();
   const auto x3 = xag.create_pi();
@@ -668,10 +680,10 @@ TEST_CASE( "simulate some special functions in XAGs", "[xag]" )
   CHECK( result[1]._bits[0] == 0xd8u );
 }
 
-TEST_CASE( "create nary functions in XAGs", "[xag]" )
+TEMPLATE_TEST_CASE( "create nary functions in XAGs", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
-  std::vector<xag_network::signal> pis( 8u );
+  TestType xag;
+  std::vector<typename TestType::signal> pis( 8u );
   std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
   xag.create_po( xag.create_nary_and( pis ) );
   xag.create_po( xag.create_nary_or( pis ) );
@@ -692,9 +704,9 @@ TEST_CASE( "create nary functions in XAGs", "[xag]" )
   CHECK( result[2] == copy );
 }
 
-TEST_CASE( "invoke take_out_node two times on the same node in XAG", "[xag]" )
+TEMPLATE_TEST_CASE( "invoke take_out_node two times on the same node in XAG", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
   const auto x1 = xag.create_pi();
   const auto x2 = xag.create_pi();
 
@@ -720,9 +732,9 @@ TEST_CASE( "invoke take_out_node two times on the same node in XAG", "[xag]" )
   CHECK( xag.fanout_size( xag.get_node( x2 ) ) == 1u );
 }
 
-TEST_CASE( "substitute node and restrash in XAG", "[xag]" )
+TEMPLATE_TEST_CASE( "substitute node and restrash in XAG", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
   auto const x1 = xag.create_pi();
   auto const x2 = xag.create_pi();
 
@@ -753,9 +765,9 @@ TEST_CASE( "substitute node and restrash in XAG", "[xag]" )
   CHECK( xag.fanout_size( xag.get_node( f2 ) ) == 1 );
 }
 
-TEST_CASE( "trivial case (constant) detection in replace_in_node of xag_network", "[xag]" )
+TEMPLATE_TEST_CASE( "trivial case (constant) detection in replace_in_node of xag_network", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
   auto const x1 = xag.create_pi();
   auto const x2 = xag.create_pi();
 
@@ -778,9 +790,9 @@ TEST_CASE( "trivial case (constant) detection in replace_in_node of xag_network"
   CHECK( xag.get_node( xag.po_at( 1 ) ) == xag.get_node( x2 ) );
 }
 
-TEST_CASE( "substitute node with complemented node in xag_network", "[xag]" )
+TEMPLATE_TEST_CASE( "substitute node with complemented node in xag_network", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
   auto const x1 = xag.create_pi();
   auto const x2 = xag.create_pi();
 
@@ -805,9 +817,9 @@ TEST_CASE( "substitute node with complemented node in xag_network", "[xag]" )
   CHECK( simulate<kitty::static_truth_table<2u>>( xag )[0]._bits == 0x7 );
 }
 
-TEST_CASE( "substitute node with dependency in xag_network", "[xag]" )
+TEMPLATE_TEST_CASE( "substitute node with dependency in xag_network", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag{};
+  TestType xag{};
 
   auto const a = xag.create_pi();
   auto const b = xag.create_pi();
@@ -845,9 +857,9 @@ TEST_CASE( "substitute node with dependency in xag_network", "[xag]" )
   } );
 }
 
-TEST_CASE( "substitute node without re-strashing case 1 in xag_network", "[xag]" )
+TEMPLATE_TEST_CASE( "substitute node without re-strashing case 1 in xag_network", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
   auto const x1 = xag.create_pi();
   auto const x2 = xag.create_pi();
   auto const f1 = xag.create_and( x1, x2 );
@@ -860,9 +872,9 @@ TEST_CASE( "substitute node without re-strashing case 1 in xag_network", "[xag]"
   CHECK( simulate<kitty::static_truth_table<2u>>( xag )[0]._bits == 0x8 );
 }
 
-TEST_CASE( "substitute node without re-strashing case 2 in xag_network", "[xag]" )
+TEMPLATE_TEST_CASE( "substitute node without re-strashing case 2 in xag_network", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
   auto const a = xag.create_pi();
   auto const b = xag.create_pi();
@@ -882,9 +894,9 @@ TEST_CASE( "substitute node without re-strashing case 2 in xag_network", "[xag]"
   CHECK( xag.get_node( xag.po_at( 0 ) ) == xag.pi_at( 0 ) );
 }
 
-TEST_CASE( "substitute node without re-strashing case 3 in xag_network", "[xag]" )
+TEMPLATE_TEST_CASE( "substitute node without re-strashing case 3 in xag_network", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
 
   auto const x1 = xag.create_pi();
   auto const x2 = xag.create_pi();
@@ -901,9 +913,9 @@ TEST_CASE( "substitute node without re-strashing case 3 in xag_network", "[xag]"
   CHECK( simulate<kitty::static_truth_table<3u>>( xag )[0]._bits == 0x80 );
 }
 
-TEST_CASE( "substitute node without re-strashing case 4 in xag_network", "[xag]" )
+TEMPLATE_TEST_CASE( "substitute node without re-strashing case 4 in xag_network", "[xag]", xag_network, soa_xag_network )
 {
-  xag_network xag;
+  TestType xag;
   auto const x1 = xag.create_pi();
   auto const x2 = xag.create_pi();
   auto const f1 = xag.create_xor( x1, x2 );
@@ -915,3 +927,189 @@ TEST_CASE( "substitute node without re-strashing case 4 in xag_network", "[xag]"
   CHECK( xag.num_gates() == 1 );
   CHECK( simulate<kitty::static_truth_table<2u>>( xag )[0]._bits == 0x6 );
 }
+
+TEST_CASE( "concurrent structural hashing lookups in xag", "[xag]" )
+{
+  parallel_xag_network xag;
+  CHECK( has_rehash_v<parallel_xag_network> );
+
+  std::vector<parallel_xag_network::signal> pis, gates;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    pis.emplace_back( xag.create_pi() );
+  }
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    for ( auto j = i + 1u; j < 16u; ++j )
+    {
+      gates.emplace_back( ( i + j ) % 2u ? xag.create_and( pis[i], !pis[j] ) : xag.create_xor( pis[i], pis[j] ) );
+    }
+  }
+  CHECK( xag.num_gates() == 120u );
+
+  /* read-only lookups from several threads */
+  std::vector<uint32_t> found( 4u, 0u );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < 4u; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      auto k = 0u;
+      for ( auto i = 0u; i < 16u; ++i )
+      {
+        for ( auto j = i + 1u; j < 16u; ++j, ++k )
+        {
+          const auto f = ( i + j ) % 2u ? xag.has_and( !pis[j], pis[i] ) : xag.has_xor( pis[j], pis[i] );
+          if ( f && *f == gates[k] && !xag.has_and( !pis[i], !pis[j] ) )
+          {
+            ++found[t];
+          }
+        }
+      }
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+  CHECK( found == std::vector<uint32_t>( 4u, 120u ) );
+
+  /* parallel rebuild yields the same table */
+  CHECK( xag.rehash( 4u ).empty() );
+  CHECK( xag.num_gates() == 120u );
+  auto k = 0u;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    for ( auto j = i + 1u; j < 16u; ++j, ++k )
+    {
+      const auto f = ( i + j ) % 2u ? xag.has_and( pis[i], !pis[j] ) : xag.has_xor( pis[i], pis[j] );
+      CHECK( f );
+      CHECK( *f == gates[k] );
+    }
+  }
+}
+
+TEST_CASE( "XAGs with different storage policies", "[xag]" )
+{
+  CHECK( std::is_same_v<parallel_xag_network::base_type, parallel_xag_network> );
+  CHECK( std::is_same_v<decltype( parallel_xag_network().clone() ), parallel_xag_network> );
+  CHECK( is_xag_network_type_v<xag_network> );
+  CHECK( is_xag_network_type_v<parallel_xag_network> );
+  CHECK( !is_aig_network_type_v<parallel_xag_network> );
+
+  /* all of them share the signal type (and its hash function) */
+  CHECK( std::is_same_v<parallel_xag_network::signal, xag_network::signal> );
+
+  parallel_xag_network xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto f = xag.create_xor( a, b );
+  std::unordered_set<parallel_xag_network::signal> signals{ a, b, f, !f, f };
+  CHECK( signals.size() == 4u );
+}
+
+TEST_CASE( "parallel rehash with structurally equivalent gates in xag", "[xag]" )
+{
+  parallel_xag_network xag;
+
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+  const auto f1 = xag.create_and_no_strash( a, b );
+  const auto f2 = xag.create_and_no_strash( b, a );
+  const auto f3 = xag.create_and_no_strash( f1, c );
+  const auto f4 = xag.create_and_no_strash( f2, c );
+  xag.create_po( f3 );
+  xag.create_po( f4 );
+
+  /* falls back to sequential merging */
+  const auto repr = xag.rehash( 4u );
+  CHECK( repr.size() == xag.size() );
+  CHECK( repr[xag.get_node( f2 )] == f1 );
+  CHECK( repr[xag.get_node( f4 )] == f3 );
+  CHECK( xag.num_gates() == 2u );
+  CHECK( xag.po_at( 0 ) == xag.po_at( 1 ) );
+  CHECK( xag.has_and( b, a ) == f1 );
+}
+
+TEMPLATE_TEST_CASE( "compact an XAG with reused dead nodes", "[xag]", xag_network, soa_xag_network )
+{
+  TestType xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+  const auto f1 = xag.create_and( a, b );
+  const auto f2 = xag.create_and( f1, c );
+  const auto f3 = xag.create_and( a, c );
+  xag.create_po( f2 );
+  const auto y = xag.create_and( b, c );
+  const auto x = xag.create_and( a, !c );
+
+  xag.set_node_reuse( true );
+  xag.substitute_node( xag.get_node( f2 ), y );
+  CHECK( xag.size() == 9u );
+
+  /* both gates are placed at indices of dead nodes */
+  const auto p = xag.create_and( x, b );
+  const auto h = xag.create_xor( x, y );
+  CHECK( xag.size() == 9u );
+  CHECK( xag.get_node( p ) < xag.get_node( x ) );
+  CHECK( xag.get_node( h ) < xag.get_node( x ) );
+  CHECK( xag.is_xor( xag.get_node( h ) ) );
+  xag.create_po( p );
+  xag.create_po( h );
+  xag.create_po( f3 );
+
+  node_map<uint32_t, TestType> fanouts( xag );
+  xag.foreach_node( [&]( auto const& n ) {
+    fanouts[n] = xag.fanout_size( n );
+  } );
+
+  const auto old_to_new = xag.compact();
+  fanouts.compact( old_to_new );
+  CHECK( xag.size() == 9u );
+  CHECK( xag.num_gates() == 5u );
+  CHECK( old_to_new[xag.get_node( x )] == 4u );
+  CHECK( old_to_new[xag.get_node( p )] == 5u );
+  CHECK( old_to_new[xag.get_node( y )] == 6u );
+  CHECK( old_to_new[xag.get_node( h )] == 7u );
+  CHECK( old_to_new[xag.get_node( f3 )] == 8u );
+
+  /* the gate type is kept although the order of the fanins changed */
+  CHECK( xag.is_and( 5u ) );
+  CHECK( xag.is_and( 6u ) );
+  CHECK( xag.is_xor( 7u ) );
+  xag.foreach_node( [&]( auto const& n ) {
+    CHECK( fanouts[n] == xag.fanout_size( n ) );
+  } );
+  CHECK( xag.has_xor( xag.make_signal( 6u ), xag.make_signal( 4u ) ) == xag.make_signal( 7u ) );
+
+  const auto tts = simulate<kitty::static_truth_table<3u>>( xag );
+  CHECK( tts[0]._bits == 0xc0 );
+  CHECK( tts[1]._bits == 0x08 );
+  CHECK( tts[2]._bits == 0xca );
+  CHECK( tts[3]._bits == 0xa0 );
+}
+
+TEMPLATE_TEST_CASE( "track and restore topological order in an XAG", "[xag]", xag_network, soa_xag_network )
+{
+  TestType xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+  const auto f1 = xag.create_and( a, b );
+  const auto f2 = xag.create_xor( f1, c );
+  xag.create_po( f2 );
+
+  const auto f3 = xag.create_and( b, c );
+  xag.substitute_node( xag.get_node( f1 ), f3 );
+  CHECK( !xag.is_topo_sorted() );
+
+  const auto old_to_new = xag.restore_topo_order();
+  CHECK( xag.is_topo_sorted() );
+  CHECK( old_to_new[xag.get_node( f2 )] == 6u );
+  CHECK( old_to_new[xag.get_node( f3 )] == 5u );
+  CHECK( xag.is_and( 5u ) );
+  CHECK( xag.is_xor( 6u ) );
+  CHECK( xag.has_xor( xag.make_signal( 5u ), c ) == xag.make_signal( 6u ) );
+  CHECK( simulate<kitty::static_truth_table<3u>>( xag )[0]._bits == 0x30 );
+}
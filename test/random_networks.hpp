@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+namespace mockturtle
+{
+
+/* Creates `num_gates` gates with `create_gate( ntk, rng, pick )`, where `pick()`
+   returns a random, possibly complemented signal among the constant, the PIs,
+   and the previous gates.  The last `num_pos` signals are POs, every other one
+   complemented. */
+template<class Ntk, class Fn>
+Ntk random_network( uint32_t num_pis, uint32_t num_gates, Fn&& create_gate, uint32_t seed = 1u, uint32_t num_pos = 8u )
+{
+  Ntk ntk;
+  std::mt19937 rng( seed );
+  std::vector<typename Ntk::signal> fs{ ntk.get_constant( false ) };
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    fs.push_back( ntk.create_pi() );
+  }
+  for ( auto i = 0u; i < num_gates; ++i )
+  {
+    auto const pick = [&]() {
+      auto const f = fs[rng() % fs.size()];
+      return ( rng() & 1u ) ? ntk.create_not( f ) : f;
+    };
+    fs.push_back( create_gate( ntk, rng, pick ) );
+  }
+  for ( auto i = 0u; i < num_pos && i < fs.size(); ++i )
+  {
+    auto const f = fs[fs.size() - 1u - i];
+    ntk.create_po( ( i & 1u ) ? ntk.create_not( f ) : f );
+  }
+  return ntk;
+}
+
+inline aig_network random_aig( uint32_t num_pis, uint32_t num_gates, uint32_t seed = 1u )
+{
+  return random_network<aig_network>(
+      num_pis, num_gates, []( auto& ntk, auto&, auto&& pick ) {
+        return ntk.create_and( pick(), pick() );
+      },
+      seed );
+}
+
+/* one XOR for every two ANDs */
+inline xag_network random_xag( uint32_t num_pis, uint32_t num_gates, uint32_t seed = 1u )
+{
+  return random_network<xag_network>(
+      num_pis, num_gates, []( auto& ntk, auto& rng, auto&& pick ) {
+        return ( rng() % 3u ) ? ntk.create_and( pick(), pick() ) : ntk.create_xor( pick(), pick() );
+      },
+      seed );
+}
+
+inline mig_network random_mig( uint32_t num_pis, uint32_t num_gates, uint32_t seed = 1u )
+{
+  return random_network<mig_network>(
+      num_pis, num_gates, []( auto& ntk, auto&, auto&& pick ) {
+        return ntk.create_maj( pick(), pick(), pick() );
+      },
+      seed );
+}
+
+/* one XOR3 for every two MAJs */
+inline xmg_network random_xmg( uint32_t num_pis, uint32_t num_gates, uint32_t seed = 1u )
+{
+  return random_network<xmg_network>(
+      num_pis, num_gates, []( auto& ntk, auto& rng, auto&& pick ) {
+        return ( rng() % 3u ) ? ntk.create_maj( pick(), pick(), pick() ) : ntk.create_xor3( pick(), pick(), pick() );
+      },
+      seed );
+}
+
+/* LUTs with 1 to `max_fanin` fanins and random functions */
+inline klut_network random_klut( uint32_t num_pis, uint32_t num_gates, uint32_t max_fanin, uint32_t seed = 1u )
+{
+  return random_network<klut_network>(
+      num_pis, num_gates, [max_fanin]( auto& ntk, auto& rng, auto&& pick ) {
+        auto const k = 1u + rng() % max_fanin;
+        std::vector<klut_network::signal> children;
+        for ( auto i = 0u; i < k; ++i )
+        {
+          children.push_back( pick() );
+        }
+        kitty::dynamic_truth_table function( k );
+        kitty::create_random( function, rng() );
+        return ntk.create_node( children, function );
+      },
+      seed );
+}
+
+} // namespace mockturtle
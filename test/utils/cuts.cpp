@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <random>
 #include <vector>
 
 #include <mockturtle/utils/cuts.hpp>
@@ -188,3 +189,69 @@ TEST_CASE( "merge three cuts", "[cuts]" )
   ct.merge( c3, cr, 10 );
   CHECK( std::vector<uint32_t>( cr.begin(), cr.end() ) == std::vector{ 1u, 2u, 3u, 4u, 5u, 6u, 7u, 9u } );
 }
+
+TEST_CASE( "packed cuts", "[cuts]" )
+{
+  using cut_type = packed_cut<uint32_t>;
+  static_assert( std::is_same_v<fixed_cut_t<6, uint32_t>, cut_type> );
+  static_assert( std::is_same_v<fixed_cut_t<10, uint32_t>, cut<10, uint32_t>> );
+
+  cut_type c1, c2, c3, cr;
+  c1.set_leaves( std::vector{ 2u, 4u, 6u } );
+  c2.set_leaves( std::vector{ 3u, 5u, 7u } );
+  c3.set_leaves( std::vector{ 1u, 2u, 4u, 6u, 9u } );
+  c1.data() = 42u;
+
+  CHECK( c1.size() == 3u );
+  CHECK( c1.data() == 42u );
+  CHECK( c1.signature() == 0x54u );
+  CHECK( c1.dominates( c3 ) );
+  CHECK( !c3.dominates( c1 ) );
+  CHECK( !c1.dominates( c2 ) );
+
+  CHECK( c1.merge( c2, cr, 8 ) );
+  CHECK( std::vector<uint32_t>( cr.begin(), cr.end() ) == std::vector{ 2u, 3u, 4u, 5u, 6u, 7u } );
+  CHECK( c1.merge( c3, cr, 5 ) );
+  CHECK( std::vector<uint32_t>( cr.begin(), cr.end() ) == std::vector{ 1u, 2u, 4u, 6u, 9u } );
+  CHECK( !c2.merge( c3, cr, 7 ) );
+  CHECK( c2.merge( c3, cr, 16 ) );
+  CHECK( cr.size() == 8u );
+}
+
+TEST_CASE( "packed cuts behave like cuts", "[cuts]" )
+{
+  std::mt19937 rng( 42 );
+  std::vector<packed_cut<>> packed( 2u );
+  std::vector<cut<8>> plain( 2u );
+
+  for ( auto t = 0u; t < 1000u; ++t )
+  {
+    for ( auto i = 0u; i < 2u; ++i )
+    {
+      std::vector<uint32_t> leaves;
+      for ( auto leaf = 0u; leaf < 12u; ++leaf )
+      {
+        if ( leaves.size() < 8u && rng() % 3u == 0u )
+        {
+          leaves.push_back( leaf * 50u );
+        }
+      }
+      packed[i].set_leaves( leaves );
+      plain[i].set_leaves( leaves );
+    }
+
+    CHECK( packed[0].dominates( packed[1] ) == plain[0].dominates( plain[1] ) );
+    CHECK( packed[1].dominates( packed[0] ) == plain[1].dominates( plain[0] ) );
+
+    auto const cut_size = 4u + rng() % 5u;
+    packed_cut<> packed_res;
+    cut<8> plain_res;
+    auto const merged = packed[0].merge( packed[1], packed_res, cut_size );
+    CHECK( merged == plain[0].merge( plain[1], plain_res, cut_size ) );
+    if ( merged )
+    {
+      CHECK( std::equal( packed_res.begin(), packed_res.end(), plain_res.begin(), plain_res.end() ) );
+      CHECK( packed_res.signature() == plain_res.signature() );
+    }
+  }
+}
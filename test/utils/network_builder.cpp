@@ -0,0 +1,158 @@
+#include <catch.hpp>
+
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/network_builder.hpp>
+
+#include <vector>
+
+using namespace mockturtle;
+
+TEST_CASE( "build an AIG without structural hashing", "[network_builder]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> pis;
+  {
+    network_builder builder( aig, 10u );
+    CHECK( builder.is_bulk() );
+
+    pis.push_back( builder.create_pi() );
+    pis.push_back( builder.create_pi() );
+    pis.push_back( builder.create_pi() );
+
+    const auto f1 = builder.create_and( pis[0], pis[1] );
+    const auto f2 = builder.create_and( pis[1], pis[0] );
+    CHECK( f1 != f2 );
+    CHECK( builder.create_and( pis[0], !pis[0] ) == aig.get_constant( false ) );
+    CHECK( builder.create_and( pis[0], aig.get_constant( true ) ) == pis[0] );
+
+    const auto f3 = builder.create_and( f1, pis[2] );
+    const auto f4 = builder.create_and( pis[2], f2 );
+    const auto f5 = builder.create_and( f3, !f4 );
+    builder.create_po( f3 );
+    builder.create_po( f4 );
+    builder.create_po( f5 );
+    CHECK( aig.size() == 9u );
+    CHECK( aig.num_gates() == 5u );
+
+    builder.finalize();
+    CHECK( builder.resolve( f2 ) == f1 );
+    CHECK( builder.resolve( !f4 ) == !builder.resolve( f3 ) );
+    CHECK( builder.resolve( f5 ) == aig.get_constant( false ) );
+  }
+
+  /* merged gates are removed */
+  CHECK( aig.num_gates() == 2u );
+  CHECK( aig.size() == 6u );
+  CHECK( aig.fanout_size( aig.get_node( pis[0] ) ) == 1u );
+  CHECK( aig.fanout_size( aig.get_node( pis[1] ) ) == 1u );
+
+  std::vector<aig_network::signal> pos;
+  aig.foreach_po( [&]( auto const& f ) { pos.push_back( f ); } );
+  CHECK( pos[0] == pos[1] );
+  CHECK( pos[2] == aig.get_constant( false ) );
+  CHECK( aig.fanout_size( aig.get_node( pos[0] ) ) == 2u );
+
+  /* the structural hash table is valid after finalization */
+  CHECK( aig.has_and( pis[1], pis[0] ).has_value() );
+  aig.create_and( pis[0], pis[1] );
+  CHECK( aig.num_gates() == 2u );
+  CHECK( aig.size() == 6u );
+}
+
+TEST_CASE( "build an XAG without structural hashing", "[network_builder]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> pis;
+  network_builder builder( xag );
+  CHECK( builder.is_bulk() );
+
+  pis.push_back( builder.create_pi() );
+  pis.push_back( builder.create_pi() );
+  pis.push_back( builder.create_pi() );
+
+  const auto f1 = builder.create_xor( pis[0], pis[1] );
+  const auto f2 = builder.create_xor( !pis[1], pis[0] );
+  CHECK( xag.is_complemented( f2 ) );
+  const auto f3 = builder.create_and( pis[0], pis[1] );
+  const auto f4 = builder.create_and( pis[0], pis[1] );
+  const auto f5 = builder.create_xor( f3, pis[2] );
+  const auto f6 = builder.create_xor( pis[2], !f4 );
+  builder.create_po( f5 );
+  builder.create_po( f6 );
+  builder.finalize();
+
+  CHECK( xag.num_gates() == 3u );
+  CHECK( builder.resolve( f2 ) == !f1 );
+  CHECK( builder.resolve( f6 ) == !builder.resolve( f5 ) );
+  CHECK( xag.has_xor( builder.resolve( f3 ), pis[2] ).has_value() );
+
+  const auto tts = simulate<kitty::static_truth_table<3u>>( xag );
+  CHECK( tts[0]._bits == 0x78 );
+  CHECK( tts[1]._bits == 0x87 );
+}
+
+TEST_CASE( "network builder falls back to structural hashing", "[network_builder]" )
+{
+  mig_network mig;
+  network_builder builder( mig );
+  CHECK( !builder.is_bulk() );
+
+  const auto a = builder.create_pi();
+  const auto b = builder.create_pi();
+  CHECK( builder.create_and( a, b ) == builder.create_and( b, a ) );
+  builder.finalize();
+  CHECK( mig.num_gates() == 1u );
+
+  /* networks with gates are extended with structural hashing */
+  aig_network aig;
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+  aig.create_and( c, d );
+  network_builder aig_builder( aig );
+  CHECK( !aig_builder.is_bulk() );
+  CHECK( aig_builder.create_and( d, c ) == aig.create_and( c, d ) );
+}
+
+TEST_CASE( "cleanup dangling merges structurally equivalent gates", "[network_builder]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( a, c );
+  const auto f3 = aig.create_and( f1, c );
+  const auto f4 = aig.create_and( f2, b );
+  aig.create_po( f3 );
+  aig.create_po( f4 );
+
+  /* f2 becomes a duplicate of f1 and f4 a duplicate of f3 */
+  aig.substitute_node_no_restrash( aig.get_node( c ), b );
+
+  const auto cleaned = cleanup_dangling( aig );
+  CHECK( cleaned.num_gates() == 2u );
+  CHECK( cleaned.size() == 6u );
+  CHECK( cleaned.num_pos() == 2u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( cleaned ) == simulate<kitty::static_truth_table<3u>>( aig ) );
+}
+
+TEST_CASE( "cleanup dangling removes gates that become equal in the destination", "[network_builder]" )
+{
+  xag_network xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  xag.create_po( xag.create_and( a, !b ) );
+  xag.create_po( xag.create_and( !a, b ) );
+  xag.create_po( xag.create_xor( a, b ) );
+
+  /* the XOR is decomposed into the two AND gates that already exist */
+  const auto aig = cleanup_dangling<xag_network, aig_network>( xag );
+  CHECK( aig.num_gates() == 3u );
+  CHECK( aig.size() == 6u );
+  CHECK( simulate<kitty::static_truth_table<2u>>( aig ) == simulate<kitty::static_truth_table<2u>>( xag ) );
+}
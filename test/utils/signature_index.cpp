@@ -0,0 +1,123 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <kitty/operators.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/signature_index.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "signature index groups equal and complemented signatures", "[signature_index]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( !b, !f1 );
+  auto const f3 = aig.create_or( f1, c );
+  aig.create_po( f2 );
+  aig.create_po( f3 );
+
+  /* the first two patterns do not distinguish `f1` from `c` */
+  std::vector<kitty::partial_truth_table> patterns( 3u, kitty::partial_truth_table( 2u ) );
+  patterns[0]._bits[0] = 0x2;
+  patterns[1]._bits[0] = 0x2;
+  patterns[2]._bits[0] = 0x2;
+  partial_simulator sim( patterns );
+
+  unordered_node_map<kitty::partial_truth_table, aig_network> tts( aig );
+  simulate_nodes<aig_network>( aig, tts, sim, true );
+  auto const value_of = [&]( auto const& n ) -> kitty::partial_truth_table const& { return tts[n]; };
+
+  signature_index index( aig );
+  index.build( sim.num_bits(), value_of );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( index.contains( n ) );
+  } );
+
+  auto const na = aig.get_node( a ), nc = aig.get_node( c ), n1 = aig.get_node( f1 ), n2 = aig.get_node( f2 );
+  CHECK( tts[n2] == ~tts[n1] );
+  CHECK( index.same_bucket( n1, n2 ) );
+  CHECK( index.same_bucket( n1, nc ) );
+  CHECK( !index.same_bucket( n1, aig.get_node( aig.get_constant( false ) ) ) );
+  CHECK( !index.is_singleton( n1 ) );
+
+  std::vector<std::pair<aig_network::node, bool>> candidates;
+  index.foreach_candidate( n1, [&]( auto const& m, bool complemented ) {
+    candidates.emplace_back( m, complemented );
+  } );
+  CHECK( std::find( candidates.begin(), candidates.end(), std::make_pair( n2, true ) ) != candidates.end() );
+  CHECK( std::find( candidates.begin(), candidates.end(), std::make_pair( nc, false ) ) != candidates.end() );
+
+  /* a pattern with `a = c = 1, b = 0` separates `f1` from `c` */
+  sim.add_pattern( { true, false, true } );
+  simulate_nodes<aig_network>( aig, tts, sim, false );
+  auto const num_buckets = index.num_buckets();
+  index.refine( sim.num_bits(), value_of );
+  CHECK( index.num_buckets() > num_buckets );
+  CHECK( index.same_bucket( n1, n2 ) );
+  CHECK( !index.same_bucket( n1, nc ) );
+  CHECK( index.num_rehashed() < aig.size() );
+
+  /* refining gives the same buckets as rebuilding */
+  signature_index fresh( aig );
+  fresh.build( sim.num_bits(), value_of );
+  aig.foreach_node( [&]( auto const& n ) {
+    aig.foreach_node( [&]( auto const& m ) {
+      if ( fresh.same_bucket( n, m ) )
+      {
+        CHECK( index.same_bucket( n, m ) );
+      }
+    } );
+  } );
+
+  index.erase( n2 );
+  index.erase( aig.get_node( b ) );
+  CHECK( !index.contains( n2 ) );
+  CHECK( index.is_singleton( n1 ) );
+  CHECK( index.same_bucket( na, nc ) );
+}
+
+TEST_CASE( "signature index across word boundaries", "[signature_index]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> pis;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    pis.emplace_back( aig.create_pi() );
+  }
+  auto const f = aig.create_and( aig.create_and( pis[0], pis[1] ), aig.create_and( pis[2], pis[3] ) );
+  auto const g = aig.create_and( aig.create_and( pis[0], pis[2] ), aig.create_and( pis[1], pis[3] ) );
+  auto const h = aig.create_xor( pis[4], pis[5] );
+  aig.create_po( f );
+  aig.create_po( g );
+  aig.create_po( h );
+
+  partial_simulator sim( 8u, 100u, 5u );
+  unordered_node_map<kitty::partial_truth_table, aig_network> tts( aig );
+  simulate_nodes<aig_network>( aig, tts, sim, true );
+  auto const value_of = [&]( auto const& n ) -> kitty::partial_truth_table const& { return tts[n]; };
+
+  signature_index index( aig );
+  index.build( sim.num_bits(), value_of );
+  CHECK( index.same_bucket( aig.get_node( f ), aig.get_node( g ) ) );
+  CHECK( !index.same_bucket( aig.get_node( f ), aig.get_node( h ) ) );
+
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    sim.add_pattern( std::vector<bool>( 8u, i % 2u == 0u ) );
+  }
+  tts.reset();
+  simulate_nodes<aig_network>( aig, tts, sim, true );
+  index.refine( sim.num_bits(), value_of );
+  CHECK( index.num_bits() == 200u );
+  CHECK( index.same_bucket( aig.get_node( f ), aig.get_node( g ) ) );
+  CHECK( !index.is_singleton( aig.get_node( f ) ) );
+}
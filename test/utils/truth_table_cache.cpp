@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 #include <mockturtle/utils/truth_table_cache.hpp>
@@ -45,3 +46,54 @@ TEST_CASE( "working with a truth table cache", "[truth_table_cache]" )
   CHECK( cache[8] == f_maj );
   CHECK( cache[9] == ~f_maj );
 }
+
+TEST_CASE( "working with a truth table arena cache", "[truth_table_cache]" )
+{
+  truth_table_arena_cache<kitty::dynamic_truth_table> cache;
+
+  kitty::dynamic_truth_table zero( 0u ), x1( 1u ), f_and( 2u ), f_maj( 3u ), f_big( 8u );
+
+  kitty::create_from_hex_string( x1, "2" );
+  kitty::create_from_hex_string( f_and, "8" );
+  kitty::create_from_hex_string( f_maj, "e8" );
+  kitty::create_majority( f_big );
+
+  CHECK( cache.insert( zero ) == 0 );
+  CHECK( cache.insert( x1 ) == 2 );
+  CHECK( cache.insert( f_and ) == 4 );
+  CHECK( cache.insert( ~f_maj ) == 7 );
+  CHECK( cache.insert( f_big ) == 8 );
+  CHECK( cache.size() == 5 );
+
+  CHECK( cache.insert( ~zero ) == 1 );
+  CHECK( cache.insert( f_maj ) == 6 );
+  CHECK( cache.insert( ~f_big ) == 9 );
+  CHECK( cache.size() == 5 );
+
+  /* same bits with a different number of variables */
+  kitty::dynamic_truth_table g_and( 3u );
+  kitty::create_from_hex_string( g_and, "08" );
+  CHECK( cache.insert( g_and ) == 10 );
+
+  CHECK( cache.copy( 1 ) == ~zero );
+  CHECK( cache.copy( 5 ) == ~f_and );
+  CHECK( cache.copy( 6 ) == f_maj );
+  CHECK( cache.copy( 9 ) == ~f_big );
+
+  /* views are read in place */
+  CHECK( cache[6].num_vars() == 3u );
+  CHECK( cache[6]._bits[0] == 0xe8 );
+  CHECK( cache[7]._bits[0] == 0x17 );
+  CHECK( kitty::count_ones( cache[9] ) == kitty::count_ones( ~f_big ) );
+  CHECK( kitty::get_bit( cache[3], 0 ) );
+  CHECK( kitty::extend_to( cache[4], 3u ) == kitty::extend_to( f_and, 3u ) );
+
+  /* views can be inserted into other caches */
+  truth_table_arena_cache<kitty::dynamic_truth_table> other;
+  CHECK( other.insert( cache[9] ) == 1 );
+  CHECK( other.copy( 0 ) == f_big );
+
+  kitty::dynamic_truth_table tt;
+  tt = cache[8];
+  CHECK( tt == f_big );
+}
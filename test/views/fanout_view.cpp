@@ -298,4 +298,99 @@ TEST_CASE( "substitute node with no restrash complemented node in fanout view",
   CHECK( faig.fanout_size( faig.get_node( f2 ) ) == 1 );
 
   CHECK( simulate<kitty::static_truth_table<2u>>( faig )[0]._bits == 0x7 );
-}
\ No newline at end of file
+}
+template<typename Ntk>
+void test_forwarded_fanouts()
+{
+  using node = node<Ntk>;
+  using nodes_t = std::vector<node>;
+
+  Ntk ntk;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const f1 = ntk.create_and( a, b );
+  auto const f2 = ntk.create_and( f1, c );
+  auto const f3 = ntk.create_and( f1, !a );
+  ntk.create_po( f2 );
+  ntk.create_po( f3 );
+
+  CHECK( fanout_view<Ntk>::forwards_fanout );
+  CHECK( !ntk.is_tracking_fanouts() );
+
+  fanout_view fanout_ntk{ ntk };
+  CHECK( ntk.is_tracking_fanouts() );
+
+  auto const fanouts = [&]( auto const& f ) {
+    nodes_t nodes;
+    fanout_ntk.foreach_fanout( ntk.get_node( f ), [&]( auto const& p ) { nodes.push_back( p ); } );
+    return nodes;
+  };
+
+  CHECK( fanouts( a ) == nodes_t{ ntk.get_node( f1 ), ntk.get_node( f3 ) } );
+  CHECK( fanouts( f1 ) == nodes_t{ ntk.get_node( f2 ), ntk.get_node( f3 ) } );
+
+  /* lists are updated by the network without events */
+  auto const f4 = ntk.create_and( b, c );
+  CHECK( fanouts( b ) == nodes_t{ ntk.get_node( f1 ), ntk.get_node( f4 ) } );
+  CHECK( fanouts( c ) == nodes_t{ ntk.get_node( f2 ), ntk.get_node( f4 ) } );
+
+  fanout_ntk.substitute_node( ntk.get_node( f1 ), f4 );
+  CHECK( ntk.is_dead( ntk.get_node( f1 ) ) );
+  CHECK( fanouts( f4 ) == nodes_t{ ntk.get_node( f2 ), ntk.get_node( f3 ) } );
+  CHECK( fanouts( a ) == nodes_t{ ntk.get_node( f3 ) } );
+  CHECK( fanouts( b ) == nodes_t{ ntk.get_node( f4 ) } );
+  CHECK( fanouts( c ) == nodes_t{ ntk.get_node( f4 ), ntk.get_node( f2 ) } );
+
+  /* a later view reuses the lists, `update_fanout` recomputes them in index order */
+  fanout_view fanout_ntk2{ ntk };
+  fanout_ntk2.update_fanout();
+  CHECK( fanouts( c ) == nodes_t{ ntk.get_node( f2 ), ntk.get_node( f4 ) } );
+
+  /* the network substitutes only in the fan-outs */
+  auto const g = ntk.create_and( a, c );
+  ntk.substitute_node( ntk.get_node( f4 ), g );
+  CHECK( fanouts( g ) == nodes_t{ ntk.get_node( f2 ), ntk.get_node( f3 ) } );
+  CHECK( fanouts( c ) == nodes_t{ ntk.get_node( g ), ntk.get_node( f2 ) } );
+  CHECK( fanouts( a ) == nodes_t{ ntk.get_node( g ), ntk.get_node( f3 ) } );
+  CHECK( fanouts( b ).empty() );
+
+  /* clones do not keep the lists */
+  CHECK( !ntk.clone().is_tracking_fanouts() );
+}
+
+template<typename Ntk>
+void test_release_forwarded_fanouts()
+{
+  Ntk ntk;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  ntk.create_po( ntk.create_and( a, b ) );
+
+  {
+    fanout_view<Ntk> fanout_ntk{ ntk };
+    {
+      fanout_view<Ntk> copy = fanout_ntk;
+      fanout_view<Ntk> fanout_ntk2{ ntk };
+      fanout_ntk2 = copy;
+      CHECK( ntk.is_tracking_fanouts() );
+    }
+    CHECK( ntk.is_tracking_fanouts() );
+  }
+
+  /* the lists are dropped with the last view */
+  CHECK( !ntk.is_tracking_fanouts() );
+}
+
+TEST_CASE( "forward fanouts to the fan-out lists of the network", "[fanout_view]" )
+{
+  test_forwarded_fanouts<aig_network>();
+  test_forwarded_fanouts<xag_network>();
+  test_forwarded_fanouts<mig_network>();
+  test_forwarded_fanouts<xmg_network>();
+
+  test_release_forwarded_fanouts<aig_network>();
+  test_release_forwarded_fanouts<xag_network>();
+  test_release_forwarded_fanouts<mig_network>();
+  test_release_forwarded_fanouts<xmg_network>();
+}
@@ -0,0 +1,43 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/detail/switching_activity.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/switching_activity_view.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "create switching activity view", "[switching_activity_view]" )
+{
+  CHECK( !has_switching_activity_v<aig_network> );
+  CHECK( has_switching_activity_v<switching_activity_view<aig_network>> );
+  CHECK( has_switching_activities_v<switching_activity_view<aig_network>> );
+
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_or( f1, c );
+  aig.create_po( f2 );
+
+  switching_activity_view sw_aig{ aig };
+  auto const expected = detail::switching_activity( aig );
+  CHECK( sw_aig.switching_activities() == expected );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( sw_aig.switching_activity( n ) == expected[aig.node_to_index( n )] );
+  } );
+  CHECK( detail::switching_activity( sw_aig, 64u ) == expected );
+  CHECK( sw_aig.switching_activity_statistics().num_full_updates == 1u );
+
+  /* changes are tracked through the base network */
+  auto const f3 = aig.create_xor( a, c );
+  aig.substitute_node( aig.get_node( f1 ), f3 );
+  switching_activity_engine fresh( aig );
+  CHECK( sw_aig.switching_activities() == fresh.activities() );
+  CHECK( sw_aig.switching_activity_statistics().num_incremental_updates == 1u );
+
+  auto copy = sw_aig;
+  CHECK( copy.switching_activity( aig.get_node( f2 ) ) == sw_aig.switching_activity( aig.get_node( f2 ) ) );
+  CHECK( copy.switching_power() == sw_aig.switching_power() );
+}
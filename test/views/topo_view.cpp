@@ -5,6 +5,7 @@
 
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/traits.hpp>
+#include <mockturtle/views/depth_view.hpp>
 #include <mockturtle/views/topo_view.hpp>
 
 using namespace mockturtle;
@@ -132,4 +133,60 @@ TEST_CASE( "test reverse topo order", "[topo_view]" )
   gates.clear();
   aig2.foreach_gate_reverse( [&gates]( auto node ) { gates.push_back( node ); } );
   CHECK( gates == std::vector<node<aig_network>>{ { 4, 5 } } );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "topo_view on an AIG with tracked topological order", "[topo_view]" )
+{
+  aig_network aig;
+
+  const auto x1 = aig.create_pi();
+  const auto x2 = aig.create_pi();
+  const auto x3 = aig.create_pi();
+  const auto gate1 = aig.create_and( x1, x2 );
+  const auto gate2 = aig.create_and( x2, x3 );
+  aig.create_and( x1, x3 ); /* dangling */
+  aig.create_po( gate2 );
+  aig.create_po( gate1 );
+  CHECK( aig.is_topo_sorted() );
+
+  /* gates are visited in depth-first order by default */
+  topo_view aig1{ aig };
+  std::vector<node<aig_network>> nodes;
+  aig1.foreach_node( [&nodes]( auto node ) { nodes.push_back( node ); } );
+  CHECK( nodes == std::vector<node<aig_network>>{ { 0, 1, 2, 3, 5, 4 } } );
+
+  /* gates are visited in index order if requested */
+  topo_view_params ps;
+  ps.index_order = true;
+  topo_view aig2{ aig, ps };
+  nodes.clear();
+  aig2.foreach_node( [&nodes]( auto node ) { nodes.push_back( node ); } );
+  CHECK( nodes == std::vector<node<aig_network>>{ { 0, 1, 2, 3, 4, 5 } } );
+  CHECK( aig2.num_gates() == 2u );
+
+  /* also through other views */
+  depth_view depth_aig{ aig };
+  topo_view aig2d{ depth_aig, ps };
+  nodes.clear();
+  aig2d.foreach_node( [&nodes]( auto node ) { nodes.push_back( node ); } );
+  CHECK( nodes == std::vector<node<aig_network>>{ { 0, 1, 2, 3, 4, 5 } } );
+
+  /* substitution breaks the index order */
+  const auto gate4 = aig.create_and( gate2, !x1 );
+  aig.substitute_node( aig.get_node( gate1 ), gate4 );
+  const auto gate5 = aig.create_and( x1, x2 );
+  aig.substitute_node( aig.get_node( gate2 ), gate5 );
+  CHECK( !aig.is_topo_sorted() );
+
+  topo_view aig3{ aig, ps };
+  nodes.clear();
+  aig3.foreach_node( [&nodes]( auto node ) { nodes.push_back( node ); } );
+  CHECK( nodes == std::vector<node<aig_network>>{ { 0, 1, 2, 3, 8, 7 } } );
+
+  aig.restore_topo_order();
+  CHECK( aig.is_topo_sorted() );
+  topo_view aig4{ aig, ps };
+  nodes.clear();
+  aig4.foreach_node( [&nodes]( auto node ) { nodes.push_back( node ); } );
+  CHECK( nodes == std::vector<node<aig_network>>{ { 0, 1, 2, 3, 7, 8 } } );
+}